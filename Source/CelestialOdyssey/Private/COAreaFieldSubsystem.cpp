@@ -0,0 +1,215 @@
+#include "COAreaFieldSubsystem.h"
+#include "COTargetGridSubsystem.h"
+#include "COStatusEffectSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "Algo/Sort.h"
+#include "COStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Area Fields Tick"), STAT_CO_AreaFieldsTick, STATGROUP_CelestialOdyssey);
+
+void UCOAreaFieldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // Zone lifetimes run on the expiry wheel
+    Collection.InitializeDependency<UCOExpirySubsystem>();
+}
+
+/**
+ * @brief Drops every zone when the world is torn down.
+ */
+void UCOAreaFieldSubsystem::Deinitialize()
+{
+    Fields.Reset();
+
+    Super::Deinitialize();
+}
+
+TStatId UCOAreaFieldSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCOAreaFieldSubsystem, STATGROUP_Tickables);
+}
+
+bool UCOAreaFieldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+int32 UCOAreaFieldSubsystem::AddField(const FVector& Center, float Radius, float Duration, const FGameplayEffectSpecHandle& EffectSpec, const AActor* IgnoredActor)
+{
+    FCOAreaField& Field = Fields.AddDefaulted_GetRef();
+    Field.Id = NextFieldId++;
+    Field.Center = Center;
+    Field.Radius = Radius;
+    Field.EffectSpec = EffectSpec;
+    Field.IgnoredActor = IgnoredActor;
+
+    // Read a periodic health drain once; every member then shares its damage. Anything else, including non-periodic
+    // duration effects, stays a gameplay effect
+    if (EffectSpec.IsValid() && GetWorld()->GetSubsystem<UCOStatusEffectSubsystem>())
+    {
+        Field.bUsesStatus = UCOStatusEffectSubsystem::ReadDamageOverTime(*EffectSpec.Data.Get(), Field.StatusDamage);
+    }
+
+    if (Duration > 0.0f)
+    {
+        if (UCOExpirySubsystem* Expiries = GetWorld()->GetSubsystem<UCOExpirySubsystem>())
+        {
+            Field.ExpiryHandle = Expiries->ScheduleCallback(Duration, FSimpleDelegate::CreateUObject(this, &UCOAreaFieldSubsystem::ExpireField, Field.Id));
+        }
+    }
+
+    return Field.Id;
+}
+
+void UCOAreaFieldSubsystem::RemoveField(int32 FieldId)
+{
+    const int32 FieldIndex = Fields.IndexOfByPredicate([FieldId](const FCOAreaField& Field) { return Field.Id == FieldId; });
+    if (FieldIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    if (UCOExpirySubsystem* Expiries = GetWorld()->GetSubsystem<UCOExpirySubsystem>())
+    {
+        Expiries->Cancel(Fields[FieldIndex].ExpiryHandle);
+    }
+    RemoveFieldAt(FieldIndex);
+}
+
+void UCOAreaFieldSubsystem::ExpireField(int32 FieldId)
+{
+    const int32 FieldIndex = Fields.IndexOfByPredicate([FieldId](const FCOAreaField& Field) { return Field.Id == FieldId; });
+    if (FieldIndex != INDEX_NONE)
+    {
+        RemoveFieldAt(FieldIndex);
+    }
+}
+
+/**
+ * @brief Updates every zone in one pass.
+ */
+void UCOAreaFieldSubsystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_CO_AreaFieldsTick);
+
+    const double Now = GetWorld()->GetTimeSeconds();
+
+    for (FCOAreaField& Field : Fields)
+    {
+        UpdateField(Field, Now);
+    }
+}
+
+/**
+ * @brief Recomputes a zone's membership and applies or removes its effect on the targets that changed.
+ *
+ * Candidates and members are both sorted by pointer, so entering, staying and leaving targets
+ * fall out of a single merge walk.
+ */
+void UCOAreaFieldSubsystem::UpdateField(FCOAreaField& Field, double Now)
+{
+    UCOTargetGridSubsystem* TargetGrid = GetWorld()->GetSubsystem<UCOTargetGridSubsystem>();
+    if (!TargetGrid || !Field.EffectSpec.IsValid())
+    {
+        return;
+    }
+
+    // Members that were destroyed since the last update simply drop out
+    Field.Members.RemoveAll([](const FCOAreaFieldMember& Member) { return !Member.WeakTarget.IsValid(); });
+
+    TargetGrid->QueryCircle(Field.Center, Field.Radius, CandidateScratch, Field.IgnoredActor.Get());
+    Algo::Sort(CandidateScratch);
+
+    MemberScratch.Reset();
+
+    int32 CandidateIndex = 0;
+    int32 MemberIndex = 0;
+    while (CandidateIndex < CandidateScratch.Num() || MemberIndex < Field.Members.Num())
+    {
+        const bool bHasCandidate = CandidateIndex < CandidateScratch.Num();
+        const bool bHasMember = MemberIndex < Field.Members.Num();
+
+        if (bHasCandidate && (!bHasMember || CandidateScratch[CandidateIndex] < Field.Members[MemberIndex].Target))
+        {
+            // Entered the field
+            FCOAreaFieldMember& Member = MemberScratch.AddDefaulted_GetRef();
+            Member.Target = CandidateScratch[CandidateIndex];
+            Member.WeakTarget = Member.Target;
+            ApplyToMember(Field, Member, Now);
+            ++CandidateIndex;
+        }
+        else if (!bHasCandidate || Field.Members[MemberIndex].Target < CandidateScratch[CandidateIndex])
+        {
+            // Left the field
+            RemoveFromMember(Field, Field.Members[MemberIndex]);
+            ++MemberIndex;
+        }
+        else
+        {
+            // Still inside, only refresh duration-based effects that ran out
+            FCOAreaFieldMember& Member = MemberScratch.Add_GetRef(Field.Members[MemberIndex]);
+            if (Member.ReapplyTime > 0.0 && Now >= Member.ReapplyTime)
+            {
+                ApplyToMember(Field, Member, Now);
+            }
+            ++CandidateIndex;
+            ++MemberIndex;
+        }
+    }
+
+    Swap(Field.Members, MemberScratch);
+}
+
+void UCOAreaFieldSubsystem::ApplyToMember(const FCOAreaField& Field, FCOAreaFieldMember& Member, double Now) const
+{
+    if (Field.bUsesStatus)
+    {
+        // The status lasts until the member leaves, so it never needs re-applying
+        if (UCOStatusEffectSubsystem* StatusEffects = GetWorld()->GetSubsystem<UCOStatusEffectSubsystem>())
+        {
+            Member.StatusId = StatusEffects->AddDamageOverTime(Member.Target, Field.StatusDamage, 0.0f, FCODamageSource::FromSpec(*Field.EffectSpec.Data.Get()));
+            Member.ReapplyTime = 0.0;
+            return;
+        }
+    }
+
+    const FGameplayEffectSpec& Spec = *Field.EffectSpec.Data.Get();
+    Member.EffectHandle = Member.Target->ApplyGameplayEffectSpecToSelf(Spec);
+
+    const float Duration = Spec.GetDuration();
+    Member.ReapplyTime = Duration > 0.0f ? Now + Duration : 0.0;
+}
+
+void UCOAreaFieldSubsystem::RemoveFromMember(const FCOAreaField& Field, FCOAreaFieldMember& Member) const
+{
+    if (Member.StatusId != INDEX_NONE)
+    {
+        if (UCOStatusEffectSubsystem* StatusEffects = GetWorld()->GetSubsystem<UCOStatusEffectSubsystem>())
+        {
+            StatusEffects->RemoveStatus(ECOStatusType::DamageOverTime, Member.StatusId);
+        }
+        Member.StatusId = INDEX_NONE;
+    }
+
+    if (UAbilitySystemComponent* Target = Member.WeakTarget.Get())
+    {
+        if (Member.EffectHandle.IsValid())
+        {
+            Target->RemoveActiveGameplayEffect(Member.EffectHandle);
+        }
+    }
+
+    Member.EffectHandle.Invalidate();
+}
+
+void UCOAreaFieldSubsystem::RemoveFieldAt(int32 FieldIndex)
+{
+    FCOAreaField& Field = Fields[FieldIndex];
+    for (FCOAreaFieldMember& Member : Field.Members)
+    {
+        RemoveFromMember(Field, Member);
+    }
+
+    Fields.RemoveAtSwap(FieldIndex);
+}
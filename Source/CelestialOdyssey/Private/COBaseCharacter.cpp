@@ -1,34 +1,42 @@
 #include "COBaseCharacter.h"
-#include "GameFramework/CharacterMovementComponent.h"
+#include "COCharacterMovementComponent.h"
+#include "COTargetGridComponent.h"
 
 /*
  * Constructor
- * Sets default properties like movement constraints.
+ * Swaps in the project movement component and sets default properties like movement constraints.
  */
-ACOBaseCharacter::ACOBaseCharacter()
+ACOBaseCharacter::ACOBaseCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UCOCharacterMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
+	//Characters react to movement events instead of polling; subclasses that really need a tick opt back in
+	PrimaryActorTick.bCanEverTick = false;
+
 	//Constrain movement to a 2D plane (XZ axis)
 	GetCharacterMovement()->bConstrainToPlane = true;
 	GetCharacterMovement()->SetPlaneConstraintNormal(FVector(0.0f, 1.0f, 0.0f)); //Lock to XZ plane
 
 	//Default MoveSpeed that derived classes can override
 	MoveSpeed = 400.0f;
+
+	//Characters that own an Ability System Component can be hit by area abilities
+	TargetGridComponent = CreateDefaultSubobject<UCOTargetGridComponent>(TEXT("TargetGridComponent"));
 }
 
 /*
- * Called when the game starts or when spawned.
+ * Returns the movement component cast to UCOCharacterMovementComponent.
  */
-void ACOBaseCharacter::BeginPlay()
+UCOCharacterMovementComponent* ACOBaseCharacter::GetCOCharacterMovement() const
 {
-	Super::BeginPlay();
+	return Cast<UCOCharacterMovementComponent>(GetCharacterMovement());
 }
 
 /*
- * Called every frame to update the character.
+ * Called when the game starts or when spawned.
  */
-void ACOBaseCharacter::Tick(float DeltaTime)
+void ACOBaseCharacter::BeginPlay()
 {
-	Super::Tick(DeltaTime);
+	Super::BeginPlay();
 }
 
 /*
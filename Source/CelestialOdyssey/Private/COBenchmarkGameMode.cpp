@@ -0,0 +1,814 @@
+#include "COBenchmarkGameMode.h"
+#include "COBaseCharacter.h"
+#include "COCharacterMovementComponent.h"
+#include "COCollisionChannels.h"
+#include "COCrystalStructureSubsystem.h"
+#include "CODamageAccumulatorSubsystem.h"
+#include "COEnemyAttributeSet.h"
+#include "COEnemyCharacter.h"
+#include "COFragmentSubsystem.h"
+#include "COLog.h"
+#include "COMinionAbilitySystemComponent.h"
+#include "COMinionAttributeSubsystem.h"
+#include "COMinionCharacter.h"
+#include "COPlayerCharacter.h"
+#include "COPlayerController.h"
+#include "COPlayerState.h"
+#include "COStatusEffectSubsystem.h"
+#include "COVineSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "GameplayEffect.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "CelestialDashAbility.h"
+#include "CosmicStrikeAbility.h"
+#include "CrystalGrowthAbility.h"
+#include "CrystalShatterAbility.h"
+#include "GravityShiftAbility.h"
+#include "GroundSlamAbility.h"
+#include "LunarForestFuryAbility.h"
+#include "VineWhipAbility.h"
+
+/**
+ *  Constructor
+ *  Defaults to the native player classes, the native enemy and every ability in the module.
+ */
+ACOBenchmarkGameMode::ACOBenchmarkGameMode()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	DefaultPawnClass = ACOPlayerCharacter::StaticClass();
+	PlayerControllerClass = ACOPlayerController::StaticClass();
+	EnemyClass = ACOEnemyCharacter::StaticClass();
+
+	BenchmarkAbilities = {
+		UCrystalShatterAbility::StaticClass(),
+		UGroundSlamAbility::StaticClass(),
+		ULunarForestFuryAbility::StaticClass(),
+		UCelestialDashAbility::StaticClass(),
+		UGravityShiftAbility::StaticClass(),
+		UCosmicStrikeAbility::StaticClass(),
+		UVineWhipAbility::StaticClass(),
+		UCrystalGrowthAbility::StaticClass()
+	};
+}
+
+/**
+ *  Reads command-line overrides and generates the stress arena: static floor platforms spanning ArenaWidth, split by
+ *  NumArenaGaps gaps.
+ */
+void ACOBenchmarkGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+	Super::InitGame(MapName, Options, ErrorMessage);
+
+	FParse::Value(FCommandLine::Get(), TEXT("COBenchmarkEnemies="), NumEnemies);
+	if (FParse::Param(FCommandLine::Get(), TEXT("COBenchmarkMinions")))
+	{
+		EnemyClass = ACOMinionCharacter::StaticClass();
+	}
+	FParse::Value(FCommandLine::Get(), TEXT("COBenchmarkFragments="), NumStressFragments);
+	FParse::Value(FCommandLine::Get(), TEXT("COBenchmarkStructures="), NumStressStructures);
+	FParse::Value(FCommandLine::Get(), TEXT("COBenchmarkVines="), NumStressVines);
+	if (FParse::Param(FCommandLine::Get(), TEXT("COBenchmarkStatuses")))
+	{
+		bStressStatuses = true;
+	}
+	if (FParse::Param(FCommandLine::Get(), TEXT("COBenchmarkWalkers")))
+	{
+		bStressWalkers = true;
+	}
+	FParse::Bool(FCommandLine::Get(), TEXT("COBenchmarkPlanarFloors="), bUsePlanarFloors);
+	FParse::Value(FCommandLine::Get(), TEXT("COBenchmarkGaps="), NumArenaGaps);
+	FParse::Value(FCommandLine::Get(), TEXT("COBenchmarkThresholds="), ThresholdsFile);
+	FParse::Value(FCommandLine::Get(), TEXT("COBenchmarkOutput="), OutputName);
+
+	UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!CubeMesh)
+	{
+		ErrorMessage = TEXT("Benchmark arena mesh /Engine/BasicShapes/Cube is missing");
+		return;
+	}
+
+	NumArenaGaps = FMath::Max(NumArenaGaps, 0);
+	const int32 NumPlatforms = NumArenaGaps + 1;
+	const float PlatformWidth = (ArenaWidth - NumArenaGaps * ArenaGapWidth) / NumPlatforms;
+
+	for (int32 Platform = 0; Platform < NumPlatforms; ++Platform)
+	{
+		const float CenterX = -0.5f * ArenaWidth + Platform * (PlatformWidth + ArenaGapWidth) + 0.5f * PlatformWidth;
+
+		// The engine cube is 100 cm on each side; the top face ends up at Z = 0
+		const FTransform FloorTransform(FRotator::ZeroRotator, FVector(CenterX, 0.0f, -50.0f), FVector(PlatformWidth / 100.0f, 20.0f, 1.0f));
+		AStaticMeshActor* Floor = GetWorld()->SpawnActorDeferred<AStaticMeshActor>(AStaticMeshActor::StaticClass(), FloorTransform);
+		Floor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Static);
+		Floor->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+		Floor->GetStaticMeshComponent()->SetCollisionProfileName(COCollisionProfiles::CrystalSurface);
+		Floor->FinishSpawning(FloorTransform);
+	}
+}
+
+/**
+ *  Spawns players in the middle of the arena.
+ */
+void ACOBenchmarkGameMode::RestartPlayer(AController* NewPlayer)
+{
+	RestartPlayerAtTransform(NewPlayer, FTransform(FVector(0.0f, 0.0f, 200.0f)));
+}
+
+/**
+ *  Spawns the enemies evenly across the arena and grants the benchmark abilities to the first player.
+ */
+void ACOBenchmarkGameMode::StartPlay()
+{
+	Super::StartPlay();
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	TArray<AActor*> Enemies;
+	const float Spacing = ArenaWidth / (NumEnemies + 1);
+	for (int32 Index = 0; Index < NumEnemies; ++Index)
+	{
+		const FVector Location(-0.5f * ArenaWidth + Spacing * (Index + 1), 0.0f, 100.0f);
+		if (ACOBaseCharacter* Enemy = GetWorld()->SpawnActor<ACOBaseCharacter>(EnemyClass, Location, FRotator::ZeroRotator, SpawnParams))
+		{
+			Enemies.Add(Enemy);
+
+			UCOCharacterMovementComponent* Movement = Enemy->GetCOCharacterMovement();
+			if (Movement)
+			{
+				Movement->SetUsePlanarFloorCache(bUsePlanarFloors);
+			}
+
+			if (bStressWalkers && Movement)
+			{
+				// Spawned enemies have no controller; without this their movement never simulates
+				Movement->bRunPhysicsWithNoController = true;
+				Walkers.Add(Enemy);
+				WalkerDirections.Add(Index % 2 == 0 ? 1.0f : -1.0f);
+			}
+		}
+	}
+
+	if (ACOBaseCharacter* PlayerCharacter = Cast<ACOBaseCharacter>(GetWorld()->GetFirstPlayerController() ? GetWorld()->GetFirstPlayerController()->GetPawn() : nullptr))
+	{
+		if (UCOCharacterMovementComponent* Movement = PlayerCharacter->GetCOCharacterMovement())
+		{
+			Movement->SetUsePlanarFloorCache(bUsePlanarFloors);
+		}
+	}
+
+	UCOCharacterMovementComponent::SetRecordTickCost(true);
+
+	MeasureEnemyCost(Enemies);
+
+	APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	ACOPlayerState* COPlayerState = PlayerController ? PlayerController->GetPlayerState<ACOPlayerState>() : nullptr;
+	PlayerAbilitySystem = COPlayerState ? COPlayerState->GetAbilitySystemComponent() : nullptr;
+	if (!PlayerAbilitySystem)
+	{
+		UE_LOG(LogCelestialOdyssey, Error, TEXT("Benchmark has no player Ability System Component; abilities will not fire"));
+		return;
+	}
+
+	for (const TSubclassOf<UGameplayAbility>& AbilityClass : BenchmarkAbilities)
+	{
+		FAbilityResult& Result = AbilityResults.AddDefaulted_GetRef();
+		if (AbilityClass)
+		{
+			Result.Handle = PlayerAbilitySystem->GiveAbility(FGameplayAbilitySpec(AbilityClass, 1, INDEX_NONE, this));
+		}
+	}
+
+	PlayerAbilitySystem->OnGameplayEffectAppliedDelegateToTarget.AddUObject(this, &ACOBenchmarkGameMode::OnEffectApplied);
+
+	NextAbilityTime = WarmupSeconds;
+}
+
+void ACOBenchmarkGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UCOCharacterMovementComponent::SetRecordTickCost(false);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+/**
+ *  Samples frame time during the measurement window and drives the ability schedule.
+ */
+void ACOBenchmarkGameMode::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (bFinished)
+	{
+		return;
+	}
+
+	RefillStressFragments();
+	RefillStressStructures();
+	RefillStressVines();
+	RefillStressStatuses();
+	DriveWalkers();
+
+	// Movement ticked since the last frame; consumed during warmup too, so only measured frames are counted
+	int32 NumMovementTicks = 0;
+	const double MovementSeconds = UCOCharacterMovementComponent::ConsumeRecordedTickSeconds(NumMovementTicks);
+
+	ElapsedSeconds += DeltaSeconds;
+	if (ElapsedSeconds < WarmupSeconds)
+	{
+		return;
+	}
+
+	FrameTimesMs.Add(DeltaSeconds * 1000.0);
+
+	if (NumMovementTicks > 0)
+	{
+		MovementTickUs.Add(MovementSeconds * 1000000.0 / NumMovementTicks);
+	}
+
+	if (const UCOFragmentSubsystem* Fragments = GetWorld()->GetSubsystem<UCOFragmentSubsystem>())
+	{
+		FragmentTickMs.Add(Fragments->GetLastTickSeconds() * 1000.0);
+	}
+
+	if (const UCOCrystalStructureSubsystem* CrystalStructures = GetWorld()->GetSubsystem<UCOCrystalStructureSubsystem>())
+	{
+		StructureTickMs.Add(CrystalStructures->GetLastTickSeconds() * 1000.0);
+	}
+
+	if (const UCOVineSubsystem* Vines = GetWorld()->GetSubsystem<UCOVineSubsystem>())
+	{
+		VineTickMs.Add(Vines->GetLastTickSeconds() * 1000.0);
+	}
+
+	if (const UCOStatusEffectSubsystem* StatusEffects = GetWorld()->GetSubsystem<UCOStatusEffectSubsystem>())
+	{
+		StatusTickMs.Add(StatusEffects->GetLastTickSeconds() * 1000.0);
+	}
+
+	if (PlayerAbilitySystem && AbilityResults.Num() > 0 && ElapsedSeconds >= NextAbilityTime)
+	{
+		FireNextAbility();
+		NextAbilityTime += AbilityInterval;
+	}
+
+	if (ElapsedSeconds >= WarmupSeconds + DurationSeconds)
+	{
+		FinishBenchmark();
+	}
+}
+
+/**
+ *  Activates the next ability in the schedule and records how long the activation took on the game thread.
+ *  Abilities still running from the previous slot are cancelled first so every activation starts from the same state.
+ */
+void ACOBenchmarkGameMode::FireNextAbility()
+{
+	FAbilityResult& Result = AbilityResults[NextAbilityIndex];
+	NextAbilityIndex = (NextAbilityIndex + 1) % AbilityResults.Num();
+
+	if (!Result.Handle.IsValid())
+	{
+		return;
+	}
+
+	PlayerAbilitySystem->CancelAllAbilities();
+
+	const double StartTime = FPlatformTime::Seconds();
+	const bool bActivated = PlayerAbilitySystem->TryActivateAbility(Result.Handle);
+	const double CostMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	if (bActivated)
+	{
+		++Result.Activations;
+		Result.TotalCostMs += CostMs;
+		Result.MaxCostMs = FMath::Max(Result.MaxCostMs, CostMs);
+	}
+	else
+	{
+		++Result.Failures;
+	}
+}
+
+/**
+ *  Launches undamaging fragments from above the arena center until NumStressFragments are alive.
+ *  They ricochet off the arena floor and through the enemies, so both the world traces and the target grid are exercised.
+ */
+void ACOBenchmarkGameMode::RefillStressFragments()
+{
+	UCOFragmentSubsystem* Fragments = GetWorld()->GetSubsystem<UCOFragmentSubsystem>();
+	if (!Fragments || NumStressFragments <= 0)
+	{
+		return;
+	}
+
+	const int32 Missing = NumStressFragments - Fragments->GetNumFragments();
+	if (Missing > 0)
+	{
+		Fragments->LaunchRadial(FVector(0.0f, 0.0f, 300.0f), Missing, 800.0f, 8, 4.0f, FGameplayEffectSpecHandle());
+	}
+}
+
+/**
+ *  Spawns crystal structures spread across the arena, cycling through every structure type at the highest level.
+ *  Structures expire after StressStructureLifetime, so this keeps growth and parking running for the whole run.
+ */
+void ACOBenchmarkGameMode::RefillStressStructures()
+{
+	UCOCrystalStructureSubsystem* CrystalStructures = GetWorld()->GetSubsystem<UCOCrystalStructureSubsystem>();
+	if (!CrystalStructures || NumStressStructures <= 0)
+	{
+		return;
+	}
+
+	const int32 NumTypes = static_cast<int32>(ECrystalStructureType::Encasement) + 1;
+	const float Spacing = ArenaWidth / (NumStressStructures + 1);
+
+	while (CrystalStructures->GetNumStructures() < NumStressStructures)
+	{
+		const int32 Slot = NextStressStructure % NumStressStructures;
+		const ECrystalStructureType Type = static_cast<ECrystalStructureType>(NextStressStructure % NumTypes);
+		const FVector Location(-0.5f * ArenaWidth + Spacing * (Slot + 1), 0.0f, 0.0f);
+		++NextStressStructure;
+
+		const double StartTime = FPlatformTime::Seconds();
+		if (CrystalStructures->SpawnStructure(Type, 3, Location, FRotator::ZeroRotator, StressStructureLifetime) == INDEX_NONE)
+		{
+			return;
+		}
+
+		if (ElapsedSeconds >= WarmupSeconds)
+		{
+			StructureSpawnTotalMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+			++StructureSpawns;
+		}
+	}
+}
+
+/**
+ *  Hangs vines from points spread above the arena. Each starts stretched out sideways, so it swings for a good part
+ *  of the run instead of resting straight down, and its tail brushes the floor on the way through.
+ */
+void ACOBenchmarkGameMode::RefillStressVines()
+{
+	UCOVineSubsystem* Vines = GetWorld()->GetSubsystem<UCOVineSubsystem>();
+	if (!Vines || NumStressVines <= 0)
+	{
+		return;
+	}
+
+	const float Spacing = ArenaWidth / (NumStressVines + 1);
+	const float VineLength = FMath::Min(StressVineSegments, UCOVineSubsystem::MaxSegmentsPerVine) * 40.0f;
+
+	for (int32 Slot = Vines->GetNumVines(); Slot < NumStressVines; ++Slot)
+	{
+		const FVector Anchor(-0.5f * ArenaWidth + Spacing * (Slot + 1), 0.0f, VineLength + 200.0f);
+		if (Vines->AddVine(ECOVineMode::Hang, Anchor, Anchor + FVector(VineLength, 0.0f, 0.0f), StressVineSegments, 1.0f) == INDEX_NONE)
+		{
+			return;
+		}
+	}
+}
+
+/**
+ *  Gives every enemy one status of each type once the previous round has run out. The damage over time is one point
+ *  per second, so enemies survive the run while their Health is still written once a second.
+ */
+void ACOBenchmarkGameMode::RefillStressStatuses()
+{
+	UCOStatusEffectSubsystem* StatusEffects = GetWorld()->GetSubsystem<UCOStatusEffectSubsystem>();
+	if (!StatusEffects || !bStressStatuses || StatusEffects->GetNumStatuses(ECOStatusType::DamageOverTime) > 0)
+	{
+		return;
+	}
+
+	if (!StressBurnEffect)
+	{
+		CreateStressEffects();
+	}
+
+	const FGameplayEffectContextHandle Context(UAbilitySystemGlobals::Get().AllocGameplayEffectContext());
+	const FGameplayEffectSpec SlowSpec(StressSlowEffect, Context, 1.0f);
+	const FGameplayEffectSpec HoldSpec(StressHoldEffect, Context, 1.0f);
+	const FGameplayEffectSpec BurnSpec(StressBurnEffect, Context, 1.0f);
+
+	StatusEffects->ApplyStatus(ECOStatusType::Slow, SlowSpec, EnemyAbilitySystems, StressStatusDuration);
+	StatusEffects->ApplyStatus(ECOStatusType::Root, HoldSpec, EnemyAbilitySystems, StressStatusDuration);
+	StatusEffects->ApplyStatus(ECOStatusType::Stun, HoldSpec, EnemyAbilitySystems, StressStatusDuration);
+	StatusEffects->ApplyStatus(ECOStatusType::DamageOverTime, BurnSpec, EnemyAbilitySystems, StressStatusDuration);
+}
+
+/**
+ *  The slow halves MovementSpeed, the hold only carries the status and the burn is a periodic one-point Health drain,
+ *  which the status subsystem simulates natively.
+ */
+void ACOBenchmarkGameMode::CreateStressEffects()
+{
+	const FGameplayEffectModifierMagnitude Duration(FScalableFloat(StressStatusDuration));
+
+	StressSlowEffect = NewObject<UGameplayEffect>(this, TEXT("BenchmarkSlow"));
+	StressSlowEffect->DurationPolicy = EGameplayEffectDurationType::HasDuration;
+	StressSlowEffect->DurationMagnitude = Duration;
+	FGameplayModifierInfo& SlowModifier = StressSlowEffect->Modifiers.AddDefaulted_GetRef();
+	SlowModifier.Attribute = UCOEnemyAttributeSet::GetMovementSpeedAttribute();
+	SlowModifier.ModifierOp = EGameplayModOp::Multiplicitive;
+	SlowModifier.ModifierMagnitude = FScalableFloat(0.5f);
+
+	StressHoldEffect = NewObject<UGameplayEffect>(this, TEXT("BenchmarkHold"));
+	StressHoldEffect->DurationPolicy = EGameplayEffectDurationType::HasDuration;
+	StressHoldEffect->DurationMagnitude = Duration;
+
+	StressBurnEffect = NewObject<UGameplayEffect>(this, TEXT("BenchmarkBurn"));
+	StressBurnEffect->DurationPolicy = EGameplayEffectDurationType::HasDuration;
+	StressBurnEffect->DurationMagnitude = Duration;
+	StressBurnEffect->Period = FScalableFloat(1.0f);
+	FGameplayModifierInfo& BurnModifier = StressBurnEffect->Modifiers.AddDefaulted_GetRef();
+	BurnModifier.Attribute = UCOEnemyAttributeSet::GetHealthAttribute();
+	BurnModifier.ModifierOp = EGameplayModOp::Additive;
+	BurnModifier.ModifierMagnitude = FScalableFloat(-1.0f);
+}
+
+/**
+ *  Walks every walker along X, turning it around once it nears either end of the arena.
+ */
+void ACOBenchmarkGameMode::DriveWalkers()
+{
+	const float TurnX = 0.45f * ArenaWidth;
+
+	for (int32 Index = 0; Index < Walkers.Num(); ++Index)
+	{
+		ACOBaseCharacter* Walker = Walkers[Index];
+		if (!Walker)
+		{
+			continue;
+		}
+
+		float& Direction = WalkerDirections[Index];
+		const float X = Walker->GetActorLocation().X;
+		if ((Direction > 0.0f && X > TurnX) || (Direction < 0.0f && X < -TurnX))
+		{
+			Direction = -Direction;
+		}
+
+		Walker->AddMovementInput(FVector(Direction, 0.0f, 0.0f));
+	}
+}
+
+/**
+ *  Sums the memory of each enemy's Ability System Component and attribute sets (plus its share of the minion
+ *  attribute store), then applies DamagePasses rounds of a one-point instant damage effect to every enemy and
+ *  records the rate. The damage effect is built in code so the measurement needs no content.
+ *  Every enemy's Health is restored afterwards, so the run starts on live enemies and kills are still recorded.
+ */
+void ACOBenchmarkGameMode::MeasureEnemyCost(const TArray<AActor*>& Enemies)
+{
+	EnemyAbilitySystems.Reset();
+	SIZE_T TotalBytes = 0;
+
+	for (AActor* Enemy : Enemies)
+	{
+		UAbilitySystemComponent* ASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Enemy);
+		if (!ASC)
+		{
+			continue;
+		}
+
+		EnemyAbilitySystems.Add(ASC);
+		TotalBytes += FArchiveCountMem(ASC).GetMax();
+		for (UAttributeSet* AttributeSet : ASC->GetSpawnedAttributes())
+		{
+			TotalBytes += FArchiveCountMem(AttributeSet).GetMax();
+		}
+	}
+
+	if (const UCOMinionAttributeSubsystem* MinionAttributes = GetWorld()->GetSubsystem<UCOMinionAttributeSubsystem>())
+	{
+		TotalBytes += MinionAttributes->GetAllocatedSize();
+	}
+
+	if (EnemyAbilitySystems.Num() == 0)
+	{
+		return;
+	}
+
+	EnemyGASBytes = static_cast<double>(TotalBytes) / EnemyAbilitySystems.Num();
+
+	UGameplayEffect* DamageEffect = NewObject<UGameplayEffect>(this, TEXT("BenchmarkDamage"));
+	FGameplayModifierInfo& DamageModifier = DamageEffect->Modifiers.AddDefaulted_GetRef();
+	DamageModifier.Attribute = UCOEnemyAttributeSet::GetHealthAttribute();
+	DamageModifier.ModifierOp = EGameplayModOp::Additive;
+	DamageModifier.ModifierMagnitude = FScalableFloat(-1.0f);
+
+	const FGameplayEffectSpec DamageSpec(DamageEffect, FGameplayEffectContextHandle(UAbilitySystemGlobals::Get().AllocGameplayEffectContext()), 1.0f);
+
+	const FGameplayAttribute HealthAttribute = UCOEnemyAttributeSet::GetHealthAttribute();
+
+	TArray<float> StartHealth;
+	StartHealth.Reserve(EnemyAbilitySystems.Num());
+	for (const UAbilitySystemComponent* ASC : EnemyAbilitySystems)
+	{
+		const UCOMinionAbilitySystemComponent* Minion = Cast<UCOMinionAbilitySystemComponent>(ASC);
+		StartHealth.Add(Minion ? Minion->GetAttributeBaseValue(HealthAttribute) : ASC->GetNumericAttributeBase(HealthAttribute));
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Pass = 0; Pass < DamagePasses; ++Pass)
+	{
+		for (UAbilitySystemComponent* ASC : EnemyAbilitySystems)
+		{
+			ASC->ApplyGameplayEffectSpecToSelf(DamageSpec);
+		}
+	}
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+	for (int32 Index = 0; Index < EnemyAbilitySystems.Num(); ++Index)
+	{
+		UAbilitySystemComponent* ASC = EnemyAbilitySystems[Index];
+		if (UCOMinionAbilitySystemComponent* Minion = Cast<UCOMinionAbilitySystemComponent>(ASC))
+		{
+			Minion->ApplyAttributeModifier(HealthAttribute, EGameplayModOp::Override, StartHealth[Index]);
+		}
+		else
+		{
+			ASC->SetNumericAttributeBase(HealthAttribute, StartHealth[Index]);
+		}
+	}
+
+	DamageEffectsPerSecond = Elapsed > 0.0 ? (static_cast<double>(DamagePasses) * EnemyAbilitySystems.Num()) / Elapsed : 0.0;
+}
+
+/**
+ *  Attributes every effect the player applies to the benchmark ability that created its spec.
+ */
+void ACOBenchmarkGameMode::OnEffectApplied(UAbilitySystemComponent* Target, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle)
+{
+	const UGameplayAbility* SourceAbility = Spec.GetContext().GetAbility();
+	if (!SourceAbility)
+	{
+		return;
+	}
+
+	const int32 Index = BenchmarkAbilities.IndexOfByKey(SourceAbility->GetClass());
+	if (AbilityResults.IsValidIndex(Index))
+	{
+		++AbilityResults[Index].EffectsApplied;
+	}
+}
+
+/**
+ *  Value at a percentile of a sorted array, using the nearest-rank method.
+ */
+double ACOBenchmarkGameMode::Percentile(const TArray<double>& Sorted, double Fraction)
+{
+	if (Sorted.Num() == 0)
+	{
+		return 0.0;
+	}
+
+	const int32 Rank = FMath::CeilToInt(Fraction * Sorted.Num()) - 1;
+	return Sorted[FMath::Clamp(Rank, 0, Sorted.Num() - 1)];
+}
+
+/**
+ *  Checks the results against the threshold file.
+ *
+ *  The file is JSON with optional "FrameTimeP50Ms", "FrameTimeP99Ms", "FragmentTickP99Ms", "StructureTickP99Ms", "VineTickP99Ms", "StatusTickP99Ms" and an "AbilityAvgCostMs" object keyed by
+ *  ability class name, where "default" applies to abilities without their own entry. A missing file passes.
+ */
+bool ACOBenchmarkGameMode::CheckThresholds(double FrameP50Ms, double FrameP99Ms, double FragmentTickP99Ms, double StructureTickP99Ms, double VineTickP99Ms, double StatusTickP99Ms, TArray<FString>& OutFailures) const
+{
+	const FString Path = FPaths::IsRelative(ThresholdsFile) ? FPaths::Combine(FPaths::ProjectDir(), ThresholdsFile) : ThresholdsFile;
+
+	FString Text;
+	TSharedPtr<FJsonObject> Thresholds;
+	if (!FFileHelper::LoadFileToString(Text, *Path) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Thresholds) || !Thresholds.IsValid())
+	{
+		UE_LOG(LogCelestialOdyssey, Warning, TEXT("Benchmark thresholds %s not found or invalid; skipping checks"), *Path);
+		return true;
+	}
+
+	double Limit = 0.0;
+	if (Thresholds->TryGetNumberField(TEXT("FrameTimeP50Ms"), Limit) && FrameP50Ms > Limit)
+	{
+		OutFailures.Add(FString::Printf(TEXT("Frame time p50 %.2f ms > %.2f ms"), FrameP50Ms, Limit));
+	}
+	if (Thresholds->TryGetNumberField(TEXT("FrameTimeP99Ms"), Limit) && FrameP99Ms > Limit)
+	{
+		OutFailures.Add(FString::Printf(TEXT("Frame time p99 %.2f ms > %.2f ms"), FrameP99Ms, Limit));
+	}
+	if (Thresholds->TryGetNumberField(TEXT("FragmentTickP99Ms"), Limit) && FragmentTickP99Ms > Limit)
+	{
+		OutFailures.Add(FString::Printf(TEXT("Fragment tick p99 %.3f ms > %.3f ms"), FragmentTickP99Ms, Limit));
+	}
+	if (Thresholds->TryGetNumberField(TEXT("StructureTickP99Ms"), Limit) && StructureTickP99Ms > Limit)
+	{
+		OutFailures.Add(FString::Printf(TEXT("Crystal structure tick p99 %.3f ms > %.3f ms"), StructureTickP99Ms, Limit));
+	}
+	if (Thresholds->TryGetNumberField(TEXT("VineTickP99Ms"), Limit) && VineTickP99Ms > Limit)
+	{
+		OutFailures.Add(FString::Printf(TEXT("Vine tick p99 %.3f ms > %.3f ms"), VineTickP99Ms, Limit));
+	}
+	if (Thresholds->TryGetNumberField(TEXT("StatusTickP99Ms"), Limit) && StatusTickP99Ms > Limit)
+	{
+		OutFailures.Add(FString::Printf(TEXT("Status effect tick p99 %.3f ms > %.3f ms"), StatusTickP99Ms, Limit));
+	}
+
+	const TSharedPtr<FJsonObject>* AbilityLimits = nullptr;
+	if (Thresholds->TryGetObjectField(TEXT("AbilityAvgCostMs"), AbilityLimits))
+	{
+		for (int32 Index = 0; Index < AbilityResults.Num(); ++Index)
+		{
+			const FAbilityResult& Result = AbilityResults[Index];
+			if (Result.Activations == 0)
+			{
+				continue;
+			}
+
+			const FString AbilityName = GetNameSafe(BenchmarkAbilities[Index]);
+			const double AverageMs = Result.TotalCostMs / Result.Activations;
+			if (((*AbilityLimits)->TryGetNumberField(AbilityName, Limit) || (*AbilityLimits)->TryGetNumberField(TEXT("default"), Limit)) && AverageMs > Limit)
+			{
+				OutFailures.Add(FString::Printf(TEXT("%s average activation %.3f ms > %.3f ms"), *AbilityName, AverageMs, Limit));
+			}
+		}
+	}
+
+	return OutFailures.Num() == 0;
+}
+
+/**
+ *  Writes the results as CSV (one metric per row, easy to diff between builds) and JSON, checks the thresholds and,
+ *  when unattended, exits with 0 on pass and 1 on regression.
+ */
+void ACOBenchmarkGameMode::FinishBenchmark()
+{
+	bFinished = true;
+	UCOCharacterMovementComponent::SetRecordTickCost(false);
+
+	TArray<double> SortedFrameTimes = FrameTimesMs;
+	SortedFrameTimes.Sort();
+	const double FrameP50 = Percentile(SortedFrameTimes, 0.50);
+	const double FrameP95 = Percentile(SortedFrameTimes, 0.95);
+	const double FrameP99 = Percentile(SortedFrameTimes, 0.99);
+	const double FrameMax = SortedFrameTimes.Num() > 0 ? SortedFrameTimes.Last() : 0.0;
+
+	TArray<double> SortedFragmentTicks = FragmentTickMs;
+	SortedFragmentTicks.Sort();
+	const double FragmentP50 = Percentile(SortedFragmentTicks, 0.50);
+	const double FragmentP99 = Percentile(SortedFragmentTicks, 0.99);
+
+	TArray<double> SortedStructureTicks = StructureTickMs;
+	SortedStructureTicks.Sort();
+	const double StructureP50 = Percentile(SortedStructureTicks, 0.50);
+	const double StructureP99 = Percentile(SortedStructureTicks, 0.99);
+	const double StructureSpawnAvg = StructureSpawns > 0 ? StructureSpawnTotalMs / StructureSpawns : 0.0;
+
+	TArray<double> SortedVineTicks = VineTickMs;
+	SortedVineTicks.Sort();
+	const double VineP50 = Percentile(SortedVineTicks, 0.50);
+	const double VineP99 = Percentile(SortedVineTicks, 0.99);
+
+	TArray<double> SortedStatusTicks = StatusTickMs;
+	SortedStatusTicks.Sort();
+	const double StatusP50 = Percentile(SortedStatusTicks, 0.50);
+	const double StatusP99 = Percentile(SortedStatusTicks, 0.99);
+
+	TArray<double> SortedMovementTicks = MovementTickUs;
+	SortedMovementTicks.Sort();
+	const double MovementP50 = Percentile(SortedMovementTicks, 0.50);
+	const double MovementP99 = Percentile(SortedMovementTicks, 0.99);
+
+	TArray<FString> Failures;
+	const bool bPassed = CheckThresholds(FrameP50, FrameP99, FragmentP99, StructureP99, VineP99, StatusP99, Failures);
+
+	FString Csv = TEXT("Metric,Value\n");
+	Csv += FString::Printf(TEXT("Enemies,%d\nFrames,%d\nFrameTimeP50Ms,%.3f\nFrameTimeP95Ms,%.3f\nFrameTimeP99Ms,%.3f\nFrameTimeMaxMs,%.3f\n"),
+		NumEnemies, SortedFrameTimes.Num(), FrameP50, FrameP95, FrameP99, FrameMax);
+	Csv += FString::Printf(TEXT("EnemyClass,%s\nEnemyGASBytes,%.0f\nDamageEffectsPerSecond,%.0f\n"), *GetNameSafe(EnemyClass), EnemyGASBytes, DamageEffectsPerSecond);
+	Csv += FString::Printf(TEXT("StressFragments,%d\nFragmentTickP50Ms,%.4f\nFragmentTickP99Ms,%.4f\n"), NumStressFragments, FragmentP50, FragmentP99);
+	Csv += FString::Printf(TEXT("StressStructures,%d\nStructureSpawns,%d\nStructureSpawnAvgMs,%.4f\nStructureTickP50Ms,%.4f\nStructureTickP99Ms,%.4f\n"),
+		NumStressStructures, StructureSpawns, StructureSpawnAvg, StructureP50, StructureP99);
+	Csv += FString::Printf(TEXT("StressVines,%d\nStressVineSegments,%d\nVineTickP50Ms,%.4f\nVineTickP99Ms,%.4f\n"),
+		NumStressVines, StressVineSegments, VineP50, VineP99);
+	Csv += FString::Printf(TEXT("StressStatuses,%d\nStatusTickP50Ms,%.4f\nStatusTickP99Ms,%.4f\n"), bStressStatuses ? 1 : 0, StatusP50, StatusP99);
+	Csv += FString::Printf(TEXT("StressWalkers,%d\nPlanarFloorCache,%d\nArenaGaps,%d\nMovementTickP50Us,%.3f\nMovementTickP99Us,%.3f\n"),
+		bStressWalkers ? 1 : 0, bUsePlanarFloors ? 1 : 0, NumArenaGaps, MovementP50, MovementP99);
+
+	TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+	Json->SetNumberField(TEXT("Enemies"), NumEnemies);
+	Json->SetStringField(TEXT("EnemyClass"), GetNameSafe(EnemyClass));
+	Json->SetNumberField(TEXT("EnemyGASBytes"), EnemyGASBytes);
+	Json->SetNumberField(TEXT("DamageEffectsPerSecond"), DamageEffectsPerSecond);
+	Json->SetNumberField(TEXT("Frames"), SortedFrameTimes.Num());
+	Json->SetNumberField(TEXT("FrameTimeP50Ms"), FrameP50);
+	Json->SetNumberField(TEXT("FrameTimeP95Ms"), FrameP95);
+	Json->SetNumberField(TEXT("FrameTimeP99Ms"), FrameP99);
+	Json->SetNumberField(TEXT("FrameTimeMaxMs"), FrameMax);
+	Json->SetNumberField(TEXT("StressFragments"), NumStressFragments);
+	Json->SetNumberField(TEXT("FragmentTickP50Ms"), FragmentP50);
+	Json->SetNumberField(TEXT("FragmentTickP99Ms"), FragmentP99);
+	Json->SetNumberField(TEXT("StressStructures"), NumStressStructures);
+	Json->SetNumberField(TEXT("StructureSpawns"), StructureSpawns);
+	Json->SetNumberField(TEXT("StructureSpawnAvgMs"), StructureSpawnAvg);
+	Json->SetNumberField(TEXT("StructureTickP50Ms"), StructureP50);
+	Json->SetNumberField(TEXT("StructureTickP99Ms"), StructureP99);
+	Json->SetNumberField(TEXT("StressVines"), NumStressVines);
+	Json->SetNumberField(TEXT("StressVineSegments"), StressVineSegments);
+	Json->SetNumberField(TEXT("VineTickP50Ms"), VineP50);
+	Json->SetNumberField(TEXT("VineTickP99Ms"), VineP99);
+	Json->SetBoolField(TEXT("StressStatuses"), bStressStatuses);
+	Json->SetNumberField(TEXT("StatusTickP50Ms"), StatusP50);
+	Json->SetNumberField(TEXT("StatusTickP99Ms"), StatusP99);
+	Json->SetBoolField(TEXT("StressWalkers"), bStressWalkers);
+	Json->SetBoolField(TEXT("PlanarFloorCache"), bUsePlanarFloors);
+	Json->SetNumberField(TEXT("ArenaGaps"), NumArenaGaps);
+	Json->SetNumberField(TEXT("MovementTickP50Us"), MovementP50);
+	Json->SetNumberField(TEXT("MovementTickP99Us"), MovementP99);
+
+	const UCODamageAccumulatorSubsystem* DamageAccumulator = GetWorld()->GetSubsystem<UCODamageAccumulatorSubsystem>();
+
+	TArray<TSharedPtr<FJsonValue>> JsonAbilities;
+	for (int32 Index = 0; Index < AbilityResults.Num(); ++Index)
+	{
+		const FAbilityResult& Result = AbilityResults[Index];
+		const FString AbilityName = GetNameSafe(BenchmarkAbilities[Index]);
+		const double AverageMs = Result.Activations > 0 ? Result.TotalCostMs / Result.Activations : 0.0;
+
+		//Coalesced hits land as one effect per target and frame, so they are counted by the accumulator instead
+		const int32 EffectsApplied = Result.EffectsApplied
+			+ (DamageAccumulator && BenchmarkAbilities[Index] ? DamageAccumulator->GetHitsByAbility().FindRef(BenchmarkAbilities[Index]->GetFName()) : 0);
+
+		Csv += FString::Printf(TEXT("%s.Activations,%d\n%s.Failures,%d\n%s.EffectsApplied,%d\n%s.AvgCostMs,%.4f\n%s.MaxCostMs,%.4f\n"),
+			*AbilityName, Result.Activations, *AbilityName, Result.Failures, *AbilityName, EffectsApplied,
+			*AbilityName, AverageMs, *AbilityName, Result.MaxCostMs);
+
+		TSharedRef<FJsonObject> JsonAbility = MakeShared<FJsonObject>();
+		JsonAbility->SetStringField(TEXT("Name"), AbilityName);
+		JsonAbility->SetNumberField(TEXT("Activations"), Result.Activations);
+		JsonAbility->SetNumberField(TEXT("Failures"), Result.Failures);
+		JsonAbility->SetNumberField(TEXT("EffectsApplied"), EffectsApplied);
+		JsonAbility->SetNumberField(TEXT("AvgCostMs"), AverageMs);
+		JsonAbility->SetNumberField(TEXT("MaxCostMs"), Result.MaxCostMs);
+		JsonAbilities.Add(MakeShared<FJsonValueObject>(JsonAbility));
+	}
+	Json->SetArrayField(TEXT("Abilities"), JsonAbilities);
+
+	// Coalesced damage: hits queued against Health writes made, and damage and kills credited per source ability
+	if (DamageAccumulator)
+	{
+		Csv += FString::Printf(TEXT("DamageEvents,%lld\nHealthWrites,%lld\n"), DamageAccumulator->GetNumDamageEvents(), DamageAccumulator->GetNumHealthWrites());
+		Json->SetNumberField(TEXT("DamageEvents"), DamageAccumulator->GetNumDamageEvents());
+		Json->SetNumberField(TEXT("HealthWrites"), DamageAccumulator->GetNumHealthWrites());
+
+		TSharedRef<FJsonObject> JsonDamage = MakeShared<FJsonObject>();
+		for (const TPair<FName, double>& Entry : DamageAccumulator->GetDamageByAbility())
+		{
+			Csv += FString::Printf(TEXT("%s.DamageDealt,%.1f\n"), *Entry.Key.ToString(), Entry.Value);
+			JsonDamage->SetNumberField(Entry.Key.ToString(), Entry.Value);
+		}
+		Json->SetObjectField(TEXT("DamageByAbility"), JsonDamage);
+
+		TSharedRef<FJsonObject> JsonKills = MakeShared<FJsonObject>();
+		for (const TPair<FName, int32>& Entry : DamageAccumulator->GetKillsByAbility())
+		{
+			Csv += FString::Printf(TEXT("%s.Kills,%d\n"), *Entry.Key.ToString(), Entry.Value);
+			JsonKills->SetNumberField(Entry.Key.ToString(), Entry.Value);
+		}
+		Json->SetObjectField(TEXT("KillsByAbility"), JsonKills);
+	}
+
+	TArray<TSharedPtr<FJsonValue>> JsonFailures;
+	for (const FString& Failure : Failures)
+	{
+		JsonFailures.Add(MakeShared<FJsonValueString>(Failure));
+		UE_LOG(LogCelestialOdyssey, Error, TEXT("Benchmark threshold failed: %s"), *Failure);
+	}
+	Json->SetBoolField(TEXT("Passed"), bPassed);
+	Json->SetArrayField(TEXT("Failures"), JsonFailures);
+
+	FString JsonText;
+	FJsonSerializer::Serialize(Json, TJsonWriterFactory<>::Create(&JsonText));
+
+	const FString OutputBase = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), OutputName);
+	FFileHelper::SaveStringToFile(Csv, *(OutputBase + TEXT(".csv")));
+	FFileHelper::SaveStringToFile(JsonText, *(OutputBase + TEXT(".json")));
+
+	UE_LOG(LogCelestialOdyssey, Log, TEXT("Benchmark %s: frame p50 %.2f ms, p99 %.2f ms, results in %s.csv/.json"),
+		bPassed ? TEXT("passed") : TEXT("FAILED"), FrameP50, FrameP99, *OutputBase);
+
+	if (FApp::IsUnattended())
+	{
+		FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1, TEXT("ACOBenchmarkGameMode::FinishBenchmark"));
+	}
+}
@@ -0,0 +1,162 @@
+#include "COCharacterMovementComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/Character.h"
+
+namespace
+{
+	bool bRecordTickCost = false;
+	double RecordedTickSeconds = 0.0;
+	int32 RecordedTicks = 0;
+}
+
+/*
+ * Constructor
+ */
+UCOCharacterMovementComponent::UCOCharacterMovementComponent()
+{
+}
+
+void UCOCharacterMovementComponent::SetRecordTickCost(bool bRecord)
+{
+	bRecordTickCost = bRecord;
+	RecordedTickSeconds = 0.0;
+	RecordedTicks = 0;
+}
+
+double UCOCharacterMovementComponent::ConsumeRecordedTickSeconds(int32& OutNumTicks)
+{
+	const double Seconds = RecordedTickSeconds;
+	OutNumTicks = RecordedTicks;
+	RecordedTickSeconds = 0.0;
+	RecordedTicks = 0;
+	return Seconds;
+}
+
+/*
+ * Times the whole movement tick while the benchmark records it.
+ */
+void UCOCharacterMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	if (!bRecordTickCost)
+	{
+		Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	RecordedTickSeconds += FPlatformTime::Seconds() - StartTime;
+	++RecordedTicks;
+}
+
+/*
+ * Flips the gravity direction and rolls the updated component so "up" follows it.
+ */
+void UCOCharacterMovementComponent::SetGravityInverted(bool bInverted)
+{
+	if (bGravityInverted == bInverted || !UpdatedComponent)
+	{
+		return;
+	}
+
+	bGravityInverted = bInverted;
+	SetGravityDirection(bInverted ? FVector::UpVector : FVector::DownVector);
+
+	//Roll half a turn around the screen-forward axis so the capsule's up vector opposes gravity
+	const FQuat NewRotation = FQuat(FVector::ForwardVector, UE_PI) * UpdatedComponent->GetComponentQuat();
+	MoveUpdatedComponent(FVector::ZeroVector, NewRotation, /*bSweep*/ false);
+
+	if (IsMovingOnGround())
+	{
+		SetMovementMode(MOVE_Falling);
+	}
+}
+
+/*
+ * Reuses the current floor when the capsule is still over the same flat, unmoved surface, otherwise sweeps as usual.
+ */
+void UCOCharacterMovementComponent::FindFloor(const FVector& CapsuleLocation, FFindFloorResult& OutFloorResult, bool bCanUseCachedLocation, const FHitResult* DownwardSweepResult) const
+{
+	if (bUsePlanarFloorCache && CanReusePlanarFloor(CapsuleLocation))
+	{
+		const FVector Offset(CapsuleLocation.X - CurrentFloor.HitResult.TraceStart.X, 0.0f, 0.0f);
+
+		OutFloorResult = CurrentFloor;
+		OutFloorResult.HitResult.TraceStart += Offset;
+		OutFloorResult.HitResult.TraceEnd += Offset;
+		OutFloorResult.HitResult.Location += Offset;
+		OutFloorResult.HitResult.ImpactPoint += Offset;
+		return;
+	}
+
+	Super::FindFloor(CapsuleLocation, OutFloorResult, bCanUseCachedLocation, DownwardSweepResult);
+
+	//Remember where the floor was when it was swept; any move of it after this sends the next query back to the sweep
+	if (UPrimitiveComponent* FloorComponent = OutFloorResult.HitResult.GetComponent())
+	{
+		SweptFloorComponent = FloorComponent;
+		SweptFloorTransform = FloorComponent->GetComponentTransform();
+	}
+	else
+	{
+		SweptFloorComponent.Reset();
+	}
+}
+
+/*
+ * Checks the conditions under which the cached floor is guaranteed to still be underneath the capsule.
+ */
+bool UCOCharacterMovementComponent::CanReusePlanarFloor(const FVector& CapsuleLocation) const
+{
+	if (bGravityInverted || !IsMovingOnGround() || !CurrentFloor.IsWalkableFloor() || !CharacterOwner)
+	{
+		return false;
+	}
+
+	const FHitResult& FloorHit = CurrentFloor.HitResult;
+	UPrimitiveComponent* FloorComponent = FloorHit.GetComponent();
+	if (!FloorComponent || FloorComponent != SweptFloorComponent.Get())
+	{
+		return false;
+	}
+
+	//Moving platforms: the cached hit is only valid while the component stays where it was swept
+	if (FloorComponent->Mobility != EComponentMobility::Static && !FloorComponent->GetComponentTransform().Equals(SweptFloorTransform, UE_KINDA_SMALL_NUMBER))
+	{
+		return false;
+	}
+
+	//Flat surface, and the capsule has not moved vertically since the floor was found
+	if (FloorHit.ImpactNormal.Z < 1.0f - UE_KINDA_SMALL_NUMBER || !FMath::IsNearlyEqual(CapsuleLocation.Z, FloorHit.TraceStart.Z, UE_KINDA_SMALL_NUMBER))
+	{
+		return false;
+	}
+
+	//The floor must be the top of the component, so nothing else on it can rise above the surface
+	const FBox Bounds = FloorComponent->Bounds.GetBox();
+	if (!FMath::IsNearlyEqual(Bounds.Max.Z, FloorHit.ImpactPoint.Z, 1.0f))
+	{
+		return false;
+	}
+
+	const float Radius = CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius();
+	if (CapsuleLocation.X - Radius < Bounds.Min.X || CapsuleLocation.X + Radius > Bounds.Max.X)
+	{
+		return false;
+	}
+
+	//The bounds say nothing about holes, so check the surface is still there; tracing one component skips the broadphase
+	const FVector ProbeStart(CapsuleLocation.X, FloorHit.ImpactPoint.Y, FloorHit.ImpactPoint.Z + 1.0f);
+	const FVector ProbeEnd(CapsuleLocation.X, FloorHit.ImpactPoint.Y, FloorHit.ImpactPoint.Z - 1.0f);
+	FHitResult ProbeHit;
+	return FloorComponent->LineTraceComponent(ProbeHit, ProbeStart, ProbeEnd, FCollisionQueryParams(SCENE_QUERY_STAT(COPlanarFloorProbe), false))
+		&& FMath::IsNearlyEqual(ProbeHit.ImpactPoint.Z, FloorHit.ImpactPoint.Z, 1.0f);
+}
+
+/*
+ * Keeps depenetration inside the movement plane so overlaps are never resolved along Y.
+ */
+FVector UCOCharacterMovementComponent::GetPenetrationAdjustment(const FHitResult& Hit) const
+{
+	return ConstrainDirectionToPlane(Super::GetPenetrationAdjustment(Hit));
+}
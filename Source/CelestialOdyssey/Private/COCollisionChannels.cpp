@@ -0,0 +1,8 @@
+#include "COCollisionChannels.h"
+
+namespace COCollisionProfiles
+{
+    const FName Enemy(TEXT("CO_Enemy"));
+    const FName Breakable(TEXT("CO_Breakable"));
+    const FName CrystalSurface(TEXT("CO_CrystalSurface"));
+}
@@ -0,0 +1,306 @@
+#include "COCrystalStructureSubsystem.h"
+#include "COCollisionChannels.h"
+#include "COStats.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crystal Structures Tick"), STAT_CO_CrystalStructuresTick, STATGROUP_CelestialOdyssey);
+DECLARE_CYCLE_STAT(TEXT("Crystal Structures Spawn"), STAT_CO_CrystalStructuresSpawn, STATGROUP_CelestialOdyssey);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Crystal Segments Pending"), STAT_CO_CrystalSegmentsPending, STATGROUP_CelestialOdyssey);
+
+namespace
+{
+    /** Where pooled instances wait between structures: far below the playable area, out of view and out of reach */
+    const FTransform ParkedTransform(FQuat::Identity, FVector(0.0f, 0.0f, -1.0e6f));
+
+    /** Adds a segment given its center and size in local structure space (X along the surface, Z along the normal) */
+    void AddSegment(TArray<FTransform>& OutSegments, const FTransform& StructureTransform, const FVector& Center, const FVector& Size, float Pitch = 0.0f)
+    {
+        const FTransform Local(FRotator(Pitch, 0.0f, 0.0f), Center, Size / UCOCrystalStructureSubsystem::SegmentSize);
+        OutSegments.Add(Local * StructureTransform);
+    }
+}
+
+void UCOCrystalStructureSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    SegmentMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+
+    // Structure lifetimes run on the expiry wheel
+    Collection.InitializeDependency<UCOExpirySubsystem>();
+}
+
+/**
+ * @brief Drops every structure when the world is torn down. The instance component goes with its actor.
+ */
+void UCOCrystalStructureSubsystem::Deinitialize()
+{
+    Structures.Reset();
+    InstancesToPark.Reset();
+    FreeInstances.Reset();
+    InstanceComponent = nullptr;
+
+    Super::Deinitialize();
+}
+
+TStatId UCOCrystalStructureSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCOCrystalStructureSubsystem, STATGROUP_Tickables);
+}
+
+bool UCOCrystalStructureSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+int32 UCOCrystalStructureSubsystem::GetNumInstances() const
+{
+    return InstanceComponent ? InstanceComponent->GetInstanceCount() : 0;
+}
+
+void UCOCrystalStructureSubsystem::SetSegmentMesh(UStaticMesh* Mesh)
+{
+    if (!Mesh || Mesh == SegmentMesh)
+    {
+        return;
+    }
+
+    SegmentMesh = Mesh;
+
+    if (InstanceComponent)
+    {
+        InstanceComponent->SetStaticMesh(Mesh);
+    }
+}
+
+/**
+ * @brief Creates the shared instance component on first use.
+ */
+bool UCOCrystalStructureSubsystem::EnsureInstanceComponent()
+{
+    if (InstanceComponent)
+    {
+        return true;
+    }
+
+    if (!SegmentMesh)
+    {
+        return false;
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.ObjectFlags |= RF_Transient;
+    AActor* StructureActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+    if (!StructureActor)
+    {
+        return false;
+    }
+
+    InstanceComponent = NewObject<UHierarchicalInstancedStaticMeshComponent>(StructureActor, TEXT("CrystalSegments"));
+    InstanceComponent->SetMobility(EComponentMobility::Movable);
+    // Tick rebuilds the cluster tree once per batch instead of after every moved instance
+    InstanceComponent->bAutoRebuildTreeOnInstanceChanges = false;
+    // Grown crystals are surfaces themselves, so further crystals can be grown from them
+    InstanceComponent->SetCollisionProfileName(COCollisionProfiles::CrystalSurface);
+    InstanceComponent->SetStaticMesh(SegmentMesh);
+    StructureActor->SetRootComponent(InstanceComponent);
+    InstanceComponent->RegisterComponent();
+
+    return true;
+}
+
+int32 UCOCrystalStructureSubsystem::SpawnStructure(ECrystalStructureType Type, int32 Level, const FVector& Location, const FRotator& Rotation, float Lifetime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_CO_CrystalStructuresSpawn);
+
+    if (!EnsureInstanceComponent())
+    {
+        return INDEX_NONE;
+    }
+
+    // Only the layout is computed here; instances are placed over the next ticks
+    FCOCrystalStructure& Structure = Structures.AddDefaulted_GetRef();
+    Structure.Id = NextStructureId++;
+    BuildSegments(Type, Level, FTransform(Rotation, Location), Structure.Segments);
+    Structure.Instances.Reserve(Structure.Segments.Num());
+
+    if (Lifetime > 0.0f)
+    {
+        if (UCOExpirySubsystem* Expiries = GetWorld()->GetSubsystem<UCOExpirySubsystem>())
+        {
+            Structure.ExpiryHandle = Expiries->ScheduleCallback(Lifetime, FSimpleDelegate::CreateUObject(this, &UCOCrystalStructureSubsystem::ExpireStructure, Structure.Id));
+        }
+    }
+
+    return Structure.Id;
+}
+
+void UCOCrystalStructureSubsystem::DespawnStructure(int32 StructureId)
+{
+    const int32 StructureIndex = Structures.IndexOfByPredicate([StructureId](const FCOCrystalStructure& Structure) { return Structure.Id == StructureId; });
+    if (StructureIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    if (UCOExpirySubsystem* Expiries = GetWorld()->GetSubsystem<UCOExpirySubsystem>())
+    {
+        Expiries->Cancel(Structures[StructureIndex].ExpiryHandle);
+    }
+    RemoveStructureAt(StructureIndex);
+}
+
+void UCOCrystalStructureSubsystem::ExpireStructure(int32 StructureId)
+{
+    const int32 StructureIndex = Structures.IndexOfByPredicate([StructureId](const FCOCrystalStructure& Structure) { return Structure.Id == StructureId; });
+    if (StructureIndex != INDEX_NONE)
+    {
+        RemoveStructureAt(StructureIndex);
+    }
+}
+
+void UCOCrystalStructureSubsystem::RemoveStructureAt(int32 StructureIndex)
+{
+    InstancesToPark.Append(Structures[StructureIndex].Instances);
+    Structures.RemoveAtSwap(StructureIndex);
+}
+
+/**
+ * @brief Lays out the segments of a structure.
+ *
+ * Bridges and staircases extend forward from the anchor, platforms are centered on it, walls rise along
+ * the surface normal and an encasement is a ring standing on the surface around the anchor.
+ */
+void UCOCrystalStructureSubsystem::BuildSegments(ECrystalStructureType Type, int32 Level, const FTransform& StructureTransform, TArray<FTransform>& OutSegments)
+{
+    OutSegments.Reset();
+
+    const int32 ClampedLevel = FMath::Clamp(Level, 1, 3);
+    const float Depth = 2.0f * SegmentSize;
+    const float SlabThickness = 0.25f * SegmentSize;
+
+    switch (Type)
+    {
+    case ECrystalStructureType::Bridge:
+    {
+        const int32 NumSegments = 4 + 2 * ClampedLevel;
+        for (int32 Index = 0; Index < NumSegments; ++Index)
+        {
+            AddSegment(OutSegments, StructureTransform, FVector((Index + 0.5f) * SegmentSize, 0.0f, 0.5f * SlabThickness), FVector(SegmentSize, Depth, SlabThickness));
+        }
+        break;
+    }
+
+    case ECrystalStructureType::Wall:
+    {
+        const int32 NumSegments = 2 + ClampedLevel;
+        for (int32 Index = 0; Index < NumSegments; ++Index)
+        {
+            AddSegment(OutSegments, StructureTransform, FVector(0.0f, 0.0f, (Index + 0.5f) * SegmentSize), FVector(0.5f * SegmentSize, Depth, SegmentSize));
+        }
+        break;
+    }
+
+    case ECrystalStructureType::Platform:
+    {
+        const int32 NumSegments = 2 + ClampedLevel;
+        for (int32 Index = 0; Index < NumSegments; ++Index)
+        {
+            const float Offset = (Index - 0.5f * (NumSegments - 1)) * SegmentSize;
+            AddSegment(OutSegments, StructureTransform, FVector(Offset, 0.0f, 0.5f * SlabThickness), FVector(SegmentSize, Depth, SlabThickness));
+        }
+        break;
+    }
+
+    case ECrystalStructureType::Staircase:
+    {
+        // Each step is a solid column so the stairs can't be walked under
+        const int32 NumSteps = 6 * ClampedLevel;
+        const float StepHeight = 0.5f * SegmentSize;
+        for (int32 Index = 0; Index < NumSteps; ++Index)
+        {
+            const float Height = (Index + 1) * StepHeight;
+            AddSegment(OutSegments, StructureTransform, FVector((Index + 0.5f) * SegmentSize, 0.0f, 0.5f * Height), FVector(SegmentSize, Depth, Height));
+        }
+        break;
+    }
+
+    case ECrystalStructureType::Encasement:
+    {
+        const int32 NumSegments = 12;
+        const float Radius = 1.5f * SegmentSize;
+        for (int32 Index = 0; Index < NumSegments; ++Index)
+        {
+            const float Angle = (2.0f * PI * Index) / NumSegments;
+            const FVector Center(FMath::Cos(Angle) * Radius, 0.0f, Radius + FMath::Sin(Angle) * Radius);
+
+            // Pitch turns each slab so it lies tangent to the ring
+            AddSegment(OutSegments, StructureTransform, Center, FVector(SegmentSize, Depth, SlabThickness), FMath::RadiansToDegrees(Angle) + 90.0f);
+        }
+        break;
+    }
+    }
+}
+
+int32 UCOCrystalStructureSubsystem::AcquireInstance(const FTransform& Transform)
+{
+    if (FreeInstances.Num() > 0)
+    {
+        const int32 InstanceIndex = FreeInstances.Pop(EAllowShrinking::No);
+        InstanceComponent->UpdateInstanceTransform(InstanceIndex, Transform, true, false, true);
+        return InstanceIndex;
+    }
+
+    return InstanceComponent->AddInstance(Transform, true);
+}
+
+/**
+ * @brief Parks instances of removed structures, then grows pending segments.
+ *
+ * Parking and growing share the frame budget. Parking goes first so the freed instances can be reused by structures growing in the same tick.
+ */
+void UCOCrystalStructureSubsystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_CO_CrystalStructuresTick);
+
+    const double StartTime = FPlatformTime::Seconds();
+    LastTickSeconds = 0.0;
+
+    if (!InstanceComponent)
+    {
+        return;
+    }
+
+    const double Deadline = StartTime + GrowthBudgetSeconds;
+    int32 NumProcessed = 0;
+
+    while (InstancesToPark.Num() > 0 && NumProcessed < MaxSegmentsPerTick && FPlatformTime::Seconds() < Deadline)
+    {
+        const int32 InstanceIndex = InstancesToPark.Pop(EAllowShrinking::No);
+        InstanceComponent->UpdateInstanceTransform(InstanceIndex, ParkedTransform, true, false, true);
+        FreeInstances.Add(InstanceIndex);
+        ++NumProcessed;
+    }
+
+    int32 NumPending = 0;
+    for (FCOCrystalStructure& Structure : Structures)
+    {
+        while (!Structure.IsFullyGrown() && NumProcessed < MaxSegmentsPerTick && FPlatformTime::Seconds() < Deadline)
+        {
+            Structure.Instances.Add(AcquireInstance(Structure.Segments[Structure.Instances.Num()]));
+            ++NumProcessed;
+        }
+
+        NumPending += Structure.Segments.Num() - Structure.Instances.Num();
+    }
+
+    if (NumProcessed > 0)
+    {
+        InstanceComponent->BuildTreeIfOutdated(true, false);
+    }
+
+    SET_DWORD_STAT(STAT_CO_CrystalSegmentsPending, NumPending + InstancesToPark.Num());
+    LastTickSeconds = FPlatformTime::Seconds() - StartTime;
+}
@@ -0,0 +1,372 @@
+#include "CODamageAccumulatorSubsystem.h"
+#include "COEnemyAttributeSet.h"
+#include "COGameplayTags.h"
+#include "COMinionAbilitySystemComponent.h"
+#include "COPlayerAttributeSet.h"
+#include "COStats.h"
+#include "AbilitySystemComponent.h"
+#include "Abilities/GameplayAbility.h"
+#include "GameplayEffectComponent.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Damage Flush"), STAT_CO_DamageFlush, STATGROUP_CelestialOdyssey);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Events"), STAT_CO_DamageEvents, STATGROUP_CelestialOdyssey);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Health Writes"), STAT_CO_HealthWrites, STATGROUP_CelestialOdyssey);
+
+namespace
+{
+    /** Damage queued without an attribute is taken from enemy Health */
+    FGameplayAttribute ResolveHealthAttribute(const FGameplayAttribute& Attribute)
+    {
+        return Attribute.IsValid() ? Attribute : UCOEnemyAttributeSet::GetHealthAttribute();
+    }
+
+    /** Minions keep Health in the minion store rather than an attribute set */
+    float GetHealth(const UAbilitySystemComponent* AbilitySystem, const FGameplayAttribute& Attribute)
+    {
+        if (const UCOMinionAbilitySystemComponent* Minion = Cast<UCOMinionAbilitySystemComponent>(AbilitySystem))
+        {
+            if (Attribute == UCOMinionAbilitySystemComponent::GetHealthAttribute())
+            {
+                return Minion->GetHealth();
+            }
+        }
+
+        return AbilitySystem->GetNumericAttribute(Attribute);
+    }
+}
+
+UCOCoalescedDamageEffect::UCOCoalescedDamageEffect()
+{
+    DurationPolicy = EGameplayEffectDurationType::Instant;
+
+    FSetByCallerFloat Damage;
+    Damage.DataTag = COGameplayTags::Data_Damage;
+
+    FGameplayModifierInfo& Modifier = Modifiers.AddDefaulted_GetRef();
+    Modifier.Attribute = UCOEnemyAttributeSet::GetHealthAttribute();
+    Modifier.ModifierOp = EGameplayModOp::Additive;
+    Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(Damage);
+}
+
+UCOCoalescedPlayerDamageEffect::UCOCoalescedPlayerDamageEffect()
+{
+    Modifiers[0].Attribute = UCOPlayerAttributeSet::GetLivesAttribute();
+}
+
+FCODamageSource FCODamageSource::FromSpec(const FGameplayEffectSpec& Spec)
+{
+    const FGameplayEffectContextHandle& Context = Spec.GetContext();
+
+    FCODamageSource Source;
+    Source.Instigator = Context.GetInstigatorAbilitySystemComponent();
+    if (const UGameplayAbility* Ability = Context.GetAbility())
+    {
+        Source.AbilityClass = Ability->GetClass();
+    }
+    return Source;
+}
+
+FName FCODamageSource::GetAbilityName() const
+{
+    const UClass* Class = AbilityClass.Get();
+    return Class ? Class->GetFName() : NAME_None;
+}
+
+/**
+ * @brief Drops queued damage when the world is torn down. Targets go with the world, so nothing is written.
+ */
+void UCODamageAccumulatorSubsystem::Deinitialize()
+{
+    PendingTargets.Empty();
+    PendingIndices.Empty();
+    Events.Empty();
+    FlushingTargets.Empty();
+    FlushingEvents.Empty();
+    DamageByAbility.Empty();
+    KillsByAbility.Empty();
+    HitsByAbility.Empty();
+
+    Super::Deinitialize();
+}
+
+TStatId UCODamageAccumulatorSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCODamageAccumulatorSubsystem, STATGROUP_Tickables);
+}
+
+bool UCODamageAccumulatorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+const UGameplayEffect* UCODamageAccumulatorSubsystem::FindCoalescedEffect(const FGameplayAttribute& Attribute)
+{
+    if (Attribute == UCOEnemyAttributeSet::GetHealthAttribute())
+    {
+        return GetDefault<UCOCoalescedDamageEffect>();
+    }
+    if (Attribute == UCOPlayerAttributeSet::GetLivesAttribute())
+    {
+        return GetDefault<UCOCoalescedPlayerDamageEffect>();
+    }
+    return nullptr;
+}
+
+bool UCODamageAccumulatorSubsystem::IsPlainHealthEffect(const UGameplayEffect* Definition, const FGameplayAttribute& HealthAttribute)
+{
+    // Since 5.3 everything from granted tags to immunity and chance to apply lives in an effect component
+    if (!Definition || Definition->Executions.Num() > 0 || Definition->GameplayCues.Num() > 0 || Definition->Modifiers.Num() == 0
+        || Definition->FindComponent<UGameplayEffectComponent>())
+    {
+        return false;
+    }
+
+    for (const FGameplayModifierInfo& Modifier : Definition->Modifiers)
+    {
+        if (Modifier.Attribute != HealthAttribute || Modifier.ModifierOp != EGameplayModOp::Additive
+            || !Modifier.SourceTags.IsEmpty() || !Modifier.TargetTags.IsEmpty())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+FGameplayAttribute UCODamageAccumulatorSubsystem::FindPlainHealthAttribute(const UGameplayEffect* Definition)
+{
+    if (!Definition || Definition->Modifiers.Num() == 0)
+    {
+        return FGameplayAttribute();
+    }
+
+    const FGameplayAttribute& Attribute = Definition->Modifiers[0].Attribute;
+    return FindCoalescedEffect(Attribute) && IsPlainHealthEffect(Definition, Attribute) ? Attribute : FGameplayAttribute();
+}
+
+bool UCODamageAccumulatorSubsystem::ReadSpecDamage(const FGameplayEffectSpec& Spec, float& OutDamage, FGameplayAttribute& OutAttribute)
+{
+    OutDamage = 0.0f;
+
+    const UGameplayEffect* Definition = Spec.Def;
+    OutAttribute = FindPlainHealthAttribute(Definition);
+    if (!OutAttribute.IsValid() || Definition->DurationPolicy != EGameplayEffectDurationType::Instant)
+    {
+        return false;
+    }
+
+    float Amount = 0.0f;
+    for (const FGameplayModifierInfo& Modifier : Definition->Modifiers)
+    {
+        float Magnitude = 0.0f;
+        if (!Modifier.ModifierMagnitude.AttemptCalculateMagnitude(Spec, Magnitude))
+        {
+            return false;
+        }
+        Amount += Magnitude;
+    }
+
+    // Damage is authored as a negative Health modifier; healing is left to the regular effect path
+    OutDamage = -Amount;
+    return OutDamage > 0.0f;
+}
+
+void UCODamageAccumulatorSubsystem::AddDamage(UAbilitySystemComponent* Target, float Amount, const FCODamageSource& Source, const FGameplayAttribute& Attribute)
+{
+    if (!Target || Amount <= 0.0f)
+    {
+        return;
+    }
+
+    const FGameplayAttribute HealthAttribute = ResolveHealthAttribute(Attribute);
+    int32& TargetIndex = PendingIndices.FindOrAdd(MakeTuple(TObjectKey<UAbilitySystemComponent>(Target), HealthAttribute), INDEX_NONE);
+    if (TargetIndex == INDEX_NONE)
+    {
+        TargetIndex = PendingTargets.Num();
+        FCOPendingDamage& Pending = PendingTargets.AddDefaulted_GetRef();
+        Pending.Target = Target;
+        Pending.Attribute = HealthAttribute;
+        Pending.Instigator = Source.Instigator;
+    }
+
+    PendingTargets[TargetIndex].Total += Amount;
+
+    FCODamageEvent& Event = Events.AddDefaulted_GetRef();
+    Event.TargetIndex = TargetIndex;
+    Event.Amount = Amount;
+    Event.Source = Source;
+
+    ++NumDamageEvents;
+}
+
+void UCODamageAccumulatorSubsystem::ApplyDamageSpec(const FGameplayEffectSpec& Spec, TConstArrayView<UAbilitySystemComponent*> Targets)
+{
+    float Damage = 0.0f;
+    FGameplayAttribute HealthAttribute;
+    if (!ReadSpecDamage(Spec, Damage, HealthAttribute))
+    {
+        ApplySpecDirectly(Spec, Targets);
+        return;
+    }
+
+    // The applied-effect delegates fire when the coalesced effect lands at the flush; hits are counted per ability
+    const FCODamageSource Source = FCODamageSource::FromSpec(Spec);
+    for (UAbilitySystemComponent* Target : Targets)
+    {
+        AddDamage(Target, Damage, Source, HealthAttribute);
+    }
+}
+
+void UCODamageAccumulatorSubsystem::ApplyDamageSpec(const FGameplayEffectSpec& Spec, UAbilitySystemComponent* Target)
+{
+    if (Target)
+    {
+        ApplyDamageSpec(Spec, MakeArrayView(&Target, 1));
+    }
+}
+
+void UCODamageAccumulatorSubsystem::QueueOrApplyDamageSpec(const UWorld* World, const FGameplayEffectSpec& Spec, TConstArrayView<UAbilitySystemComponent*> Targets)
+{
+    if (UCODamageAccumulatorSubsystem* DamageAccumulator = World ? World->GetSubsystem<UCODamageAccumulatorSubsystem>() : nullptr)
+    {
+        DamageAccumulator->ApplyDamageSpec(Spec, Targets);
+    }
+    else
+    {
+        ApplySpecDirectly(Spec, Targets);
+    }
+}
+
+void UCODamageAccumulatorSubsystem::QueueOrApplyDamageSpec(const UWorld* World, const FGameplayEffectSpec& Spec, UAbilitySystemComponent* Target)
+{
+    if (Target)
+    {
+        QueueOrApplyDamageSpec(World, Spec, MakeArrayView(&Target, 1));
+    }
+}
+
+void UCODamageAccumulatorSubsystem::ApplySpecDirectly(const FGameplayEffectSpec& Spec, TConstArrayView<UAbilitySystemComponent*> Targets)
+{
+    UAbilitySystemComponent* Instigator = Spec.GetContext().GetInstigatorAbilitySystemComponent();
+    for (UAbilitySystemComponent* Target : Targets)
+    {
+        if (Instigator)
+        {
+            Instigator->ApplyGameplayEffectSpecToTarget(Spec, Target);
+        }
+        else
+        {
+            Target->ApplyGameplayEffectSpecToSelf(Spec);
+        }
+    }
+}
+
+void UCODamageAccumulatorSubsystem::ApplyDamageNow(UAbilitySystemComponent* Target, float Amount, UAbilitySystemComponent* Instigator, const FGameplayAttribute& Attribute)
+{
+    const UGameplayEffect* DamageEffect = FindCoalescedEffect(ResolveHealthAttribute(Attribute));
+    if (!Target || Amount <= 0.0f || !ensureMsgf(DamageEffect, TEXT("Damage to %s is not coalesced"), *Attribute.GetName()))
+    {
+        return;
+    }
+
+    UAbilitySystemComponent* ContextSource = Instigator ? Instigator : Target;
+    FGameplayEffectSpec Spec(DamageEffect, ContextSource->MakeEffectContext(), 1.0f);
+    Spec.SetSetByCallerMagnitude(COGameplayTags::Data_Damage, -Amount);
+
+    Target->ApplyGameplayEffectSpecToSelf(Spec);
+}
+
+/**
+ * @brief Writes each target's net damage for the frame, then settles kill credit and telemetry.
+ *
+ * The queue is swapped out first, so damage dealt by anything reacting to a kill lands in the next frame
+ * instead of changing the arrays being walked.
+ */
+void UCODamageAccumulatorSubsystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_CO_DamageFlush);
+
+    SET_DWORD_STAT(STAT_CO_DamageEvents, Events.Num());
+    SET_DWORD_STAT(STAT_CO_HealthWrites, PendingTargets.Num());
+
+    if (PendingTargets.Num() == 0)
+    {
+        return;
+    }
+
+    Swap(PendingTargets, FlushingTargets);
+    Swap(Events, FlushingEvents);
+    PendingIndices.Reset();
+
+    for (int32 TargetIndex = 0; TargetIndex < FlushingTargets.Num(); ++TargetIndex)
+    {
+        const FCOPendingDamage& Pending = FlushingTargets[TargetIndex];
+        UAbilitySystemComponent* Target = Pending.Target.Get();
+        if (!Target)
+        {
+            continue;
+        }
+
+        const float HealthBefore = GetHealth(Target, Pending.Attribute);
+        ApplyDamageNow(Target, Pending.Total, Pending.Instigator.Get(), Pending.Attribute);
+        ++NumHealthWrites;
+
+        if (HealthBefore > 0.0f && GetHealth(Target, Pending.Attribute) <= 0.0f)
+        {
+            const FCODamageSource Killer = FindKiller(TargetIndex);
+            ++KillsByAbility.FindOrAdd(Killer.GetAbilityName());
+            OnTargetKilled.Broadcast(Target, Killer);
+        }
+    }
+
+    // Consecutive events usually share a source, so the name lookups are skipped while it does not change
+    const FCODamageSource* LastSource = nullptr;
+    double* LastTotal = nullptr;
+    int32* LastHits = nullptr;
+    for (const FCODamageEvent& Event : FlushingEvents)
+    {
+        if (!LastSource || !(*LastSource == Event.Source))
+        {
+            LastSource = &Event.Source;
+            LastTotal = &DamageByAbility.FindOrAdd(Event.Source.GetAbilityName());
+            LastHits = &HitsByAbility.FindOrAdd(Event.Source.GetAbilityName());
+        }
+        *LastTotal += Event.Amount;
+        ++*LastHits;
+    }
+
+    FlushingTargets.Reset();
+    FlushingEvents.Reset();
+}
+
+FCODamageSource UCODamageAccumulatorSubsystem::FindKiller(int32 TargetIndex) const
+{
+    // Kills are rare, so the frame's events are simply walked per source
+    TArray<TPair<FCODamageSource, float>, TInlineAllocator<8>> Totals;
+    for (const FCODamageEvent& Event : FlushingEvents)
+    {
+        if (Event.TargetIndex != TargetIndex)
+        {
+            continue;
+        }
+
+        TPair<FCODamageSource, float>* Total = Totals.FindByPredicate([&Event](const TPair<FCODamageSource, float>& Entry) { return Entry.Key == Event.Source; });
+        if (!Total)
+        {
+            Total = &Totals.Emplace_GetRef(Event.Source, 0.0f);
+        }
+        Total->Value += Event.Amount;
+    }
+
+    const TPair<FCODamageSource, float>* Best = nullptr;
+    for (const TPair<FCODamageSource, float>& Entry : Totals)
+    {
+        if (!Best || Entry.Value > Best->Value)
+        {
+            Best = &Entry;
+        }
+    }
+
+    return Best ? Best->Key : FCODamageSource();
+}
@@ -0,0 +1,40 @@
+#include "COEnemyCharacter.h"
+#include "AbilitySystemComponent.h"
+#include "COEnemyAttributeSet.h"
+#include "COCollisionChannels.h"
+#include "Components/CapsuleComponent.h"
+
+/*
+ * Constructor
+ * Creates the Ability System Component and the enemy attribute set.
+ * The attribute set is optional so minion subclasses that keep their attributes elsewhere can skip it.
+ * The capsule uses the Enemy object type so ability queries can find enemies without sifting through other pawns.
+ */
+ACOEnemyCharacter::ACOEnemyCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	AbilitySystemComponent = CreateDefaultSubobject<UAbilitySystemComponent>(TEXT("AbilitySystemComponent"));
+	AbilitySystemComponent->SetReplicationMode(EGameplayEffectReplicationMode::Minimal);
+
+	GetCapsuleComponent()->SetCollisionProfileName(COCollisionProfiles::Enemy);
+
+	AttributeSet = CreateOptionalDefaultSubobject<UCOEnemyAttributeSet>(TEXT("AttributeSet"));
+}
+
+/*
+ * Returns the enemy's Ability System Component.
+ */
+UAbilitySystemComponent* ACOEnemyCharacter::GetAbilitySystemComponent() const
+{
+	return AbilitySystemComponent;
+}
+
+/*
+ * Called when the game starts or when spawned.
+ */
+void ACOEnemyCharacter::BeginPlay()
+{
+	AbilitySystemComponent->InitAbilityActorInfo(this, this);
+
+	Super::BeginPlay();
+}
@@ -0,0 +1,221 @@
+#include "COExpirySubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "COStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Expiry Wheel Tick"), STAT_CO_ExpiryWheelTick, STATGROUP_CelestialOdyssey);
+
+void UCOExpirySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    CurrentTick = static_cast<uint64>(GetWorld()->GetTimeSeconds() / TickResolution);
+}
+
+/**
+ * @brief Drops every pending record when the world is torn down.
+ */
+void UCOExpirySubsystem::Deinitialize()
+{
+    for (TArray<FCOExpiryRecord>& Bucket : Buckets)
+    {
+        Bucket.Empty();
+    }
+    Overflow.Empty();
+    Callbacks.Empty();
+    NumPending = 0;
+
+    Super::Deinitialize();
+}
+
+TStatId UCOExpirySubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCOExpirySubsystem, STATGROUP_Tickables);
+}
+
+bool UCOExpirySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FCOExpiryHandle UCOExpirySubsystem::ScheduleEffectRemoval(UAbilitySystemComponent* Target, FActiveGameplayEffectHandle EffectHandle, float Delay)
+{
+    FCOExpiryRecord Record;
+    Record.Action = ECOExpiryAction::RemoveActiveEffect;
+    Record.Target = Target;
+    Record.EffectHandle = EffectHandle;
+    return Schedule(MoveTemp(Record), Delay);
+}
+
+FCOExpiryHandle UCOExpirySubsystem::ScheduleCallback(float Delay, FSimpleDelegate Callback)
+{
+    FCOExpiryRecord Record;
+    Record.Action = ECOExpiryAction::Callback;
+    const FCOExpiryHandle Handle = Schedule(MoveTemp(Record), Delay);
+
+    Callbacks.Add(Handle.Id, MoveTemp(Callback));
+    return Handle;
+}
+
+void UCOExpirySubsystem::Cancel(FCOExpiryHandle& Handle)
+{
+    if (!Handle.IsValid())
+    {
+        return;
+    }
+
+    const uint32 Id = Handle.Id;
+    Handle.Invalidate();
+
+    // A callback record without a delegate fires as a no-op
+    if (Callbacks.Remove(Id) > 0)
+    {
+        return;
+    }
+
+    auto RemoveFrom = [this, Id](TArray<FCOExpiryRecord>& Records)
+    {
+        const int32 Index = Records.IndexOfByPredicate([Id](const FCOExpiryRecord& Record) { return Record.Id == Id; });
+        if (Index != INDEX_NONE)
+        {
+            Records.RemoveAtSwap(Index);
+            --NumPending;
+            return true;
+        }
+        return false;
+    };
+
+    for (TArray<FCOExpiryRecord>& Bucket : Buckets)
+    {
+        if (RemoveFrom(Bucket))
+        {
+            return;
+        }
+    }
+    RemoveFrom(Overflow);
+}
+
+FCOExpiryHandle UCOExpirySubsystem::Schedule(FCOExpiryRecord&& Record, float Delay)
+{
+    // Always fire on a later tick, even for zero or negative delays
+    const uint64 DelayTicks = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(Delay / TickResolution)));
+
+    Record.ExpireTick = CurrentTick + DelayTicks;
+    Record.Id = NextId++;
+    if (NextId == 0)
+    {
+        NextId = 1;
+    }
+
+    FCOExpiryHandle Handle;
+    Handle.Id = Record.Id;
+
+    Insert(MoveTemp(Record));
+    ++NumPending;
+
+    return Handle;
+}
+
+/**
+ * @brief Places a record in the lowest level whose range still contains its expiry tick.
+ *
+ * The level is picked from the highest bit group in which the expiry tick differs from the current
+ * tick, so a record is always cascaded down before the wheel reaches its slot.
+ */
+void UCOExpirySubsystem::Insert(FCOExpiryRecord&& Record)
+{
+    const uint64 Difference = Record.ExpireTick ^ CurrentTick;
+
+    for (int32 Level = 0; Level < NumLevels; ++Level)
+    {
+        if (Difference < (uint64(1) << (SlotBits * (Level + 1))))
+        {
+            const uint64 Slot = (Record.ExpireTick >> (SlotBits * Level)) & SlotMask;
+            Buckets[Level * SlotsPerLevel + Slot].Add(MoveTemp(Record));
+            return;
+        }
+    }
+
+    Overflow.Add(MoveTemp(Record));
+}
+
+void UCOExpirySubsystem::Cascade(int32 Level, int32 Slot)
+{
+    TArray<FCOExpiryRecord> Records = MoveTemp(Buckets[Level * SlotsPerLevel + Slot]);
+    Buckets[Level * SlotsPerLevel + Slot].Reset();
+
+    for (FCOExpiryRecord& Record : Records)
+    {
+        Insert(MoveTemp(Record));
+    }
+}
+
+/**
+ * @brief Advances the wheel to the current game time and fires every record that came due.
+ */
+void UCOExpirySubsystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_CO_ExpiryWheelTick);
+
+    const uint64 TargetTick = static_cast<uint64>(GetWorld()->GetTimeSeconds() / TickResolution);
+
+    while (CurrentTick < TargetTick)
+    {
+        ++CurrentTick;
+
+        // Pull records from the higher levels down whenever a lower level wraps around
+        if ((CurrentTick & SlotMask) == 0)
+        {
+            const int32 Level1Slot = static_cast<int32>((CurrentTick >> SlotBits) & SlotMask);
+            if (Level1Slot == 0)
+            {
+                const int32 Level2Slot = static_cast<int32>((CurrentTick >> (SlotBits * 2)) & SlotMask);
+                if (Level2Slot == 0)
+                {
+                    TArray<FCOExpiryRecord> FarRecords = MoveTemp(Overflow);
+                    Overflow.Reset();
+                    for (FCOExpiryRecord& Record : FarRecords)
+                    {
+                        Insert(MoveTemp(Record));
+                    }
+                }
+                Cascade(2, Level2Slot);
+            }
+            Cascade(1, Level1Slot);
+        }
+
+        TArray<FCOExpiryRecord>& Due = Buckets[CurrentTick & SlotMask];
+        FireBatch.Append(MoveTemp(Due));
+        Due.Reset();
+    }
+
+    // Fire after the wheel is consistent, so callbacks can safely schedule new expiries
+    NumPending -= FireBatch.Num();
+    for (const FCOExpiryRecord& Record : FireBatch)
+    {
+        Fire(Record);
+    }
+    FireBatch.Reset();
+}
+
+void UCOExpirySubsystem::Fire(const FCOExpiryRecord& Record)
+{
+    switch (Record.Action)
+    {
+    case ECOExpiryAction::RemoveActiveEffect:
+        if (UAbilitySystemComponent* Target = Record.Target.Get())
+        {
+            Target->RemoveActiveGameplayEffect(Record.EffectHandle);
+        }
+        break;
+
+    case ECOExpiryAction::Callback:
+        {
+            FSimpleDelegate Callback;
+            if (Callbacks.RemoveAndCopyValue(Record.Id, Callback))
+            {
+                Callback.ExecuteIfBound();
+            }
+        }
+        break;
+    }
+}
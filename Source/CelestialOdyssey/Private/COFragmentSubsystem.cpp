@@ -0,0 +1,309 @@
+#include "COFragmentSubsystem.h"
+#include "COCollisionChannels.h"
+#include "COTargetGridSubsystem.h"
+#include "CODamageAccumulatorSubsystem.h"
+#include "COStats.h"
+#include "AbilitySystemComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Async/ParallelFor.h"
+#include "Misc/App.h"
+
+DECLARE_CYCLE_STAT(TEXT("Fragments Tick"), STAT_CO_FragmentsTick, STATGROUP_CelestialOdyssey);
+DECLARE_CYCLE_STAT(TEXT("Fragments Target Hits"), STAT_CO_FragmentsTargetHits, STATGROUP_CelestialOdyssey);
+DECLARE_CYCLE_STAT(TEXT("Fragments Update Instances"), STAT_CO_FragmentsUpdateInstances, STATGROUP_CelestialOdyssey);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Live Fragments"), STAT_CO_LiveFragments, STATGROUP_CelestialOdyssey);
+
+namespace
+{
+    /** Fragments per ParallelFor batch; world traces dominate, so batches can stay small */
+    constexpr int32 FragmentBatchSize = 64;
+
+    /** Distance a bouncing fragment is pushed off the surface it hit */
+    constexpr float BounceOffset = 1.0f;
+}
+
+/**
+ * @brief Drops every fragment when the world is torn down.
+ */
+void UCOFragmentSubsystem::Deinitialize()
+{
+    Positions.Empty();
+    Velocities.Empty();
+    TimeLeft.Empty();
+    BouncesLeft.Empty();
+    VolleyIndices.Empty();
+    PreviousPositions.Empty();
+    Volleys.Empty();
+    InstanceComponent = nullptr;
+    NumVisibleInstances = 0;
+
+    Super::Deinitialize();
+}
+
+TStatId UCOFragmentSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCOFragmentSubsystem, STATGROUP_Tickables);
+}
+
+bool UCOFragmentSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+int32 UCOFragmentSubsystem::LaunchRadial(const FVector& Origin, int32 NumFragments, float Speed, int32 MaxBounces, float Lifetime, const FGameplayEffectSpecHandle& DamageSpec, const AActor* IgnoredActor)
+{
+    const int32 NumToLaunch = FMath::Min(NumFragments, MaxFragments - Positions.Num());
+    if (NumToLaunch <= 0)
+    {
+        return 0;
+    }
+
+    FCOFragmentVolley Volley;
+    Volley.DamageSpec = DamageSpec;
+    Volley.IgnoredActor = IgnoredActor;
+    Volley.PlaneY = Origin.Y;
+    Volley.NumLive = NumToLaunch;
+    const int32 VolleyIndex = Volleys.Add(MoveTemp(Volley));
+
+    const FVector2f Start(Origin.X, Origin.Z);
+    const uint8 Bounces = static_cast<uint8>(FMath::Clamp(MaxBounces, 0, MAX_uint8));
+
+    for (int32 Index = 0; Index < NumToLaunch; ++Index)
+    {
+        // Evenly spaced around a circle on the XZ plane
+        const float Angle = (2.0f * PI * Index) / NumToLaunch;
+
+        Positions.Add(Start);
+        Velocities.Add(FVector2f(FMath::Cos(Angle), FMath::Sin(Angle)) * Speed);
+        TimeLeft.Add(Lifetime);
+        BouncesLeft.Add(Bounces);
+        VolleyIndices.Add(VolleyIndex);
+    }
+
+    return NumToLaunch;
+}
+
+void UCOFragmentSubsystem::SetFragmentMesh(UStaticMesh* Mesh)
+{
+    // Nothing to draw in headless runs, so don't pay for the component at all
+    if (!Mesh || !FApp::CanEverRender())
+    {
+        return;
+    }
+
+    if (!InstanceComponent)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.ObjectFlags |= RF_Transient;
+        AActor* RenderActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+        if (!RenderActor)
+        {
+            return;
+        }
+
+        InstanceComponent = NewObject<UInstancedStaticMeshComponent>(RenderActor, TEXT("FragmentInstances"));
+        InstanceComponent->SetMobility(EComponentMobility::Movable);
+        InstanceComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        InstanceComponent->SetCastShadow(false);
+        RenderActor->SetRootComponent(InstanceComponent);
+        InstanceComponent->RegisterComponent();
+    }
+
+    InstanceComponent->SetStaticMesh(Mesh);
+}
+
+/**
+ * @brief Advances every fragment, resolves target hits and refreshes the instances.
+ */
+void UCOFragmentSubsystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_CO_FragmentsTick);
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    if (Positions.Num() > 0)
+    {
+        SimulateMovement(DeltaTime);
+        ApplyTargetHits();
+        RemoveDeadFragments();
+    }
+
+    UpdateInstances();
+
+    SET_DWORD_STAT(STAT_CO_LiveFragments, Positions.Num());
+    LastTickSeconds = FPlatformTime::Seconds() - StartTime;
+}
+
+/**
+ * @brief Integrates every fragment and ricochets it off world geometry.
+ *
+ * Each fragment only reads and writes its own entries, so the pass runs in parallel. A fragment that hits
+ * a surface with no bounces left, or runs out of time, is marked dead by zeroing its remaining time.
+ */
+void UCOFragmentSubsystem::SimulateMovement(float DeltaTime)
+{
+    UWorld* World = GetWorld();
+    const int32 NumFragments = Positions.Num();
+
+    PreviousPositions.SetNumUninitialized(NumFragments, EAllowShrinking::No);
+
+    const FCollisionObjectQueryParams ObjectParams = COCollision::MakeWorldGeometryParams();
+    const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(COFragmentTrace), false);
+
+    ParallelFor(TEXT("COFragmentMovement"), NumFragments, FragmentBatchSize, [&](int32 Index)
+    {
+        PreviousPositions[Index] = Positions[Index];
+
+        TimeLeft[Index] -= DeltaTime;
+        if (TimeLeft[Index] <= 0.0f)
+        {
+            return;
+        }
+
+        const FVector2f Start = Positions[Index];
+        const FVector2f End = Start + Velocities[Index] * DeltaTime;
+        const float PlaneY = Volleys[VolleyIndices[Index]].PlaneY;
+
+        FHitResult Hit;
+        if (!World->LineTraceSingleByObjectType(Hit, FVector(Start.X, PlaneY, Start.Y), FVector(End.X, PlaneY, End.Y), ObjectParams, QueryParams))
+        {
+            Positions[Index] = End;
+            return;
+        }
+
+        const FVector2f Normal = FVector2f(Hit.ImpactNormal.X, Hit.ImpactNormal.Z).GetSafeNormal();
+        if (BouncesLeft[Index] == 0 || Normal.IsNearlyZero())
+        {
+            TimeLeft[Index] = 0.0f;
+            return;
+        }
+
+        // Reflect in the plane and continue from the impact point; the rest of this step is dropped
+        --BouncesLeft[Index];
+        Velocities[Index] -= 2.0f * FVector2f::DotProduct(Velocities[Index], Normal) * Normal;
+        Positions[Index] = FVector2f(Hit.Location.X, Hit.Location.Z) + Normal * BounceOffset;
+    });
+}
+
+/**
+ * @brief Damages the first target each live fragment crossed this tick and breaks that fragment.
+ */
+void UCOFragmentSubsystem::ApplyTargetHits()
+{
+    SCOPE_CYCLE_COUNTER(STAT_CO_FragmentsTargetHits);
+
+    UCOTargetGridSubsystem* TargetGrid = GetWorld()->GetSubsystem<UCOTargetGridSubsystem>();
+    if (!TargetGrid || TargetGrid->GetNumTargets() == 0)
+    {
+        return;
+    }
+
+    for (int32 Index = 0; Index < Positions.Num(); ++Index)
+    {
+        if (TimeLeft[Index] <= 0.0f)
+        {
+            continue;
+        }
+
+        const FCOFragmentVolley& Volley = Volleys[VolleyIndices[Index]];
+        const FVector2f& Start = PreviousPositions[Index];
+        const FVector2f& End = Positions[Index];
+
+        TargetGrid->QuerySegment(FVector(Start.X, Volley.PlaneY, Start.Y), FVector(End.X, Volley.PlaneY, End.Y), FragmentRadius, TargetScratch, Volley.IgnoredActor.Get());
+        if (TargetScratch.Num() == 0)
+        {
+            continue;
+        }
+
+        if (Volley.DamageSpec.IsValid())
+        {
+            UCODamageAccumulatorSubsystem::QueueOrApplyDamageSpec(GetWorld(), *Volley.DamageSpec.Data.Get(), TargetScratch[0]);
+        }
+
+        TimeLeft[Index] = 0.0f;
+    }
+}
+
+void UCOFragmentSubsystem::RemoveDeadFragments()
+{
+    for (int32 Index = Positions.Num() - 1; Index >= 0; --Index)
+    {
+        if (TimeLeft[Index] <= 0.0f)
+        {
+            RemoveFragmentAt(Index);
+        }
+    }
+}
+
+/**
+ * @brief Swap-removes a fragment from every array, keeping the allocations for later launches.
+ */
+void UCOFragmentSubsystem::RemoveFragmentAt(int32 Index)
+{
+    const int32 VolleyIndex = VolleyIndices[Index];
+    if (--Volleys[VolleyIndex].NumLive == 0)
+    {
+        Volleys.RemoveAt(VolleyIndex);
+    }
+
+    Positions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Velocities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    TimeLeft.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    BouncesLeft.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    VolleyIndices.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+/**
+ * @brief Writes every live fragment into the instance buffer in one batch.
+ *
+ * Instances are never removed: the component grows to the peak fragment count and instances past the
+ * live count are collapsed to zero scale, so launches after the first peak don't reallocate render data.
+ */
+void UCOFragmentSubsystem::UpdateInstances()
+{
+    if (!InstanceComponent)
+    {
+        return;
+    }
+
+    const int32 NumLive = Positions.Num();
+    const int32 NumToWrite = FMath::Max(NumLive, NumVisibleInstances);
+    if (NumToWrite == 0)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_CO_FragmentsUpdateInstances);
+
+    TransformScratch.Reset(NumToWrite);
+    for (int32 Index = 0; Index < NumLive; ++Index)
+    {
+        const FVector2f& Position = Positions[Index];
+        const FVector2f& Velocity = Velocities[Index];
+        const float PlaneY = Volleys[VolleyIndices[Index]].PlaneY;
+        const FRotator Rotation(FMath::RadiansToDegrees(FMath::Atan2(Velocity.Y, Velocity.X)), 0.0f, 0.0f);
+
+        TransformScratch.Emplace(Rotation, FVector(Position.X, PlaneY, Position.Y));
+    }
+    for (int32 Index = NumLive; Index < NumToWrite; ++Index)
+    {
+        TransformScratch.Emplace(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector);
+    }
+
+    const int32 NumInstances = InstanceComponent->GetInstanceCount();
+    if (NumToWrite > NumInstances)
+    {
+        const TArray<FTransform> NewTransforms(TransformScratch.GetData() + NumInstances, NumToWrite - NumInstances);
+        InstanceComponent->AddInstances(NewTransforms, false, true);
+        TransformScratch.SetNum(NumInstances, EAllowShrinking::No);
+    }
+
+    if (TransformScratch.Num() > 0)
+    {
+        InstanceComponent->BatchUpdateInstancesTransforms(0, TransformScratch, true, true, true);
+    }
+
+    NumVisibleInstances = NumLive;
+}
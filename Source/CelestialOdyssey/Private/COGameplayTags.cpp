@@ -0,0 +1,27 @@
+#include "COGameplayTags.h"
+
+namespace COGameplayTags
+{
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(Ability_Available, "Ability.Available", "Indicates the ability can be used.");
+    UE_DEFINE_GAMEPLAY_TAG(Ability_Available_CelestialDash, "Ability.Available.CelestialDash");
+
+    UE_DEFINE_GAMEPLAY_TAG(Cooldown_Ability_CelestialDash, "Cooldown.Ability.CelestialDash");
+    UE_DEFINE_GAMEPLAY_TAG(Cooldown_Ability_CosmicStrike, "Cooldown.Ability.CosmicStrike");
+    UE_DEFINE_GAMEPLAY_TAG(Cooldown_Ability_CrystalGrowth, "Cooldown.Ability.CrystalGrowth");
+    UE_DEFINE_GAMEPLAY_TAG(Cooldown_Ability_CrystalShatter, "Cooldown.Ability.CrystalShatter");
+    UE_DEFINE_GAMEPLAY_TAG(Cooldown_Ability_GravityShift, "Cooldown.Ability.GravityShift");
+    UE_DEFINE_GAMEPLAY_TAG(Cooldown_Ability_GroundSlam, "Cooldown.Ability.GroundSlam");
+    UE_DEFINE_GAMEPLAY_TAG(Cooldown_Ability_LunarForestFury, "Cooldown.Ability.LunarForestFury");
+    UE_DEFINE_GAMEPLAY_TAG(Cooldown_Ability_VineWhip, "Cooldown.Ability.VineWhip");
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(Cooldown_Active, "Cooldown.Active", "Indicates when an ability is on cooldown.");
+    UE_DEFINE_GAMEPLAY_TAG(Cooldown_Active_CelestialDash, "Cooldown.Active.CelestialDash");
+
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(State_Casting, "State.Casting", "Indicates the player is currently casting an ability.");
+    UE_DEFINE_GAMEPLAY_TAG(State_CC_Rooted, "State.CC.Rooted");
+    UE_DEFINE_GAMEPLAY_TAG(State_CC_Stunned, "State.CC.Stunned");
+    UE_DEFINE_GAMEPLAY_TAG(State_GravityInverted, "State.GravityInverted");
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(State_OnCooldown, "State.OnCooldown", "Indicates an ability can't be used.");
+    UE_DEFINE_GAMEPLAY_TAG(State_Stunned, "State.Stunned");
+
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(Data_Damage, "Data.Damage", "SetByCaller magnitude for ability damage.");
+}
@@ -0,0 +1,69 @@
+#include "COInputRecording.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+/**
+ * @brief Writes the header and all records to disk.
+ */
+bool FCOInputRecording::SaveToFile(const FString& Filename) const
+{
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+
+    uint32 Magic = FileMagic;
+    uint32 Version = FileVersion;
+    float DeltaTime = FixedDeltaTime;
+    uint32 Frames = NumFrames;
+    int32 NumRecords = Records.Num();
+    Writer << Magic << Version << DeltaTime << Frames << NumRecords;
+
+    for (FCOInputRecord Record : Records)
+    {
+        Writer << Record;
+    }
+
+    return FFileHelper::SaveArrayToFile(Bytes, *ResolvePath(Filename));
+}
+
+/**
+ * @brief Reads a file written by SaveToFile.
+ */
+bool FCOInputRecording::LoadFromFile(const FString& Filename)
+{
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *ResolvePath(Filename)))
+    {
+        return false;
+    }
+
+    FMemoryReader Reader(Bytes);
+
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    int32 NumRecords = 0;
+    Reader << Magic << Version << FixedDeltaTime << NumFrames << NumRecords;
+    // Each packed record is Frame (4) + Time (4) + Action (1) + Value (4) bytes
+    const int64 RemainingBytes = Reader.TotalSize() - Reader.Tell();
+    if (Magic != FileMagic || Version != FileVersion || NumRecords < 0 || NumRecords > RemainingBytes / 13)
+    {
+        return false;
+    }
+
+    Records.SetNum(NumRecords);
+    for (FCOInputRecord& Record : Records)
+    {
+        Reader << Record;
+    }
+
+    return !Reader.IsError();
+}
+
+/**
+ * @brief Resolves a relative recording name against Saved/InputRecordings.
+ */
+FString FCOInputRecording::ResolvePath(const FString& Filename)
+{
+    return FPaths::IsRelative(Filename) ? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("InputRecordings"), Filename) : Filename;
+}
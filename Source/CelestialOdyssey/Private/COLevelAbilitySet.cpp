@@ -0,0 +1,32 @@
+#include "COLevelAbilitySet.h"
+#include "Abilities/GameplayAbility.h"
+
+const FPrimaryAssetType UCOLevelAbilitySet::PrimaryAssetType(TEXT("COLevelAbilitySet"));
+const FName UCOLevelAbilitySet::AbilitiesBundle(TEXT("Abilities"));
+
+/**
+ * @brief All level ability sets share one primary asset type, keyed by asset name.
+ */
+FPrimaryAssetId UCOLevelAbilitySet::GetPrimaryAssetId() const
+{
+    return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
+
+/**
+ * @brief Copies the loaded ability classes into a hard mapping.
+ */
+void UCOLevelAbilitySet::ResolveMapping(FCOLevelAbilityMapping& OutMapping) const
+{
+    OutMapping.PrimaryAbility = PrimaryAbility.Get();
+    OutMapping.SecondaryAbility = SecondaryAbility.Get();
+    OutMapping.ComboAbility = ComboAbility.Get();
+
+    OutMapping.CoreAbilities.Reset(CoreAbilities.Num());
+    for (const TSoftClassPtr<UGameplayAbility>& CoreAbility : CoreAbilities)
+    {
+        if (UClass* AbilityClass = CoreAbility.Get())
+        {
+            OutMapping.CoreAbilities.Add(AbilityClass);
+        }
+    }
+}
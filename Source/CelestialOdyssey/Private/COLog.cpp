@@ -0,0 +1,17 @@
+#include "COLog.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY(LogCelestialOdyssey);
+
+#if !UE_BUILD_SHIPPING
+
+int32 GCOAbilityTrace = 0;
+
+static FAutoConsoleVariableRef CVarCOAbilityTrace(
+    TEXT("co.Abilities.Trace"),
+    GCOAbilityTrace,
+    TEXT("Logs ability activations and input handling to LogCelestialOdyssey.\n")
+    TEXT("0: off (default), 1: on"),
+    ECVF_Cheat);
+
+#endif
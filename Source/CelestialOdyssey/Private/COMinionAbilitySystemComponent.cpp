@@ -0,0 +1,275 @@
+#include "COMinionAbilitySystemComponent.h"
+#include "COEnemyAttributeSet.h"
+#include "COExpirySubsystem.h"
+#include "COLog.h"
+#include "COStatusEffectSubsystem.h"
+#include "GameplayEffect.h"
+#include "Engine/World.h"
+
+UCOMinionAbilitySystemComponent::UCOMinionAbilitySystemComponent()
+{
+    // Minions carry no replicated state and nothing that needs a tick; see the class comment for what that costs
+    SetIsReplicatedByDefault(false);
+    PrimaryComponentTick.bCanEverTick = false;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UCOMinionAbilitySystemComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    AttributeStore = GetWorld()->GetSubsystem<UCOMinionAttributeSubsystem>();
+    if (AttributeStore)
+    {
+        AttributeSlot = AttributeStore->AllocateSlot(InitialHealth, InitialMovementSpeed);
+    }
+}
+
+void UCOMinionAbilitySystemComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (AttributeStore && AttributeSlot != INDEX_NONE)
+    {
+        AttributeStore->ReleaseSlot(AttributeSlot);
+    }
+
+    AttributeSlot = INDEX_NONE;
+
+    UCOStatusEffectSubsystem* StatusEffects = GetWorld()->GetSubsystem<UCOStatusEffectSubsystem>();
+    for (const FCOMinionActiveEffect& ActiveEffect : ActiveEffects)
+    {
+        if (StatusEffects && ActiveEffect.DamageOverTimeId != INDEX_NONE)
+        {
+            StatusEffects->RemoveStatus(ECOStatusType::DamageOverTime, ActiveEffect.DamageOverTimeId);
+        }
+    }
+    ActiveEffects.Reset();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+FGameplayAttribute UCOMinionAbilitySystemComponent::GetHealthAttribute()
+{
+    return UCOEnemyAttributeSet::GetHealthAttribute();
+}
+
+FGameplayAttribute UCOMinionAbilitySystemComponent::GetMovementSpeedAttribute()
+{
+    return UCOEnemyAttributeSet::GetMovementSpeedAttribute();
+}
+
+bool UCOMinionAbilitySystemComponent::ToMinionAttribute(const FGameplayAttribute& Attribute, ECOMinionAttribute& OutAttribute)
+{
+    if (Attribute == GetHealthAttribute())
+    {
+        OutAttribute = ECOMinionAttribute::Health;
+        return true;
+    }
+
+    if (Attribute == GetMovementSpeedAttribute())
+    {
+        OutAttribute = ECOMinionAttribute::MovementSpeed;
+        return true;
+    }
+
+    return false;
+}
+
+float UCOMinionAbilitySystemComponent::GetCurrentValue(ECOMinionAttribute Attribute) const
+{
+    return AttributeStore && AttributeSlot != INDEX_NONE ? AttributeStore->GetCurrentValue(AttributeSlot, Attribute) : 0.0f;
+}
+
+float UCOMinionAbilitySystemComponent::GetHealth() const
+{
+    return GetCurrentValue(ECOMinionAttribute::Health);
+}
+
+float UCOMinionAbilitySystemComponent::GetMovementSpeed() const
+{
+    return GetCurrentValue(ECOMinionAttribute::MovementSpeed);
+}
+
+float UCOMinionAbilitySystemComponent::GetAttributeBaseValue(const FGameplayAttribute& Attribute) const
+{
+    ECOMinionAttribute MinionAttribute;
+    if (!AttributeStore || AttributeSlot == INDEX_NONE || !ToMinionAttribute(Attribute, MinionAttribute))
+    {
+        return 0.0f;
+    }
+
+    return AttributeStore->GetBaseValue(AttributeSlot, MinionAttribute);
+}
+
+void UCOMinionAbilitySystemComponent::ApplyAttributeModifier(const FGameplayAttribute& Attribute, EGameplayModOp::Type Op, float Magnitude)
+{
+    ECOMinionAttribute MinionAttribute;
+    if (AttributeStore && AttributeSlot != INDEX_NONE && ToMinionAttribute(Attribute, MinionAttribute))
+    {
+        AttributeStore->ApplyInstant(AttributeSlot, MinionAttribute, Op, Magnitude);
+    }
+}
+
+/**
+ * @brief Writes an effect's modifiers straight into the attribute store.
+ *
+ * Instant effects change base values. Duration and infinite effects get a handle, add their modifiers and
+ * granted tags, and are removed through RemoveActiveGameplayEffect; duration effects schedule that removal
+ * on the expiry subsystem. Periodic effects add no modifiers: their damage runs on the status subsystem until
+ * the effect is removed. The usual applied-effect delegates still fire so listeners see no difference.
+ */
+FActiveGameplayEffectHandle UCOMinionAbilitySystemComponent::ApplyGameplayEffectSpecToSelf(const FGameplayEffectSpec& GameplayEffect, FPredictionKey PredictionKey)
+{
+    const UGameplayEffect* Definition = GameplayEffect.Def;
+    if (!Definition || !AttributeStore || AttributeSlot == INDEX_NONE || !CanApplyEffect(GameplayEffect))
+    {
+        return FActiveGameplayEffectHandle();
+    }
+
+    const bool bInstant = Definition->DurationPolicy == EGameplayEffectDurationType::Instant;
+    const bool bPeriodic = !bInstant && GameplayEffect.GetPeriod() > 0.0f;
+    UAbilitySystemComponent* Instigator = GameplayEffect.GetContext().GetInstigatorAbilitySystemComponent();
+
+    if (!bInstant && Definition->StackingType != EGameplayEffectStackingType::None)
+    {
+        RemoveStackedEffect(GameplayEffect);
+    }
+
+    const FActiveGameplayEffectHandle Handle = bInstant ? FActiveGameplayEffectHandle() : FActiveGameplayEffectHandle::GenerateNewHandle(this);
+
+    if (!bPeriodic)
+    {
+        const FGameplayTagContainer& SourceTags = *GameplayEffect.CapturedSourceTags.GetAggregatedTags();
+        const FGameplayTagContainer& TargetTags = GetOwnedGameplayTags();
+
+        for (const FGameplayModifierInfo& Modifier : Definition->Modifiers)
+        {
+            ECOMinionAttribute Attribute;
+            float Magnitude = 0.0f;
+            if (!ToMinionAttribute(Modifier.Attribute, Attribute)
+                || !Modifier.SourceTags.RequirementsMet(SourceTags)
+                || !Modifier.TargetTags.RequirementsMet(TargetTags)
+                || !Modifier.ModifierMagnitude.AttemptCalculateMagnitude(GameplayEffect, Magnitude))
+            {
+                continue;
+            }
+
+            if (bInstant)
+            {
+                AttributeStore->ApplyInstant(AttributeSlot, Attribute, Modifier.ModifierOp, Magnitude);
+            }
+            else
+            {
+                AttributeStore->AddModifier(AttributeSlot, Handle, Attribute, Modifier.ModifierOp, Magnitude);
+            }
+        }
+    }
+
+    if (!bInstant)
+    {
+        FCOMinionActiveEffect& ActiveEffect = ActiveEffects.AddDefaulted_GetRef();
+        ActiveEffect.Handle = Handle;
+        GameplayEffect.GetAllGrantedTags(ActiveEffect.GrantedTags);
+        ActiveEffect.Definition = Definition;
+        ActiveEffect.Instigator = Instigator;
+        AddLooseGameplayTags(ActiveEffect.GrantedTags);
+
+        if (bPeriodic)
+        {
+            ActiveEffect.DamageOverTimeId = StartDamageOverTime(GameplayEffect);
+        }
+
+        const float Duration = GameplayEffect.GetDuration();
+        if (Duration > 0.0f)
+        {
+            if (UCOExpirySubsystem* Expiries = GetWorld()->GetSubsystem<UCOExpirySubsystem>())
+            {
+                Expiries->ScheduleEffectRemoval(this, Handle, Duration);
+            }
+        }
+    }
+
+    OnGameplayEffectAppliedDelegateToSelf.Broadcast(Instigator, GameplayEffect, Handle);
+    if (Instigator)
+    {
+        Instigator->OnGameplayEffectAppliedDelegateToTarget.Broadcast(this, GameplayEffect, Handle);
+    }
+
+    return Handle;
+}
+
+bool UCOMinionAbilitySystemComponent::CanApplyEffect(const FGameplayEffectSpec& Spec)
+{
+    // Chance to apply and application tag requirements live on the effect's components
+    if (!Spec.Def->CanApply(ActiveGameplayEffects, Spec))
+    {
+        return false;
+    }
+
+    for (const FGameplayEffectApplicationQuery& Query : GameplayEffectApplicationQueries)
+    {
+        if (Query.IsBound() && !Query.Execute(ActiveGameplayEffects, Spec))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void UCOMinionAbilitySystemComponent::RemoveStackedEffect(const FGameplayEffectSpec& Spec)
+{
+    const bool bBySource = Spec.Def->StackingType == EGameplayEffectStackingType::AggregateBySource;
+    const UAbilitySystemComponent* Instigator = Spec.GetContext().GetInstigatorAbilitySystemComponent();
+
+    const FCOMinionActiveEffect* Stacked = ActiveEffects.FindByPredicate([&](const FCOMinionActiveEffect& ActiveEffect)
+    {
+        return ActiveEffect.Definition == Spec.Def && (!bBySource || ActiveEffect.Instigator == Instigator);
+    });
+
+    if (Stacked)
+    {
+        RemoveActiveGameplayEffect(Stacked->Handle);
+    }
+}
+
+int32 UCOMinionAbilitySystemComponent::StartDamageOverTime(const FGameplayEffectSpec& Spec)
+{
+    FCODamageOverTime DamageOverTime;
+    UCOStatusEffectSubsystem* StatusEffects = GetWorld()->GetSubsystem<UCOStatusEffectSubsystem>();
+    if (!StatusEffects || !UCOStatusEffectSubsystem::ReadDamageOverTime(Spec, DamageOverTime))
+    {
+        UE_LOG(LogCelestialOdyssey, Warning, TEXT("%s: periodic effect %s is not a plain Health drain and only grants its tags on minions"),
+            *GetNameSafe(GetOwner()), *GetNameSafe(Spec.Def));
+        return INDEX_NONE;
+    }
+
+    // The DoT has no duration of its own; it ends when the effect is removed
+    return StatusEffects->AddDamageOverTime(this, DamageOverTime, 0.0f, FCODamageSource::FromSpec(Spec));
+}
+
+bool UCOMinionAbilitySystemComponent::RemoveActiveGameplayEffect(FActiveGameplayEffectHandle Handle, int32 StacksToRemove)
+{
+    const int32 Index = ActiveEffects.IndexOfByPredicate([&Handle](const FCOMinionActiveEffect& ActiveEffect) { return ActiveEffect.Handle == Handle; });
+    if (Index == INDEX_NONE)
+    {
+        return Super::RemoveActiveGameplayEffect(Handle, StacksToRemove);
+    }
+
+    if (AttributeStore && AttributeSlot != INDEX_NONE)
+    {
+        AttributeStore->RemoveModifiers(AttributeSlot, Handle);
+    }
+
+    const int32 DamageOverTimeId = ActiveEffects[Index].DamageOverTimeId;
+    if (DamageOverTimeId != INDEX_NONE)
+    {
+        if (UCOStatusEffectSubsystem* StatusEffects = GetWorld()->GetSubsystem<UCOStatusEffectSubsystem>())
+        {
+            StatusEffects->RemoveStatus(ECOStatusType::DamageOverTime, DamageOverTimeId);
+        }
+    }
+
+    RemoveLooseGameplayTags(ActiveEffects[Index].GrantedTags);
+    ActiveEffects.RemoveAtSwap(Index);
+    return true;
+}
@@ -0,0 +1,191 @@
+#include "COMinionAttributeSubsystem.h"
+
+void UCOMinionAttributeSubsystem::Deinitialize()
+{
+    for (int32 Attribute = 0; Attribute < NumAttributes; ++Attribute)
+    {
+        BaseValues[Attribute].Empty();
+        CurrentValues[Attribute].Empty();
+    }
+
+    FreeSlots.Empty();
+    Modifiers.Empty();
+    NumAllocated = 0;
+
+    Super::Deinitialize();
+}
+
+bool UCOMinionAttributeSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+int32 UCOMinionAttributeSubsystem::AllocateSlot(float Health, float MovementSpeed)
+{
+    int32 Slot;
+    if (FreeSlots.Num() > 0)
+    {
+        Slot = FreeSlots.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        Slot = BaseValues[0].Num();
+        for (int32 Attribute = 0; Attribute < NumAttributes; ++Attribute)
+        {
+            BaseValues[Attribute].AddUninitialized();
+            CurrentValues[Attribute].AddUninitialized();
+        }
+    }
+
+    const float InitialValues[NumAttributes] = { Health, MovementSpeed };
+    for (int32 Attribute = 0; Attribute < NumAttributes; ++Attribute)
+    {
+        BaseValues[Attribute][Slot] = InitialValues[Attribute];
+        CurrentValues[Attribute][Slot] = InitialValues[Attribute];
+    }
+
+    ++NumAllocated;
+    return Slot;
+}
+
+void UCOMinionAttributeSubsystem::ReleaseSlot(int32 Slot)
+{
+    if (!BaseValues[0].IsValidIndex(Slot))
+    {
+        return;
+    }
+
+    Modifiers.RemoveAllSwap([Slot](const FCOMinionModifier& Modifier) { return Modifier.Slot == Slot; });
+    FreeSlots.Add(Slot);
+    --NumAllocated;
+}
+
+void UCOMinionAttributeSubsystem::ApplyInstant(int32 Slot, ECOMinionAttribute Attribute, EGameplayModOp::Type Op, float Magnitude)
+{
+    float& Base = BaseValues[static_cast<int32>(Attribute)][Slot];
+
+    switch (Op)
+    {
+    case EGameplayModOp::Additive:
+        Base += Magnitude;
+        break;
+
+    case EGameplayModOp::Multiplicitive:
+        Base *= Magnitude;
+        break;
+
+    case EGameplayModOp::Division:
+        Base = FMath::IsNearlyZero(Magnitude) ? Base : Base / Magnitude;
+        break;
+
+    case EGameplayModOp::Override:
+        Base = Magnitude;
+        break;
+
+    default:
+        break;
+    }
+
+    Base = ClampValue(Attribute, Base);
+    UpdateCurrentValue(Slot, Attribute);
+}
+
+void UCOMinionAttributeSubsystem::AddModifier(int32 Slot, const FActiveGameplayEffectHandle& Handle, ECOMinionAttribute Attribute, EGameplayModOp::Type Op, float Magnitude)
+{
+    FCOMinionModifier& Modifier = Modifiers.AddDefaulted_GetRef();
+    Modifier.Slot = Slot;
+    Modifier.Handle = Handle;
+    Modifier.Attribute = Attribute;
+    Modifier.Op = Op;
+    Modifier.Magnitude = Magnitude;
+
+    UpdateCurrentValue(Slot, Attribute);
+}
+
+void UCOMinionAttributeSubsystem::RemoveModifiers(int32 Slot, const FActiveGameplayEffectHandle& Handle)
+{
+    bool bChanged[NumAttributes] = {};
+
+    for (int32 Index = Modifiers.Num() - 1; Index >= 0; --Index)
+    {
+        if (Modifiers[Index].Slot == Slot && Modifiers[Index].Handle == Handle)
+        {
+            bChanged[static_cast<int32>(Modifiers[Index].Attribute)] = true;
+            Modifiers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+        }
+    }
+
+    for (int32 Attribute = 0; Attribute < NumAttributes; ++Attribute)
+    {
+        if (bChanged[Attribute])
+        {
+            UpdateCurrentValue(Slot, static_cast<ECOMinionAttribute>(Attribute));
+        }
+    }
+}
+
+/**
+ * @brief Folds the slot's modifiers into its base value the way the GAS aggregator does:
+ * ((Base + Additive) * Multiplicative) / Division, with multipliers and divisors summed as offsets from 1,
+ * and the last Override winning outright.
+ */
+void UCOMinionAttributeSubsystem::UpdateCurrentValue(int32 Slot, ECOMinionAttribute Attribute)
+{
+    float Additive = 0.0f;
+    float Multiplier = 1.0f;
+    float Divisor = 1.0f;
+    TOptional<float> Override;
+
+    for (const FCOMinionModifier& Modifier : Modifiers)
+    {
+        if (Modifier.Slot != Slot || Modifier.Attribute != Attribute)
+        {
+            continue;
+        }
+
+        switch (Modifier.Op)
+        {
+        case EGameplayModOp::Additive:
+            Additive += Modifier.Magnitude;
+            break;
+
+        case EGameplayModOp::Multiplicitive:
+            Multiplier += Modifier.Magnitude - 1.0f;
+            break;
+
+        case EGameplayModOp::Division:
+            Divisor += Modifier.Magnitude - 1.0f;
+            break;
+
+        case EGameplayModOp::Override:
+            Override = Modifier.Magnitude;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    const int32 AttributeIndex = static_cast<int32>(Attribute);
+    const float Base = BaseValues[AttributeIndex][Slot];
+    const float Value = Override.IsSet() ? Override.GetValue() : (Base + Additive) * Multiplier / (FMath::IsNearlyZero(Divisor) ? 1.0f : Divisor);
+
+    CurrentValues[AttributeIndex][Slot] = ClampValue(Attribute, Value);
+}
+
+float UCOMinionAttributeSubsystem::ClampValue(ECOMinionAttribute Attribute, float Value)
+{
+    // Neither health nor movement speed may go below zero
+    return FMath::Max(Value, 0.0f);
+}
+
+SIZE_T UCOMinionAttributeSubsystem::GetAllocatedSize() const
+{
+    SIZE_T Size = FreeSlots.GetAllocatedSize() + Modifiers.GetAllocatedSize();
+    for (int32 Attribute = 0; Attribute < NumAttributes; ++Attribute)
+    {
+        Size += BaseValues[Attribute].GetAllocatedSize() + CurrentValues[Attribute].GetAllocatedSize();
+    }
+
+    return Size;
+}
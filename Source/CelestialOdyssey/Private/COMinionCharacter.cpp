@@ -0,0 +1,13 @@
+#include "COMinionCharacter.h"
+#include "COMinionAbilitySystemComponent.h"
+
+/*
+ * Constructor
+ * Replaces the enemy's Ability System Component with the minion component and skips the attribute set.
+ */
+ACOMinionCharacter::ACOMinionCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer
+		.SetDefaultSubobjectClass<UCOMinionAbilitySystemComponent>(TEXT("AbilitySystemComponent"))
+		.DoNotCreateDefaultSubobject(TEXT("AttributeSet")))
+{
+}
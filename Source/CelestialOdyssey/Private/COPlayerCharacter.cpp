@@ -9,7 +9,8 @@
  *  Constructor
  *  Sets default properties for the player
  */
-ACOPlayerCharacter::ACOPlayerCharacter()
+ACOPlayerCharacter::ACOPlayerCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
 {
 	MoveSpeed = 600.0f;
 	JumpHeight = 420.0f;
@@ -24,6 +25,7 @@ ACOPlayerCharacter::ACOPlayerCharacter()
 	CameraBoom->SetupAttachment(RootComponent);
 	CameraBoom->TargetArmLength = CameraArmLength;
 	CameraBoom->bUsePawnControlRotation = false; 
+	CameraBoom->bInheritRoll = false; // Keep the view upright when gravity inverts and the capsule rolls
 
 	// Create the camera component
 	FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
@@ -40,11 +42,12 @@ void ACOPlayerCharacter::BeginPlay()
 }
 
 /**
- *  Called every frame to update the player character.
+ *  Updates the animation flags whenever the movement mode changes.
+ *  Leaving the ground without a jump counts as falling; any grounded mode clears every airborne flag.
  */
-void ACOPlayerCharacter::Tick(float DeltaTime)
+void ACOPlayerCharacter::OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode)
 {
-	Super::Tick(DeltaTime);
+	Super::OnMovementModeChanged(PrevMovementMode, PreviousCustomMode);
 
 	if (GetCharacterMovement()->IsFalling())
 	{
@@ -63,6 +66,29 @@ void ACOPlayerCharacter::Tick(float DeltaTime)
 	}
 }
 
+/**
+ *  Picks the jump animation once the jump has really happened.
+ *  The movement mode has already switched to falling at this point, so the falling flag is overridden here.
+ */
+void ACOPlayerCharacter::OnJumped_Implementation()
+{
+	Super::OnJumped_Implementation();
+
+	// Speed before the jump impulse decides between the moving and the idle jump, as when StartJump checked it
+	if (GetCharacterMovement()->GetLastUpdateVelocity().Size() > 0.0f)
+	{
+		bIsJumpingMoving = true;
+		bIsJumpingIdle = false;
+	}
+	else
+	{
+		bIsJumpingMoving = false;
+		bIsJumpingIdle = true;
+	}
+
+	bIsFalling = false;
+}
+
 /**
  *  Handles player movement along the X-axis(right/left).
  *  
@@ -109,19 +135,7 @@ void ACOPlayerCharacter::StartJump()
 {
 	GetCharacterMovement()->JumpZVelocity = JumpHeight;
 	ACharacter::Jump();
-	// Update booleans based on movement
-	if (GetCharacterMovement()->Velocity.Size() > 0.0f)
-	{
-		bIsJumpingMoving = true;
-		bIsJumpingIdle = false;
-	}
-	else
-	{
-		bIsJumpingMoving = false;
-		bIsJumpingIdle = true;
-	}
-
-	bIsFalling = false;
+	// Animation flags are set in OnJumped once the movement component performs the jump
 }
 
 /**
@@ -132,6 +146,9 @@ void ACOPlayerCharacter::StopJump()
 	ACharacter::StopJumping();
 	bIsJumpingMoving = false;
 	bIsJumpingIdle = false;
+
+	// Releasing jump mid-air hands over to the falling animation
+	bIsFalling = GetCharacterMovement()->IsFalling();
 }
 
 /**
@@ -168,6 +185,19 @@ void ACOPlayerCharacter::StopSprint()
 	GetCharacterMovement()->MaxWalkSpeed = MoveSpeed;
 }
 
+/**
+ * @brief Returns how long until the predicted ceiling contact, or -1 when none is pending.
+ */
+float ACOPlayerCharacter::GetTimeUntilCeilingContact() const
+{
+	if (PredictedCeilingContactTime < 0.0f || bHasReachedCeiling)
+	{
+		return -1.0f;
+	}
+
+	return FMath::Max(0.0f, PredictedCeilingContactTime - GetWorld()->GetTimeSeconds());
+}
+
 /**
  * @brief Gets the Ability System Component associated with the Player State.
  *
@@ -4,18 +4,25 @@
 #include "COPlayerState.h"
 #include "AbilitySystemComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "COStats.h"
+#include "COLog.h"
+
+DECLARE_CYCLE_STAT(TEXT("Controller Input Dispatch"), STAT_CO_ControllerInputDispatch, STATGROUP_CelestialOdyssey);
+DECLARE_CYCLE_STAT(TEXT("Controller Resolve Buffered Input"), STAT_CO_ControllerResolveBufferedInput, STATGROUP_CelestialOdyssey);
+DECLARE_CYCLE_STAT(TEXT("Controller Activate Ability From Slot"), STAT_CO_ControllerActivateAbilityFromSlot, STATGROUP_CelestialOdyssey);
+
+TRACE_DECLARE_FLOAT_COUNTER(AbilityInputToActivationLatency, TEXT("CelestialOdyssey/AbilityInputToActivationMs"));
 
 
 /**
  * @brief Default constructor for ACOPlayerController
- *
- * Initializes timing variables for ability activation tracking.
  */
 ACOPlayerController::ACOPlayerController()
 {
-	LastShoulderLeftPressTime = 0.0f;
-	LastShoulderRightPressTime = 0.0f;
-	bIsAbilityActivationPending = false;
 }
 
 /**
@@ -25,23 +32,48 @@ void ACOPlayerController::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// Benchmark runs drive the controller from a recording instead of devices
+	if (IsLocalController())
+	{
+		FString InputFilename;
+		if (FParse::Value(FCommandLine::Get(), TEXT("COInputPlayback="), InputFilename))
+		{
+			bQuitAfterPlayback = FParse::Param(FCommandLine::Get(), TEXT("COQuitAfterPlayback"));
+			StartInputPlayback(InputFilename);
+		}
+		else if (FParse::Value(FCommandLine::Get(), TEXT("COInputRecord="), InputFilename))
+		{
+			StartInputCapture(InputFilename);
+		}
+	}
+
 	if (!GeneralInputMappingContext)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("GeneralInputMappingContext is null!"));
+		UE_LOG(LogCelestialOdyssey, Warning, TEXT("GeneralInputMappingContext is null!"));
 		return;
 	}
 
 	if (UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(GetLocalPlayer()))
 	{
-		UE_LOG(LogTemp, Log, TEXT("Adding Input Mapping Context"));
+		UE_LOG(LogCelestialOdyssey, Log, TEXT("Adding Input Mapping Context"));
 		Subsystem->AddMappingContext(GeneralInputMappingContext, 0);
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Enhanced Input Local Player Subsystem not found!"));
+		UE_LOG(LogCelestialOdyssey, Warning, TEXT("Enhanced Input Local Player Subsystem not found!"));
 	}
 }
 
+/**
+ * Called when the controller leaves play; writes out an active input capture
+ */
+void ACOPlayerController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopInputCapture();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 /**
  * @brief Updates input mapping based on the current level.
  */
@@ -62,22 +94,213 @@ void ACOPlayerController::SetupInputComponent()
 
 	if (UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(InputComponent))
 	{
+		// Every action goes through DispatchInputAction so it can be captured and replayed
 		// Movement bindings
-		EnhancedInputComponent->BindAction(MoveRightAction, ETriggerEvent::Triggered, this, &ACOPlayerController::MoveRight);
-		EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Started, this, &ACOPlayerController::StartJump);
-		EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Completed, this, &ACOPlayerController::StopJump);
-		EnhancedInputComponent->BindAction(SprintAction, ETriggerEvent::Started, this, &ACOPlayerController::StartSprint);
-		EnhancedInputComponent->BindAction(SprintAction, ETriggerEvent::Completed, this, &ACOPlayerController::StopSprint);
-		EnhancedInputComponent->BindAction(CrouchOrGroundSlamAction, ETriggerEvent::Started, this, &ACOPlayerController::HandleGroundSlamOrCrouch);
-		EnhancedInputComponent->BindAction(CrouchOrGroundSlamAction, ETriggerEvent::Completed, this, &ACOPlayerController::StopCrouch);
+		BindRecordedAction(EnhancedInputComponent, MoveRightAction, ETriggerEvent::Triggered, ECOInputRecordAction::MoveRight);
+		BindRecordedAction(EnhancedInputComponent, JumpAction, ETriggerEvent::Started, ECOInputRecordAction::StartJump);
+		BindRecordedAction(EnhancedInputComponent, JumpAction, ETriggerEvent::Completed, ECOInputRecordAction::StopJump);
+		BindRecordedAction(EnhancedInputComponent, SprintAction, ETriggerEvent::Started, ECOInputRecordAction::StartSprint);
+		BindRecordedAction(EnhancedInputComponent, SprintAction, ETriggerEvent::Completed, ECOInputRecordAction::StopSprint);
+		BindRecordedAction(EnhancedInputComponent, CrouchOrGroundSlamAction, ETriggerEvent::Started, ECOInputRecordAction::CrouchOrGroundSlam);
+		BindRecordedAction(EnhancedInputComponent, CrouchOrGroundSlamAction, ETriggerEvent::Completed, ECOInputRecordAction::StopCrouch);
 
 		// Elemental ability bindings
-		EnhancedInputComponent->BindAction(GamepadShoulderLeftAction, ETriggerEvent::Started, this, &ACOPlayerController::HandlePrimaryAbility);
-		EnhancedInputComponent->BindAction(GamepadShoulderRightAction, ETriggerEvent::Started, this, &ACOPlayerController::HandleSecondaryAbility);
+		BindRecordedAction(EnhancedInputComponent, GamepadShoulderLeftAction, ETriggerEvent::Started, ECOInputRecordAction::PrimaryPressed);
+		BindRecordedAction(EnhancedInputComponent, GamepadShoulderRightAction, ETriggerEvent::Started, ECOInputRecordAction::SecondaryPressed);
+		BindRecordedAction(EnhancedInputComponent, GamepadShoulderLeftAction, ETriggerEvent::Completed, ECOInputRecordAction::PrimaryReleased);
+		BindRecordedAction(EnhancedInputComponent, GamepadShoulderRightAction, ETriggerEvent::Completed, ECOInputRecordAction::SecondaryReleased);
 
 		// Core abilities bindings
-		EnhancedInputComponent->BindAction(DashAction, ETriggerEvent::Triggered, this, &ACOPlayerController::ActivateDashAbilityWrapper);
-		EnhancedInputComponent->BindAction(CosmicStrikeAction, ETriggerEvent::Started, this, &ACOPlayerController::ActivateBasicAttackWrapper);
+		BindRecordedAction(EnhancedInputComponent, DashAction, ETriggerEvent::Triggered, ECOInputRecordAction::Dash);
+		BindRecordedAction(EnhancedInputComponent, CosmicStrikeAction, ETriggerEvent::Started, ECOInputRecordAction::BasicAttack);
+	}
+}
+
+/**
+ * @brief Binds an input action to DispatchInputAction, ignoring live input while a recording plays back.
+ */
+void ACOPlayerController::BindRecordedAction(UEnhancedInputComponent* EnhancedInputComponent, const UInputAction* Action, ETriggerEvent TriggerEvent, ECOInputRecordAction RecordAction)
+{
+	EnhancedInputComponent->BindActionValueLambda(Action, TriggerEvent, [this, RecordAction](const FInputActionValue& Value)
+	{
+		if (!bIsPlayingBackInput)
+		{
+			DispatchInputAction(RecordAction, Value);
+		}
+	});
+}
+
+/**
+ * @brief Records an input action when capturing and forwards it to its handler.
+ *
+ * @param Action Which bound action fired.
+ * @param Value The action value, live from Enhanced Input or rebuilt from a recording.
+ */
+void ACOPlayerController::DispatchInputAction(ECOInputRecordAction Action, const FInputActionValue& Value)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CO_ControllerInputDispatch);
+
+	if (bIsCapturingInput)
+	{
+		FCOInputRecord& Record = InputRecording.Records.AddDefaulted_GetRef();
+		Record.Frame = static_cast<uint32>(GFrameCounter - InputCaptureStartFrame);
+		Record.Time = static_cast<float>(GetWorld()->GetTimeSeconds() - InputCaptureStartTime);
+		Record.Action = Action;
+		Record.Value = Value.Get<float>();
+	}
+
+	switch (Action)
+	{
+	case ECOInputRecordAction::MoveRight:
+		MoveRight(Value);
+		break;
+	case ECOInputRecordAction::StartJump:
+		StartJump(Value);
+		break;
+	case ECOInputRecordAction::StopJump:
+		StopJump(Value);
+		break;
+	case ECOInputRecordAction::StartSprint:
+		StartSprint(Value);
+		break;
+	case ECOInputRecordAction::StopSprint:
+		StopSprint(Value);
+		break;
+	case ECOInputRecordAction::CrouchOrGroundSlam:
+		HandleGroundSlamOrCrouch(Value);
+		break;
+	case ECOInputRecordAction::StopCrouch:
+		StopCrouch(Value);
+		break;
+	case ECOInputRecordAction::PrimaryPressed:
+		HandlePrimaryAbility(Value);
+		break;
+	case ECOInputRecordAction::PrimaryReleased:
+		HandlePrimaryAbilityReleased(Value);
+		break;
+	case ECOInputRecordAction::SecondaryPressed:
+		HandleSecondaryAbility(Value);
+		break;
+	case ECOInputRecordAction::SecondaryReleased:
+		HandleSecondaryAbilityReleased(Value);
+		break;
+	case ECOInputRecordAction::Dash:
+		ActivateDashAbilityWrapper(Value);
+		break;
+	case ECOInputRecordAction::BasicAttack:
+		ActivateBasicAttackWrapper(Value);
+		break;
+	}
+}
+
+/**
+ * @brief Starts capturing input actions.
+ * @param Filename Where the recording is written when capture stops.
+ */
+void ACOPlayerController::StartInputCapture(const FString& Filename)
+{
+	InputRecording = FCOInputRecording();
+	InputCaptureFilename = Filename;
+	InputCaptureStartFrame = GFrameCounter;
+	InputCaptureStartTime = GetWorld()->GetTimeSeconds();
+	bIsCapturingInput = true;
+
+	UE_LOG(LogCelestialOdyssey, Log, TEXT("Capturing input to %s"), *FCOInputRecording::ResolvePath(Filename));
+}
+
+/**
+ * @brief Stops capturing and saves the recording.
+ *
+ * The replay timestep is the average frame time of the capture, so playback covers the same game time.
+ */
+void ACOPlayerController::StopInputCapture()
+{
+	if (!bIsCapturingInput)
+	{
+		return;
+	}
+	bIsCapturingInput = false;
+
+	const uint64 CapturedFrames = GFrameCounter - InputCaptureStartFrame;
+	if (CapturedFrames > 0)
+	{
+		InputRecording.FixedDeltaTime = static_cast<float>((GetWorld()->GetTimeSeconds() - InputCaptureStartTime) / CapturedFrames);
+	}
+	InputRecording.NumFrames = static_cast<uint32>(CapturedFrames);
+
+	if (!InputRecording.SaveToFile(InputCaptureFilename))
+	{
+		UE_LOG(LogCelestialOdyssey, Warning, TEXT("Failed to write input recording %s"), *FCOInputRecording::ResolvePath(InputCaptureFilename));
+	}
+}
+
+/**
+ * @brief Loads a recording and starts feeding it through the input handlers.
+ * @param Filename Recording to load.
+ * @return true if playback started.
+ */
+bool ACOPlayerController::StartInputPlayback(const FString& Filename)
+{
+	if (!InputRecording.LoadFromFile(Filename))
+	{
+		UE_LOG(LogCelestialOdyssey, Warning, TEXT("Failed to load input recording %s"), *FCOInputRecording::ResolvePath(Filename));
+		return false;
+	}
+
+	bIsCapturingInput = false;
+	bIsPlayingBackInput = true;
+	PlaybackRecordIndex = 0;
+	PlaybackFrame = 0;
+
+	// Frame-indexed replay is only reproducible when every frame advances the same amount of game time
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(InputRecording.FixedDeltaTime);
+
+#if CSV_PROFILER
+	FCsvProfiler::Get()->BeginCapture();
+#endif
+
+	UE_LOG(LogCelestialOdyssey, Log, TEXT("Playing back %d input actions from %s"), InputRecording.Records.Num(), *FCOInputRecording::ResolvePath(Filename));
+	return true;
+}
+
+/**
+ * @brief Dispatches every recorded action stamped with the current playback frame.
+ */
+void ACOPlayerController::PumpInputPlayback()
+{
+	const TArray<FCOInputRecord>& Records = InputRecording.Records;
+	while (PlaybackRecordIndex < Records.Num() && Records[PlaybackRecordIndex].Frame <= PlaybackFrame)
+	{
+		const FCOInputRecord& Record = Records[PlaybackRecordIndex++];
+		DispatchInputAction(Record.Action, FInputActionValue(Record.Value));
+	}
+
+	++PlaybackFrame;
+
+	if (PlaybackRecordIndex >= Records.Num() && PlaybackFrame >= InputRecording.NumFrames)
+	{
+		FinishInputPlayback();
+	}
+}
+
+/**
+ * @brief Stops playback, closes the CSV capture and quits when requested on the command line.
+ */
+void ACOPlayerController::FinishInputPlayback()
+{
+	bIsPlayingBackInput = false;
+	FApp::SetUseFixedTimeStep(false);
+
+#if CSV_PROFILER
+	FCsvProfiler::Get()->EndCapture();
+#endif
+
+	UE_LOG(LogCelestialOdyssey, Log, TEXT("Input playback finished after %u frames"), PlaybackFrame);
+
+	if (bQuitAfterPlayback)
+	{
+		FPlatformMisc::RequestExit(false, TEXT("ACOPlayerController::FinishInputPlayback"));
 	}
 }
 
@@ -205,36 +428,6 @@ void ACOPlayerController::StopSprint(const FInputActionValue& Value)
 	}
 }
 
-/**
- * @brief Checks if both gamepad shoulder buttons are pressed to activate Gravity Shift.
- * @return true if Gravity Shift was activated, false otherwise
- */
-bool ACOPlayerController::CheckForGravityShift()
-{
-	if (bGamepadShoulderLeftPressed && bGamepadShoulderRightPressed)
-	{
-		// Activate Gravity Shift using the ability slot system
-		ActivateAbilityFromSlot(ECOAbilitySlot::ComboAbility, FInputActionValue());
-
-		// Reset both button states
-		ResetShoulderButtonStates();
-		return true;
-	}
-	return false;
-}
-
-/**
- * @brief Resets all button states and pending ability flags
- *
- * Called after ability activation to clean up all state tracking variables.
- */
-void ACOPlayerController::ResetShoulderButtonStates()
-{
-	bGamepadShoulderLeftPressed = false;
-	bGamepadShoulderRightPressed = false;
-	bIsAbilityActivationPending = false;
-}
-
 /**
  * @brief Activates an ability from a specific slot
  * @param Slot The slot containing the ability to activate
@@ -242,6 +435,8 @@ void ACOPlayerController::ResetShoulderButtonStates()
  */
 void ACOPlayerController::ActivateAbilityFromSlot(ECOAbilitySlot Slot, const FInputActionValue& Value)
 {
+	SCOPE_CYCLE_COUNTER(STAT_CO_ControllerActivateAbilityFromSlot);
+
 	if (APawn* ControlledPawn = GetPawn())
 	{
 		if (ACOPlayerCharacter* PlayerCharacter = Cast<ACOPlayerCharacter>(ControlledPawn))
@@ -251,11 +446,12 @@ void ACOPlayerController::ActivateAbilityFromSlot(ECOAbilitySlot Slot, const FIn
 				ACOPlayerState* COPlayerState = GetPlayerState<ACOPlayerState>();
 				if (COPlayerState)
 				{
-					// Get the ability for this slot 
-					if (TSubclassOf<UGameplayAbility> AbilityClass = COPlayerState->GetAbilityForSlot(Slot))
+					// The player state keeps one granted spec handle per slot, so no class lookup or spec walk is needed
+					const FGameplayAbilitySpecHandle Handle = COPlayerState->GetAbilityHandleForSlot(Slot);
+					if (Handle.IsValid())
 					{
-						ASC->TryActivateAbilityByClass(AbilityClass);
-						UE_LOG(LogTemp, Log, TEXT("Activating ability from slot: %d"), static_cast<int32>(Slot));
+						ASC->TryActivateAbility(Handle);
+						CO_ABILITY_TRACE(TEXT("Activating ability from slot: %d"), static_cast<int32>(Slot));
 					}
 				}
 			}
@@ -266,81 +462,44 @@ void ACOPlayerController::ActivateAbilityFromSlot(ECOAbilitySlot Slot, const FIn
 /**
  * @brief Handles the primary ability input (Q/L1)
  *
- * Processes primary ability (Vine Whip) input and checks for potential
- * combo activation with secondary ability input. If both inputs occur within
- * the combo window, activates Gravity Shift instead.
+ * The press is only buffered here; ResolveBufferedInput decides later in the same frame
+ * whether it becomes Vine Whip or part of the Gravity Shift combo.
  *
  * @param Value The input value from Enhanced Input
  */
 void ACOPlayerController::HandlePrimaryAbility(const FInputActionValue& Value)
 {
-	float CurrentTime = GetWorld()->GetTimeSeconds();
-	bGamepadShoulderLeftPressed = true;
-	LastShoulderLeftPressTime = CurrentTime;
+	BufferInput(ECOBufferedInputAction::PrimaryPressed);
+}
 
-	// Check for simultaneous press first
-	if (CheckForSimultaneousPress())
-	{
-		// Activate Gravity Shift
-		ActivateAbilityFromSlot(ECOAbilitySlot::ComboAbility, Value);
-		ResetShoulderButtonStates();
-	}
-	else
-	{
-		// Store the primary ability as pending
-		bIsAbilityActivationPending = true;
-		PendingAbilitySlot = ECOAbilitySlot::PrimaryAbility;
-
-		// Set a timer to activate the ability if no combo is detected
-		FTimerHandle TimerHandle;
-		GetWorld()->GetTimerManager().SetTimer(
-			TimerHandle,
-			this,
-			&ACOPlayerController::ProcessPendingAbility,
-			ComboTimeWindow,
-			false
-		);
-	}
+/**
+ * @brief Handles the primary ability release (Q/L1)
+ * @param Value The input value from Enhanced Input
+ */
+void ACOPlayerController::HandlePrimaryAbilityReleased(const FInputActionValue& Value)
+{
+	BufferInput(ECOBufferedInputAction::PrimaryReleased);
 }
 
 /**
  * @brief Handles the secondary ability input (R/R1)
  *
- * Processes secondary ability (Lunar Forest Fury) input and checks for potential
- * combo activation with primary ability input. If both inputs occur within
- * the combo window, activates Gravity Shift instead.
+ * Buffered like the primary input; resolves to Lunar Forest Fury or the Gravity Shift combo.
  *
  * @param Value The input value from Enhanced Input
  */
 void ACOPlayerController::HandleSecondaryAbility(const FInputActionValue& Value)
 {
-	float CurrentTime = GetWorld()->GetTimeSeconds();
-	bGamepadShoulderRightPressed = true;
-	LastShoulderRightPressTime = CurrentTime;
+	BufferInput(ECOBufferedInputAction::SecondaryPressed);
+}
 
-	// Check for simultaneous press first
-	if (CheckForSimultaneousPress())
-	{
-		// Activate Gravity Shift
-		ActivateAbilityFromSlot(ECOAbilitySlot::ComboAbility, Value);
-		ResetShoulderButtonStates();
-	}
-	else
-	{
-		// Store the secondary ability as pending
-		bIsAbilityActivationPending = true;
-		PendingAbilitySlot = ECOAbilitySlot::SecondaryAbility;
-
-		// Set a timer to activate the ability if no combo is detected
-		FTimerHandle TimerHandle;
-		GetWorld()->GetTimerManager().SetTimer(
-			TimerHandle,
-			this,
-			&ACOPlayerController::ProcessPendingAbility,
-			ComboTimeWindow,
-			false
-		);
-	}
+/**
+ * @brief Handles the secondary ability release (R/R1)
+ * @param Value The input value from Enhanced Input
+ */
+void ACOPlayerController::HandleSecondaryAbilityReleased(const FInputActionValue& Value)
+{
+	BufferInput(ECOBufferedInputAction::SecondaryReleased);
 }
 
 /**
@@ -352,43 +511,142 @@ void ACOPlayerController::HandleComboAbility(const FInputActionValue& Value)
 }
 
 /**
- * @brief Checks if both ability buttons were pressed simultaneously
- *
- * Determines if both the primary and secondary ability buttons were pressed
- * within the defined combo time window (ComboTimeWindow seconds).
- *
- * @return true if both buttons were pressed within the time window, false otherwise
+ * @brief Appends an input to the history ring buffer.
+ * @param Action The shoulder-button transition that was received.
  */
-bool ACOPlayerController::CheckForSimultaneousPress()
+void ACOPlayerController::BufferInput(ECOBufferedInputAction Action)
 {
-	float CurrentTime = GetWorld()->GetTimeSeconds();
+	FCOBufferedInput& Entry = InputHistory[NumBufferedInputs % InputHistoryCapacity];
+	Entry.Action = Action;
+	Entry.Frame = GFrameCounter;
+	Entry.WorldTime = GetWorld()->GetTimeSeconds();
+	Entry.PlatformTime = FPlatformTime::Seconds();
+	++NumBufferedInputs;
+
+	// Drop unresolved entries that have just been overwritten
+	if (NumBufferedInputs - NumResolvedInputs > static_cast<uint32>(InputHistoryCapacity))
+	{
+		NumResolvedInputs = NumBufferedInputs - InputHistoryCapacity;
+	}
+}
 
-	// Check if both buttons are pressed within the combo time window
-	if (bGamepadShoulderLeftPressed && bGamepadShoulderRightPressed)
+/**
+ * @brief Resolves buffered input once per frame, after Enhanced Input has dispatched this frame's actions.
+ */
+void ACOPlayerController::PlayerTick(float DeltaTime)
+{
+	// Recorded actions replace device input, so they are dispatched before this frame's input processing
+	if (bIsPlayingBackInput)
 	{
-		float TimeDifference = FMath::Abs(LastShoulderLeftPressTime - LastShoulderRightPressTime);
-		return TimeDifference <= ComboTimeWindow;
+		PumpInputPlayback();
 	}
 
-	return false;
+	Super::PlayerTick(DeltaTime);
+
+	ResolveBufferedInput();
 }
 
 /**
- * @brief Processes any pending ability activation
- *
- * Called after the combo time window expires. If an ability is pending
- * and no combo was detected, activates the pending ability.
+ * @brief Turns the buffered shoulder-button history into ability activations.
  */
-void ACOPlayerController::ProcessPendingAbility()
+void ACOPlayerController::ResolveBufferedInput()
 {
-	if (bIsAbilityActivationPending)
+	SCOPE_CYCLE_COUNTER(STAT_CO_ControllerResolveBufferedInput);
+
+	for (; NumResolvedInputs != NumBufferedInputs; ++NumResolvedInputs)
 	{
-		// Only activate the pending ability if a combo was not triggered
-		if (!CheckForSimultaneousPress())
+		const FCOBufferedInput& Input = InputHistory[NumResolvedInputs % InputHistoryCapacity];
+
+		const bool bPrimary = Input.Action == ECOBufferedInputAction::PrimaryPressed || Input.Action == ECOBufferedInputAction::PrimaryReleased;
+		const ECOAbilitySlot Slot = bPrimary ? ECOAbilitySlot::PrimaryAbility : ECOAbilitySlot::SecondaryAbility;
+		const ECOBufferedInputAction PendingPressAction = bPrimary ? ECOBufferedInputAction::PrimaryPressed : ECOBufferedInputAction::SecondaryPressed;
+
+		switch (Input.Action)
 		{
-			ActivateAbilityFromSlot(PendingAbilitySlot, FInputActionValue());
+		case ECOBufferedInputAction::PrimaryPressed:
+		case ECOBufferedInputAction::SecondaryPressed:
+			if (PendingPress.IsSet() && PendingPress->Action != Input.Action
+				&& Input.WorldTime - PendingPress->WorldTime <= ComboTimeWindow)
+			{
+				// Second button of the chord arrived in time: Gravity Shift
+				PendingPress.Reset();
+				ActivateBufferedAbility(ECOAbilitySlot::ComboAbility, Input);
+			}
+			else
+			{
+				// Pressing the same button again (or too late) rules out the chord for the earlier press
+				if (PendingPress.IsSet())
+				{
+					const FCOBufferedInput EarlierPress = PendingPress.GetValue();
+					PendingPress.Reset();
+					ActivateBufferedAbility(EarlierPress.Action == ECOBufferedInputAction::PrimaryPressed ? ECOAbilitySlot::PrimaryAbility : ECOAbilitySlot::SecondaryAbility, EarlierPress);
+				}
+				PendingPress = Input;
+			}
+			break;
+
+		case ECOBufferedInputAction::PrimaryReleased:
+		case ECOBufferedInputAction::SecondaryReleased:
+			// Releasing the waiting button means the chord can no longer happen
+			if (PendingPress.IsSet() && PendingPress->Action == PendingPressAction)
+			{
+				const FCOBufferedInput Press = PendingPress.GetValue();
+				PendingPress.Reset();
+				ActivateBufferedAbility(Slot, Press);
+			}
+			break;
 		}
+	}
 
-		bIsAbilityActivationPending = false;
+	// The window ran out without the other button
+	if (PendingPress.IsSet() && GetWorld()->GetTimeSeconds() - PendingPress->WorldTime > ComboTimeWindow)
+	{
+		const FCOBufferedInput Press = PendingPress.GetValue();
+		PendingPress.Reset();
+		ActivateBufferedAbility(Press.Action == ECOBufferedInputAction::PrimaryPressed ? ECOAbilitySlot::PrimaryAbility : ECOAbilitySlot::SecondaryAbility, Press);
 	}
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Activates a slot for a buffered input and records how long the input waited.
+ * @param Slot The slot to activate.
+ * @param SourceInput The input that caused the activation.
+ */
+void ACOPlayerController::ActivateBufferedAbility(ECOAbilitySlot Slot, const FCOBufferedInput& SourceInput)
+{
+	ActivateAbilityFromSlot(Slot, FInputActionValue());
+
+	const float LatencyMs = static_cast<float>((FPlatformTime::Seconds() - SourceInput.PlatformTime) * 1000.0);
+	LatencySamplesMs[NumLatencySamples % LatencySampleCapacity] = LatencyMs;
+	++NumLatencySamples;
+
+	TRACE_COUNTER_SET(AbilityInputToActivationLatency, LatencyMs);
+}
+
+/**
+ * @brief Computes average and 99th percentile input-to-activation latency over the recent samples.
+ */
+int32 ACOPlayerController::GetInputLatencyStats(float& OutAverageMs, float& OutP99Ms) const
+{
+	const int32 NumSamples = static_cast<int32>(FMath::Min<uint32>(NumLatencySamples, LatencySampleCapacity));
+	OutAverageMs = 0.0f;
+	OutP99Ms = 0.0f;
+	if (NumSamples == 0)
+	{
+		return 0;
+	}
+
+	TArray<float, TInlineAllocator<LatencySampleCapacity>> Sorted;
+	Sorted.Append(LatencySamplesMs.GetData(), NumSamples);
+	Sorted.Sort();
+
+	float Sum = 0.0f;
+	for (float Sample : Sorted)
+	{
+		Sum += Sample;
+	}
+
+	OutAverageMs = Sum / NumSamples;
+	OutP99Ms = Sorted[FMath::Min(NumSamples - 1, FMath::CeilToInt(0.99f * NumSamples) - 1)];
+	return NumSamples;
+}
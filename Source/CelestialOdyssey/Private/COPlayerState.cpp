@@ -1,5 +1,23 @@
 #include "COPlayerState.h"
 #include "AbilityInputEnum.h"
+#include "COStats.h"
+#include "COLog.h"
+#include "COLevelAbilitySet.h"
+#include "Engine/AssetManager.h"
+
+namespace
+{
+    /** One ability the current level mapping wants granted, with its input binding and slot */
+    struct FCOAbilityGrant
+    {
+        TSubclassOf<UGameplayAbility> AbilityClass;
+        int32 InputID;
+        ECOAbilitySlot Slot;
+
+        /** Spec this player state already granted for AbilityClass, found while pruning */
+        FGameplayAbilitySpecHandle GrantedHandle;
+    };
+}
 
 /**
  * @brief Constructs an instance of ACOPlayerState.
@@ -33,12 +51,6 @@ void ACOPlayerState::BeginPlay()
 
     // Toggle this comment to test Crystal Cave abilities
     // SetCurrentLevel(ECOGameLevel::CrystallineCaves);
-
-    // Update abilities based on starting level (if set)
-    if (CurrentLevel != ECOGameLevel::None)
-    {
-        UpdateAvailableAbilities();
-    }
 }
 
 /**
@@ -69,7 +81,7 @@ void ACOPlayerState::SetCurrentInputComboState(EInputComboState NewState)
 {
     if (CurrentInputComboState != NewState)
     {
-        UE_LOG(LogTemp, Log, TEXT("Changing input combo state from %d to %d"),
+        CO_ABILITY_TRACE(TEXT("Changing input combo state from %d to %d"),
             (uint8)CurrentInputComboState, (uint8)NewState);
     }
     CurrentInputComboState = NewState;
@@ -84,10 +96,134 @@ void ACOPlayerState::SetCurrentLevel(ECOGameLevel NewLevel)
     if (CurrentLevel != NewLevel)
     {
         CurrentLevel = NewLevel;
+        ReleaseUnusedLevelAbilitySets();
+        RequestLevelAbilitySet(CurrentLevel);
+        UpdateAvailableAbilities();
+
+        // Warm up the following level while this one plays
+        PreloadLevelAbilities(GetNextGameLevel(CurrentLevel));
+    }
+}
+
+/**
+ * @brief Starts loading a level's ability set in the background.
+ * @param Level The level whose abilities should be made resident.
+ */
+void ACOPlayerState::PreloadLevelAbilities(ECOGameLevel Level)
+{
+    RequestLevelAbilitySet(Level);
+}
+
+/**
+ * @brief Requests the "Abilities" bundle of a level's ability set from the Asset Manager.
+ * @param Level The level to load.
+ */
+void ACOPlayerState::RequestLevelAbilitySet(ECOGameLevel Level)
+{
+    const FPrimaryAssetId* AssetId = LevelAbilitySets.Find(Level);
+    if (!AssetId || !AssetId->IsValid() || LevelAbilitySetHandles.Contains(Level))
+    {
+        return;
+    }
+
+    const TArray<FName> Bundles = { UCOLevelAbilitySet::AbilitiesBundle };
+    TSharedPtr<FStreamableHandle> Handle = UAssetManager::Get().LoadPrimaryAsset(*AssetId, Bundles,
+        FStreamableDelegate::CreateUObject(this, &ACOPlayerState::OnLevelAbilitySetLoaded, Level));
+
+    // A null handle means nothing had to be loaded; the delegate is still called
+    LevelAbilitySetHandles.Add(Level, Handle);
+}
+
+/**
+ * @brief Resolves a loaded ability set into a hard mapping.
+ * @param Level The level whose set finished loading.
+ */
+void ACOPlayerState::OnLevelAbilitySetLoaded(ECOGameLevel Level)
+{
+    const FPrimaryAssetId* AssetId = LevelAbilitySets.Find(Level);
+    const UCOLevelAbilitySet* AbilitySet = AssetId ? UAssetManager::Get().GetPrimaryAssetObject<UCOLevelAbilitySet>(*AssetId) : nullptr;
+    if (!AbilitySet)
+    {
+        UE_LOG(LogCelestialOdyssey, Warning, TEXT("Ability set for level %d failed to load"), static_cast<int32>(Level));
+        return;
+    }
+
+    AbilitySet->ResolveMapping(LoadedAbilityMappings.FindOrAdd(Level));
+
+    if (Level == CurrentLevel)
+    {
         UpdateAvailableAbilities();
     }
 }
 
+/**
+ * @brief Drops every level ability set except the current and the next level's, so they can be garbage collected.
+ */
+void ACOPlayerState::ReleaseUnusedLevelAbilitySets()
+{
+    const ECOGameLevel NextLevel = GetNextGameLevel(CurrentLevel);
+
+    for (auto It = LevelAbilitySetHandles.CreateIterator(); It; ++It)
+    {
+        const ECOGameLevel Level = It.Key();
+        if (Level == CurrentLevel || Level == NextLevel)
+        {
+            continue;
+        }
+
+        if (It.Value().IsValid())
+        {
+            It.Value()->CancelHandle();
+        }
+        if (const FPrimaryAssetId* AssetId = LevelAbilitySets.Find(Level))
+        {
+            UAssetManager::Get().UnloadPrimaryAsset(*AssetId);
+        }
+
+        LoadedAbilityMappings.Remove(Level);
+        It.RemoveCurrent();
+    }
+}
+
+/**
+ * @brief Returns the ability mapping for a level.
+ * @param Level The level to look up.
+ * @return The mapping resolved from the level's ability set if loaded, otherwise the inline mapping, or nullptr.
+ */
+const FCOLevelAbilityMapping* ACOPlayerState::FindAbilityMapping(ECOGameLevel Level) const
+{
+    if (const FCOLevelAbilityMapping* LoadedMapping = LoadedAbilityMappings.Find(Level))
+    {
+        return LoadedMapping;
+    }
+
+    return LevelAbilityMappings.Find(Level);
+}
+
+/**
+ * @brief Finds the core ability a legacy slot property refers to.
+ *
+ * The mapping's classes are already loaded, so comparing paths identifies the ability without loading the
+ * soft pointer.
+ */
+TSubclassOf<UGameplayAbility> ACOPlayerState::FindCoreAbility(const FCOLevelAbilityMapping& Mapping, const TSoftClassPtr<UGameplayAbility>& SlotAbilityClass)
+{
+    if (SlotAbilityClass.IsNull())
+    {
+        return nullptr;
+    }
+
+    const FSoftObjectPath& SlotPath = SlotAbilityClass.ToSoftObjectPath();
+    for (const TSubclassOf<UGameplayAbility>& CoreAbility : Mapping.CoreAbilities)
+    {
+        if (CoreAbility && FSoftObjectPath(CoreAbility.Get()) == SlotPath)
+        {
+            return CoreAbility;
+        }
+    }
+    return nullptr;
+}
+
 /**
  * @brief Gets the ability assigned to a specific slot for the current level.
  * @param Slot The ability slot to query.
@@ -95,7 +231,7 @@ void ACOPlayerState::SetCurrentLevel(ECOGameLevel NewLevel)
  */
 TSubclassOf<UGameplayAbility> ACOPlayerState::GetAbilityForSlot(ECOAbilitySlot Slot) const
 {
-    if (const FCOLevelAbilityMapping* Mapping = LevelAbilityMappings.Find(CurrentLevel))
+    if (const FCOLevelAbilityMapping* Mapping = FindAbilityMapping(CurrentLevel))
     {
         switch (Slot)
         {
@@ -106,14 +242,11 @@ TSubclassOf<UGameplayAbility> ACOPlayerState::GetAbilityForSlot(ECOAbilitySlot S
         case ECOAbilitySlot::ComboAbility:
             return Mapping->ComboAbility;
         case ECOAbilitySlot::DashAbility:
-            return Mapping->CoreAbilities.Contains(CelestialDashAbilityClass) ?
-                CelestialDashAbilityClass : nullptr;
+            return FindCoreAbility(*Mapping, CelestialDashAbilityClass);
         case ECOAbilitySlot::GroundSlamAbility:
-            return Mapping->CoreAbilities.Contains(GroundSlamAbilityClass) ?
-                GroundSlamAbilityClass : nullptr;
+            return FindCoreAbility(*Mapping, GroundSlamAbilityClass);
         case ECOAbilitySlot::BasicAttack:
-            return Mapping->CoreAbilities.Contains(CosmicStrikeAbilityClass) ?
-                CosmicStrikeAbilityClass : nullptr;
+            return FindCoreAbility(*Mapping, CosmicStrikeAbilityClass);
         default:
             return nullptr;
         }
@@ -123,78 +256,124 @@ TSubclassOf<UGameplayAbility> ACOPlayerState::GetAbilityForSlot(ECOAbilitySlot S
 
 /**
  * @brief Updates available abilities based on current level.
+ *
+ * Only the difference to the previous level is applied: abilities this player state granted that the new
+ * mapping no longer contains are cleared, missing ones are granted, and the rest keep their spec, ability
+ * instance and cooldown state. Abilities granted by other sources are left alone.
  */
 void ACOPlayerState::UpdateAvailableAbilities()
 {
+    SCOPE_CYCLE_COUNTER(STAT_CO_UpdateAvailableAbilities);
+
     if (!AbilitySystemComponent || CurrentLevel == ECOGameLevel::None)
     {
         return;
     }
 
-    // Remove existing abilities
-    AbilitySystemComponent->ClearAllAbilities();
-
-    // Get ability mapping for current level
-    if (const FCOLevelAbilityMapping* Mapping = LevelAbilityMappings.Find(CurrentLevel))
+    // Build the set of abilities the current level should have
+    TArray<FCOAbilityGrant, TInlineAllocator<8>> DesiredGrants;
+    if (const FCOLevelAbilityMapping* Mapping = FindAbilityMapping(CurrentLevel))
     {
-        // Grant primary ability
+        const TSubclassOf<UGameplayAbility> DashAbility = FindCoreAbility(*Mapping, CelestialDashAbilityClass);
+        const TSubclassOf<UGameplayAbility> GroundSlamAbility = FindCoreAbility(*Mapping, GroundSlamAbilityClass);
+        const TSubclassOf<UGameplayAbility> CosmicStrikeAbility = FindCoreAbility(*Mapping, CosmicStrikeAbilityClass);
+
         if (Mapping->PrimaryAbility)
         {
-            AbilitySystemComponent->GiveAbility(
-                FGameplayAbilitySpec(Mapping->PrimaryAbility, 1,
-                    static_cast<int32>(EAbilityInput::VineWhip)));  // Adjust input binding as needed
+            DesiredGrants.Add({ Mapping->PrimaryAbility, static_cast<int32>(EAbilityInput::VineWhip), ECOAbilitySlot::PrimaryAbility });  // Adjust input binding as needed
         }
 
-        // Grant secondary ability
         if (Mapping->SecondaryAbility)
         {
-            AbilitySystemComponent->GiveAbility(
-                FGameplayAbilitySpec(Mapping->SecondaryAbility, 1,
-                    static_cast<int32>(EAbilityInput::LunarForestFury)));  // Adjust input binding as needed
+            DesiredGrants.Add({ Mapping->SecondaryAbility, static_cast<int32>(EAbilityInput::LunarForestFury), ECOAbilitySlot::SecondaryAbility });  // Adjust input binding as needed
         }
 
-        // Grant combo ability
         if (Mapping->ComboAbility)
         {
-            AbilitySystemComponent->GiveAbility(
-                FGameplayAbilitySpec(Mapping->ComboAbility, 1,
-                    static_cast<int32>(EAbilityInput::GravityShift)));
+            DesiredGrants.Add({ Mapping->ComboAbility, static_cast<int32>(EAbilityInput::GravityShift), ECOAbilitySlot::ComboAbility });
         }
 
-        // Grant core abilities
         for (const auto& CoreAbility : Mapping->CoreAbilities)
         {
             if (CoreAbility)
             {
-                int32 InputID = 0;
-                // Determine proper input binding based on ability type
-                if (CoreAbility == CelestialDashAbilityClass)
-                    InputID = static_cast<int32>(EAbilityInput::CelestialDash);
-                else if (CoreAbility == GroundSlamAbilityClass)
-                    InputID = static_cast<int32>(EAbilityInput::GroundSlam);
-                else if (CoreAbility == CosmicStrikeAbilityClass)
-                    InputID = static_cast<int32>(EAbilityInput::CosmicStrike);
-
-                AbilitySystemComponent->GiveAbility(
-                    FGameplayAbilitySpec(CoreAbility, 1, InputID));
+                FCOAbilityGrant Grant{ CoreAbility, 0, ECOAbilitySlot::None };
+                // Determine proper input binding and slot based on ability type
+                if (CoreAbility == DashAbility)
+                {
+                    Grant.InputID = static_cast<int32>(EAbilityInput::CelestialDash);
+                    Grant.Slot = ECOAbilitySlot::DashAbility;
+                }
+                else if (CoreAbility == GroundSlamAbility)
+                {
+                    Grant.InputID = static_cast<int32>(EAbilityInput::GroundSlam);
+                    Grant.Slot = ECOAbilitySlot::GroundSlamAbility;
+                }
+                else if (CoreAbility == CosmicStrikeAbility)
+                {
+                    Grant.InputID = static_cast<int32>(EAbilityInput::CosmicStrike);
+                    Grant.Slot = ECOAbilitySlot::BasicAttack;
+                }
+                DesiredGrants.Add(Grant);
             }
         }
     }
 
+    // Remove abilities that left the mapping, and rebind those that only moved to another input
+    TArray<FGameplayAbilitySpecHandle, TInlineAllocator<8>> HandlesToRemove;
+    for (FGameplayAbilitySpec& Spec : AbilitySystemComponent->GetActivatableAbilities())
+    {
+        if (Spec.SourceObject.Get() != this)
+        {
+            continue;
+        }
+
+        FCOAbilityGrant* Grant = DesiredGrants.FindByPredicate([&Spec](const FCOAbilityGrant& Candidate)
+        {
+            return Candidate.AbilityClass == Spec.Ability->GetClass();
+        });
+
+        // Duplicates of an ability we already matched are pruned as well
+        if (!Grant || Grant->GrantedHandle.IsValid())
+        {
+            HandlesToRemove.Add(Spec.Handle);
+            continue;
+        }
+
+        Grant->GrantedHandle = Spec.Handle;
+        if (Spec.InputID != Grant->InputID)
+        {
+            Spec.InputID = Grant->InputID;
+            AbilitySystemComponent->MarkAbilitySpecDirty(Spec);
+        }
+    }
+
+    for (const FGameplayAbilitySpecHandle& Handle : HandlesToRemove)
+    {
+        AbilitySystemComponent->ClearAbility(Handle);
+    }
+    INC_DWORD_STAT_BY(STAT_CO_AbilitiesRemoved, HandlesToRemove.Num());
+
+    // Grant what is missing and rebuild the slot table
+    for (FGameplayAbilitySpecHandle& SlotHandle : SlotAbilityHandles)
+    {
+        SlotHandle = FGameplayAbilitySpecHandle();
+    }
 
-    if (const FCOLevelAbilityMapping* Mapping = LevelAbilityMappings.Find(CurrentLevel))
+    for (const FCOAbilityGrant& Grant : DesiredGrants)
     {
-        // When granting abilities, add debug output
-        if (Mapping->PrimaryAbility)
+        // Specs of the same class granted by items or effects belong to their own source and are left alone
+        FGameplayAbilitySpecHandle Handle = Grant.GrantedHandle;
+        if (!Handle.IsValid())
         {
-            UE_LOG(LogTemp, Log, TEXT("Granting Primary Ability: %s"),
-                *Mapping->PrimaryAbility->GetName());
+            Handle = AbilitySystemComponent->GiveAbility(FGameplayAbilitySpec(Grant.AbilityClass, 1, Grant.InputID, this));
+            INC_DWORD_STAT(STAT_CO_AbilitiesGranted);
+            UE_LOG(LogCelestialOdyssey, Log, TEXT("Granting Ability: %s"), *Grant.AbilityClass->GetName());
         }
 
-        if (Mapping->SecondaryAbility)
+        if (Grant.Slot != ECOAbilitySlot::None)
         {
-            UE_LOG(LogTemp, Log, TEXT("Granting Secondary Ability: %s"),
-                *Mapping->SecondaryAbility->GetName());
+            SlotAbilityHandles[static_cast<int32>(Grant.Slot)] = Handle;
         }
     }
-}
\ No newline at end of file
+}
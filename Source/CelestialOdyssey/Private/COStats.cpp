@@ -0,0 +1,5 @@
+#include "COStats.h"
+
+DEFINE_STAT(STAT_CO_UpdateAvailableAbilities);
+DEFINE_STAT(STAT_CO_AbilitiesGranted);
+DEFINE_STAT(STAT_CO_AbilitiesRemoved);
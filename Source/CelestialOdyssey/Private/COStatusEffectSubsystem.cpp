@@ -0,0 +1,498 @@
+#include "COStatusEffectSubsystem.h"
+#include "COGameplayTags.h"
+#include "COLog.h"
+#include "COStats.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+
+DECLARE_CYCLE_STAT(TEXT("Status Effects Tick"), STAT_CO_StatusEffectsTick, STATGROUP_CelestialOdyssey);
+DECLARE_CYCLE_STAT(TEXT("Status Effects Flush"), STAT_CO_StatusEffectsFlush, STATGROUP_CelestialOdyssey);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Statuses"), STAT_CO_ActiveStatuses, STATGROUP_CelestialOdyssey);
+
+void UCOStatusEffectSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // Slows, roots and stuns expire from the wheel
+    Collection.InitializeDependency<UCOExpirySubsystem>();
+}
+
+/**
+ * @brief Drops every status when the world is torn down. Targets go with the world, so nothing is written back.
+ */
+void UCOStatusEffectSubsystem::Deinitialize()
+{
+    for (FCOStatusList& List : Statuses)
+    {
+        List = FCOStatusList();
+    }
+
+    Targets.Empty();
+    FreeTargetSlots.Empty();
+    TargetSlotsByComponent.Empty();
+
+    Super::Deinitialize();
+}
+
+TStatId UCOStatusEffectSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCOStatusEffectSubsystem, STATGROUP_Tickables);
+}
+
+bool UCOStatusEffectSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FGameplayTag UCOStatusEffectSubsystem::GetStatusTag(ECOStatusType Type)
+{
+    switch (Type)
+    {
+    case ECOStatusType::Root:
+        return COGameplayTags::State_CC_Rooted;
+    case ECOStatusType::Stun:
+        return COGameplayTags::State_CC_Stunned;
+    default:
+        return FGameplayTag();
+    }
+}
+
+bool UCOStatusEffectSubsystem::ReadDamageOverTime(const FGameplayEffectSpec& Spec, FCODamageOverTime& OutDamageOverTime)
+{
+    OutDamageOverTime = FCODamageOverTime();
+
+    const UGameplayEffect* Definition = Spec.Def;
+    const float Period = Spec.GetPeriod();
+    if (!Definition || Definition->DurationPolicy == EGameplayEffectDurationType::Instant || Period <= 0.0f)
+    {
+        return false;
+    }
+
+    const FGameplayAttribute Attribute = UCODamageAccumulatorSubsystem::FindPlainHealthAttribute(Definition);
+    if (!Attribute.IsValid())
+    {
+        return false;
+    }
+
+    float Amount = 0.0f;
+    for (const FGameplayModifierInfo& Modifier : Definition->Modifiers)
+    {
+        float Magnitude = 0.0f;
+        if (!Modifier.ModifierMagnitude.AttemptCalculateMagnitude(Spec, Magnitude))
+        {
+            return false;
+        }
+        Amount += Magnitude;
+    }
+
+    // Damage is authored as a negative Health modifier
+    if (Amount >= 0.0f)
+    {
+        return false;
+    }
+
+    OutDamageOverTime.DamagePerPeriod = -Amount;
+    OutDamageOverTime.Period = Period;
+    OutDamageOverTime.bDamageOnApplication = Definition->bExecutePeriodicEffectOnApplication;
+    OutDamageOverTime.Attribute = Attribute;
+    return true;
+}
+
+/**
+ * @brief Reads the status once and shares it between all targets.
+ *
+ * Only a status with a finite duration can be timed here; an instant or infinite spec without an explicit
+ * duration is left to GAS, as is a DoT whose effect is not a periodic plain health drain.
+ */
+void UCOStatusEffectSubsystem::ApplyStatus(ECOStatusType Type, const FGameplayEffectSpec& Spec, TConstArrayView<UAbilitySystemComponent*> TargetsToAfflict, float Duration)
+{
+    if (!Spec.Def)
+    {
+        return;
+    }
+
+    const float StatusDuration = Duration > 0.0f ? Duration : Spec.GetDuration();
+
+    FCODamageOverTime DamageOverTime;
+    const bool bNativeDamage = Type == ECOStatusType::DamageOverTime && ReadDamageOverTime(Spec, DamageOverTime);
+
+    if (StatusDuration <= 0.0f || (Type == ECOStatusType::DamageOverTime && !bNativeDamage))
+    {
+        UCODamageAccumulatorSubsystem::ApplySpecDirectly(Spec, TargetsToAfflict);
+        return;
+    }
+
+    if (bNativeDamage)
+    {
+        // No active effect exists; listeners see the damage land when the accumulator applies it
+        const FCODamageSource Source = FCODamageSource::FromSpec(Spec);
+        for (UAbilitySystemComponent* Target : TargetsToAfflict)
+        {
+            AddDamageOverTime(Target, DamageOverTime, StatusDuration, Source);
+        }
+        return;
+    }
+
+    // Only an effect that stays active can grant the status tag
+    const bool bInstant = Spec.Def->DurationPolicy == EGameplayEffectDurationType::Instant;
+    const FGameplayTag StatusTag = GetStatusTag(Type);
+    if (bInstant && StatusTag.IsValid())
+    {
+        UE_LOG(LogCelestialOdyssey, Warning, TEXT("Instant effect %s cannot hold %s; applied as a regular gameplay effect"), *GetNameSafe(Spec.Def), *StatusTag.ToString());
+        UCODamageAccumulatorSubsystem::ApplySpecDirectly(Spec, TargetsToAfflict);
+        return;
+    }
+
+    // GAS would start a duration timer per target; the copy lasts until the subsystem removes it instead
+    FGameplayEffectSpec UntimedSpec(Spec);
+    if (!bInstant)
+    {
+        UntimedSpec.SetDuration(UGameplayEffect::INFINITE_DURATION, true);
+    }
+    if (StatusTag.IsValid())
+    {
+        UntimedSpec.DynamicGrantedTags.AddTag(StatusTag);
+    }
+
+    for (UAbilitySystemComponent* Target : TargetsToAfflict)
+    {
+        AddEffectStatus(Type, Target, UntimedSpec, StatusDuration);
+    }
+}
+
+void UCOStatusEffectSubsystem::ApplyStatusOrEffect(const UWorld* World, ECOStatusType Type, const FGameplayEffectSpec& Spec, TConstArrayView<UAbilitySystemComponent*> TargetsToAfflict, float Duration)
+{
+    if (UCOStatusEffectSubsystem* StatusEffects = World ? World->GetSubsystem<UCOStatusEffectSubsystem>() : nullptr)
+    {
+        StatusEffects->ApplyStatus(Type, Spec, TargetsToAfflict, Duration);
+    }
+    else
+    {
+        // Without the subsystem the effect keeps the duration it was authored with
+        UCODamageAccumulatorSubsystem::ApplySpecDirectly(Spec, TargetsToAfflict);
+    }
+}
+
+int32 UCOStatusEffectSubsystem::AddEffectStatus(ECOStatusType Type, UAbilitySystemComponent* Target, const FGameplayEffectSpec& UntimedSpec, float Duration)
+{
+    if (!Target)
+    {
+        return INDEX_NONE;
+    }
+
+    // An effect blocked by immunity or tag requirements gets no handle, and then the status does not land either
+    const FActiveGameplayEffectHandle Handle = Target->ApplyGameplayEffectSpecToSelf(UntimedSpec);
+    if (!Handle.IsValid() && UntimedSpec.Def->DurationPolicy != EGameplayEffectDurationType::Instant)
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 StatusId = AddEntry(Type, Target, Duration);
+    GetList(Type).EffectHandles.Add(Handle);
+    return StatusId;
+}
+
+int32 UCOStatusEffectSubsystem::AddDamageOverTime(UAbilitySystemComponent* Target, const FCODamageOverTime& DamageOverTime, float Duration, const FCODamageSource& Source)
+{
+    if (!Target || DamageOverTime.Period <= 0.0f)
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 StatusId = AddEntry(ECOStatusType::DamageOverTime, Target, Duration);
+
+    FCOStatusList& DoTs = GetList(ECOStatusType::DamageOverTime);
+    DoTs.Periods.Add(DamageOverTime.Period);
+    DoTs.TimeToNextPeriod.Add(DamageOverTime.Period);
+    DoTs.DamagePerPeriod.Add(DamageOverTime.DamagePerPeriod);
+    DoTs.PendingDamage.Add(0.0f);
+    DoTs.Sources.Add(Source);
+    DoTs.Attributes.Add(DamageOverTime.Attribute);
+
+    // The first period lands with this frame's other hits, as when GAS executes it on application
+    if (DamageOverTime.bDamageOnApplication)
+    {
+        DealDamage(Target, DamageOverTime.DamagePerPeriod, Source, DamageOverTime.Attribute, GetWorld()->GetSubsystem<UCODamageAccumulatorSubsystem>());
+    }
+
+    return StatusId;
+}
+
+int32 UCOStatusEffectSubsystem::AddEntry(ECOStatusType Type, UAbilitySystemComponent* Target, float Duration)
+{
+    const int32 Slot = FindOrAddTarget(Target);
+    const int32 StatusId = NextStatusId++;
+
+    FCOStatusList& List = GetList(Type);
+    List.IndicesById.Add(StatusId, List.Ids.Num());
+    List.Ids.Add(StatusId);
+    List.TargetSlots.Add(Slot);
+
+    if (Type == ECOStatusType::DamageOverTime)
+    {
+        List.TimeLeft.Add(Duration > 0.0f ? Duration : TNumericLimits<float>::Max());
+    }
+    else
+    {
+        FCOExpiryHandle& ExpiryHandle = List.ExpiryHandles.AddDefaulted_GetRef();
+        UCOExpirySubsystem* Expiries = GetWorld()->GetSubsystem<UCOExpirySubsystem>();
+        if (Expiries && Duration > 0.0f)
+        {
+            ExpiryHandle = Expiries->ScheduleCallback(Duration, FSimpleDelegate::CreateUObject(this, &UCOStatusEffectSubsystem::ExpireStatus, Type, StatusId));
+        }
+    }
+
+    ++Targets[Slot].NumStatuses[static_cast<int32>(Type)];
+    return StatusId;
+}
+
+void UCOStatusEffectSubsystem::RemoveStatus(ECOStatusType Type, int32 StatusId)
+{
+    if (const int32* Index = GetList(Type).IndicesById.Find(StatusId))
+    {
+        RemoveStatusAt(Type, *Index);
+    }
+}
+
+/**
+ * @brief Ends a slow, root or stun whose time ran out on the expiry wheel.
+ */
+void UCOStatusEffectSubsystem::ExpireStatus(ECOStatusType Type, int32 StatusId)
+{
+    FCOStatusList& List = GetList(Type);
+    if (const int32* Index = List.IndicesById.Find(StatusId))
+    {
+        // The record already fired, so there is nothing left to cancel
+        List.ExpiryHandles[*Index].Invalidate();
+        RemoveStatusAt(Type, *Index);
+    }
+}
+
+/**
+ * @brief Drops statuses of destroyed targets, advances every status and hands the periods that elapsed to the
+ * damage accumulator.
+ */
+void UCOStatusEffectSubsystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_CO_StatusEffectsTick);
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    UpdateTargets();
+    AccumulateDamage(DeltaTime);
+
+    int32 NumActive = 0;
+    for (int32 TypeIndex = 0; TypeIndex < NumStatusTypes; ++TypeIndex)
+    {
+        RemoveExpired(static_cast<ECOStatusType>(TypeIndex));
+        NumActive += Statuses[TypeIndex].Num();
+    }
+
+    FlushPendingDamage();
+
+    SET_DWORD_STAT(STAT_CO_ActiveStatuses, NumActive);
+    LastTickSeconds = FPlatformTime::Seconds() - StartTime;
+}
+
+/**
+ * @brief Counts every DoT's timers down and adds the damage of the periods that elapsed this frame.
+ *
+ * The loop is branch-free over plain float arrays so the compiler can vectorize it. Only time the DoT was still
+ * active counts towards its period, so a period that ends with the duration still deals its damage, as in GAS,
+ * and one cut short does not.
+ */
+void UCOStatusEffectSubsystem::AccumulateDamage(float DeltaTime)
+{
+    FCOStatusList& DoTs = GetList(ECOStatusType::DamageOverTime);
+    const int32 NumDoTs = DoTs.Num();
+
+    float* RESTRICT Damage = DoTs.PendingDamage.GetData();
+    float* RESTRICT TimeLeft = DoTs.TimeLeft.GetData();
+    float* RESTRICT TimeToNext = DoTs.TimeToNextPeriod.GetData();
+    const float* RESTRICT Periods = DoTs.Periods.GetData();
+    const float* RESTRICT DamagePerPeriod = DoTs.DamagePerPeriod.GetData();
+
+    // Absorbs float drift from summing frame times, so a period ending exactly with the frame is not lost
+    constexpr float Tolerance = UE_KINDA_SMALL_NUMBER;
+
+    for (int32 Index = 0; Index < NumDoTs; ++Index)
+    {
+        const float ActiveTime = FMath::Min(FMath::Max(TimeLeft[Index], 0.0f), DeltaTime);
+        const float Remaining = TimeToNext[Index] - ActiveTime;
+        const float NumPeriods = FMath::Max(FMath::FloorToFloat((Tolerance - Remaining) / Periods[Index]) + 1.0f, 0.0f);
+
+        Damage[Index] += NumPeriods * DamagePerPeriod[Index];
+        TimeToNext[Index] = Remaining + NumPeriods * Periods[Index];
+        TimeLeft[Index] -= DeltaTime;
+    }
+}
+
+/**
+ * @brief Removes DoTs that ran out and every status on a stale target. Other types expire from the wheel.
+ */
+void UCOStatusEffectSubsystem::RemoveExpired(ECOStatusType Type)
+{
+    FCOStatusList& List = GetList(Type);
+    const bool bTimed = Type == ECOStatusType::DamageOverTime;
+
+    // Walk backwards so swap-removal never skips an entry
+    for (int32 Index = List.Num() - 1; Index >= 0; --Index)
+    {
+        if ((bTimed && List.TimeLeft[Index] <= 0.0f) || Targets[List.TargetSlots[Index]].bStale)
+        {
+            RemoveStatusAt(Type, Index);
+        }
+    }
+}
+
+void UCOStatusEffectSubsystem::RemoveStatusAt(ECOStatusType Type, int32 Index)
+{
+    FCOStatusList& List = GetList(Type);
+    FCOStatusTarget& Entry = Targets[List.TargetSlots[Index]];
+    UAbilitySystemComponent* AbilitySystem = Entry.AbilitySystem.Get();
+
+    if (Type == ECOStatusType::DamageOverTime)
+    {
+        // Periods that elapsed this frame are still owed
+        FlushDamage(Index, GetWorld()->GetSubsystem<UCODamageAccumulatorSubsystem>());
+        List.TimeLeft.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+        List.Periods.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+        List.TimeToNextPeriod.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+        List.DamagePerPeriod.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+        List.PendingDamage.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+        List.Sources.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+        List.Attributes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    }
+    else
+    {
+        // One stack only, so a stacking effect applied by several statuses stays until the last one ends
+        const FActiveGameplayEffectHandle Handle = List.EffectHandles[Index];
+        if (Handle.IsValid() && AbilitySystem)
+        {
+            AbilitySystem->RemoveActiveGameplayEffect(Handle, 1);
+        }
+        List.EffectHandles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+        if (UCOExpirySubsystem* Expiries = GetWorld()->GetSubsystem<UCOExpirySubsystem>())
+        {
+            Expiries->Cancel(List.ExpiryHandles[Index]);
+        }
+        List.ExpiryHandles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    }
+
+    List.IndicesById.Remove(List.Ids[Index]);
+    List.Ids.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    List.TargetSlots.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+    // The last entry moved into the freed index
+    if (Index < List.Num())
+    {
+        List.IndicesById[List.Ids[Index]] = Index;
+    }
+
+    --Entry.NumStatuses[static_cast<int32>(Type)];
+}
+
+void UCOStatusEffectSubsystem::FlushDamage(int32 Index, UCODamageAccumulatorSubsystem* DamageAccumulator)
+{
+    FCOStatusList& DoTs = GetList(ECOStatusType::DamageOverTime);
+    float& Damage = DoTs.PendingDamage[Index];
+
+    UAbilitySystemComponent* AbilitySystem = Targets[DoTs.TargetSlots[Index]].AbilitySystem.Get();
+    if (Damage > 0.0f && AbilitySystem)
+    {
+        DealDamage(AbilitySystem, Damage, DoTs.Sources[Index], DoTs.Attributes[Index], DamageAccumulator);
+    }
+    Damage = 0.0f;
+}
+
+void UCOStatusEffectSubsystem::DealDamage(UAbilitySystemComponent* Target, float Damage, const FCODamageSource& Source, const FGameplayAttribute& Attribute, UCODamageAccumulatorSubsystem* DamageAccumulator) const
+{
+    if (DamageAccumulator)
+    {
+        DamageAccumulator->AddDamage(Target, Damage, Source, Attribute);
+    }
+    else
+    {
+        UCODamageAccumulatorSubsystem::ApplyDamageNow(Target, Damage, Source.Instigator.Get(), Attribute);
+    }
+}
+
+/**
+ * @brief Hands the damage of every DoT whose period elapsed this frame to the damage accumulator.
+ */
+void UCOStatusEffectSubsystem::FlushPendingDamage()
+{
+    SCOPE_CYCLE_COUNTER(STAT_CO_StatusEffectsFlush);
+
+    UCODamageAccumulatorSubsystem* DamageAccumulator = GetWorld()->GetSubsystem<UCODamageAccumulatorSubsystem>();
+    const FCOStatusList& DoTs = GetList(ECOStatusType::DamageOverTime);
+    for (int32 Index = 0; Index < DoTs.Num(); ++Index)
+    {
+        if (DoTs.PendingDamage[Index] > 0.0f)
+        {
+            FlushDamage(Index, DamageAccumulator);
+        }
+    }
+}
+
+/**
+ * @brief Marks targets whose component was destroyed as stale, so the same tick drops their statuses, and
+ * recycles targets that have no statuses left.
+ */
+void UCOStatusEffectSubsystem::UpdateTargets()
+{
+    for (int32 Slot = 0; Slot < Targets.Num(); ++Slot)
+    {
+        FCOStatusTarget& Entry = Targets[Slot];
+        if (!Entry.bInUse)
+        {
+            continue;
+        }
+
+        UAbilitySystemComponent* AbilitySystem = Entry.AbilitySystem.Get();
+        if (!AbilitySystem)
+        {
+            if (Entry.HasStatuses())
+            {
+                Entry.bStale = true;
+            }
+            else
+            {
+                ReleaseTarget(Slot);
+            }
+            continue;
+        }
+
+        if (!Entry.HasStatuses())
+        {
+            ReleaseTarget(Slot);
+        }
+    }
+}
+
+int32 UCOStatusEffectSubsystem::FindOrAddTarget(UAbilitySystemComponent* Target)
+{
+    if (const int32* ExistingSlot = TargetSlotsByComponent.Find(Target))
+    {
+        return *ExistingSlot;
+    }
+
+    const int32 Slot = FreeTargetSlots.Num() > 0 ? FreeTargetSlots.Pop(EAllowShrinking::No) : Targets.AddDefaulted();
+
+    FCOStatusTarget& Entry = Targets[Slot];
+    Entry = FCOStatusTarget();
+    Entry.AbilitySystem = Target;
+    Entry.Key = Target;
+    Entry.bInUse = true;
+
+    TargetSlotsByComponent.Add(Target, Slot);
+    return Slot;
+}
+
+void UCOStatusEffectSubsystem::ReleaseTarget(int32 Slot)
+{
+    TargetSlotsByComponent.Remove(Targets[Slot].Key);
+    Targets[Slot] = FCOStatusTarget();
+    FreeTargetSlots.Add(Slot);
+}
@@ -0,0 +1,69 @@
+#include "COTargetGridComponent.h"
+#include "COTargetGridSubsystem.h"
+#include "AbilitySystemGlobals.h"
+#include "Engine/World.h"
+
+UCOTargetGridComponent::UCOTargetGridComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UCOTargetGridComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    // Push moves to the grid as they happen, so queries never see where the owner was last tick
+    if (USceneComponent* Root = GetOwner()->GetRootComponent())
+    {
+        Root->TransformUpdated.AddUObject(this, &UCOTargetGridComponent::OnOwnerMoved);
+        TrackedRoot = Root;
+    }
+
+    RefreshRegistration();
+}
+
+void UCOTargetGridComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (USceneComponent* Root = TrackedRoot.Get())
+    {
+        Root->TransformUpdated.RemoveAll(this);
+    }
+    TrackedRoot.Reset();
+
+    if (UCOTargetGridSubsystem* TargetGrid = GetWorld()->GetSubsystem<UCOTargetGridSubsystem>())
+    {
+        TargetGrid->UnregisterTarget(GetOwner());
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+/**
+ * @brief Re-resolves the owner's ASC and updates its grid entry.
+ *
+ * The entry is replaced rather than kept, so an owner whose ASC changed is returned with the new one.
+ */
+void UCOTargetGridComponent::RefreshRegistration()
+{
+    UCOTargetGridSubsystem* TargetGrid = GetWorld() ? GetWorld()->GetSubsystem<UCOTargetGridSubsystem>() : nullptr;
+    AActor* Owner = GetOwner();
+    if (!TargetGrid || !Owner)
+    {
+        return;
+    }
+
+    TargetGrid->UnregisterTarget(Owner);
+
+    if (UAbilitySystemComponent* ASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Owner))
+    {
+        TargetGrid->RegisterTarget(Owner, ASC, TrackedRoot.IsValid());
+    }
+}
+
+void UCOTargetGridComponent::OnOwnerMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+    if (UCOTargetGridSubsystem* TargetGrid = GetWorld()->GetSubsystem<UCOTargetGridSubsystem>())
+    {
+        TargetGrid->UpdateTarget(GetOwner());
+    }
+}
@@ -0,0 +1,278 @@
+#include "COTargetGridSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "GameFramework/Actor.h"
+#include "COStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Target Grid Tick"), STAT_CO_TargetGridTick, STATGROUP_CelestialOdyssey);
+
+/**
+ * @brief Releases all tracked targets when the world is torn down.
+ */
+void UCOTargetGridSubsystem::Deinitialize()
+{
+    Entries.Reset();
+    Cells.Reset();
+    ActorToEntry.Reset();
+
+    Super::Deinitialize();
+}
+
+TStatId UCOTargetGridSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCOTargetGridSubsystem, STATGROUP_Tickables);
+}
+
+bool UCOTargetGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FIntPoint UCOTargetGridSubsystem::ToCell(const FVector2D& PlanePosition)
+{
+    return FIntPoint(
+        FMath::FloorToInt32(PlanePosition.X / CellSize),
+        FMath::FloorToInt32(PlanePosition.Y / CellSize));
+}
+
+/**
+ * @brief Refreshes the positions of targets that do not push their moves.
+ *
+ * Actors that were destroyed without unregistering are dropped here.
+ */
+void UCOTargetGridSubsystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_CO_TargetGridTick);
+
+    for (int32 Index = Entries.Num() - 1; Index >= 0; --Index)
+    {
+        FCOTargetGridEntry& Entry = Entries[Index];
+        const AActor* Actor = Entry.Actor.Get();
+        if (!Actor || !Entry.AbilitySystemComponent.IsValid())
+        {
+            RemoveEntryAt(Index);
+            continue;
+        }
+
+        if (!Entry.bPushesMoves)
+        {
+            UpdateEntryLocation(Index, Actor->GetActorLocation());
+        }
+    }
+}
+
+/**
+ * @brief Re-buckets an entry if it crossed a cell boundary and refreshes its cached position.
+ */
+void UCOTargetGridSubsystem::UpdateEntryLocation(int32 EntryIndex, const FVector& Location)
+{
+    const FCOTargetGridEntry& Entry = Entries[EntryIndex];
+    const FVector2D Position = ToPlane(Location);
+    const FIntPoint Cell = ToCell(Position);
+
+    if (Cell == Entry.Cell)
+    {
+        Cells.FindChecked(Cell).Items[Entry.SlotInCell].Position = Position;
+    }
+    else
+    {
+        const float Radius = Cells.FindChecked(Entry.Cell).Items[Entry.SlotInCell].Radius;
+        RemoveFromCell(EntryIndex);
+        AddToCell(EntryIndex, Cell, Position, Radius);
+    }
+}
+
+void UCOTargetGridSubsystem::RegisterTarget(AActor* Actor, UAbilitySystemComponent* AbilitySystemComponent, bool bPushesMoves)
+{
+    if (!Actor || !AbilitySystemComponent || ActorToEntry.Contains(Actor))
+    {
+        return;
+    }
+
+    const FVector2D Position = ToPlane(Actor->GetActorLocation());
+    const float Radius = Actor->GetSimpleCollisionRadius();
+    MaxTargetRadius = FMath::Max(MaxTargetRadius, Radius);
+
+    const int32 EntryIndex = Entries.AddDefaulted();
+    FCOTargetGridEntry& Entry = Entries[EntryIndex];
+    Entry.ActorKey = Actor;
+    Entry.Actor = Actor;
+    Entry.AbilitySystemComponent = AbilitySystemComponent;
+    Entry.bPushesMoves = bPushesMoves;
+
+    AddToCell(EntryIndex, ToCell(Position), Position, Radius);
+    ActorToEntry.Add(Actor, EntryIndex);
+}
+
+void UCOTargetGridSubsystem::UnregisterTarget(AActor* Actor)
+{
+    if (const int32* EntryIndex = ActorToEntry.Find(Actor))
+    {
+        RemoveEntryAt(*EntryIndex);
+    }
+}
+
+void UCOTargetGridSubsystem::UpdateTarget(const AActor* Actor)
+{
+    if (const int32* EntryIndex = ActorToEntry.Find(Actor))
+    {
+        UpdateEntryLocation(*EntryIndex, Actor->GetActorLocation());
+    }
+}
+
+UAbilitySystemComponent* UCOTargetGridSubsystem::FindAbilitySystemComponent(const AActor* Actor) const
+{
+    const int32* EntryIndex = ActorToEntry.Find(Actor);
+    return EntryIndex ? Entries[*EntryIndex].AbilitySystemComponent.Get() : nullptr;
+}
+
+void UCOTargetGridSubsystem::AddToCell(int32 EntryIndex, const FIntPoint& Cell, const FVector2D& Position, float Radius)
+{
+    FCOTargetGridEntry& Entry = Entries[EntryIndex];
+    FCOTargetGridCell& GridCell = Cells.FindOrAdd(Cell);
+
+    Entry.Cell = Cell;
+    Entry.SlotInCell = GridCell.Items.Add({ Position, Radius, EntryIndex });
+}
+
+void UCOTargetGridSubsystem::RemoveFromCell(int32 EntryIndex)
+{
+    const FCOTargetGridEntry& Entry = Entries[EntryIndex];
+    TArray<FCOTargetGridItem>& Items = Cells.FindChecked(Entry.Cell).Items;
+
+    const int32 Slot = Entry.SlotInCell;
+    Items.RemoveAtSwap(Slot);
+
+    // Drop empty cells so targets roaming the level don't leave a trail of cells for queries to look up
+    if (Items.Num() == 0)
+    {
+        Cells.Remove(Entry.Cell);
+        return;
+    }
+
+    // Fix up the item that was swapped into the freed slot
+    if (Items.IsValidIndex(Slot))
+    {
+        Entries[Items[Slot].EntryIndex].SlotInCell = Slot;
+    }
+}
+
+void UCOTargetGridSubsystem::RemoveEntryAt(int32 EntryIndex)
+{
+    RemoveFromCell(EntryIndex);
+    ActorToEntry.Remove(Entries[EntryIndex].ActorKey);
+
+    Entries.RemoveAtSwap(EntryIndex);
+
+    // Fix up the entry that was swapped into the freed index
+    if (Entries.IsValidIndex(EntryIndex))
+    {
+        const FCOTargetGridEntry& Moved = Entries[EntryIndex];
+        Cells.FindChecked(Moved.Cell).Items[Moved.SlotInCell].EntryIndex = EntryIndex;
+        ActorToEntry.Add(Moved.ActorKey, EntryIndex);
+    }
+}
+
+void UCOTargetGridSubsystem::QueryCircle(const FVector& Center, float Radius, TArray<UAbilitySystemComponent*>& OutTargets, const AActor* IgnoredActor) const
+{
+    OutTargets.Reset();
+
+    const FVector2D PlaneCenter = ToPlane(Center);
+    const FVector2D Extent(Radius + MaxTargetRadius);
+    const FIntPoint MinCell = ToCell(PlaneCenter - Extent);
+    const FIntPoint MaxCell = ToCell(PlaneCenter + Extent);
+
+    for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+    {
+        for (int32 CellZ = MinCell.Y; CellZ <= MaxCell.Y; ++CellZ)
+        {
+            const FCOTargetGridCell* GridCell = Cells.Find(FIntPoint(CellX, CellZ));
+            if (!GridCell)
+            {
+                continue;
+            }
+
+            for (const FCOTargetGridItem& Item : GridCell->Items)
+            {
+                if (FVector2D::DistSquared(Item.Position, PlaneCenter) > FMath::Square(Radius + Item.Radius))
+                {
+                    continue;
+                }
+
+                const FCOTargetGridEntry& Entry = Entries[Item.EntryIndex];
+                if (IgnoredActor && Entry.ActorKey == TObjectKey<AActor>(IgnoredActor))
+                {
+                    continue;
+                }
+
+                if (UAbilitySystemComponent* TargetASC = Entry.AbilitySystemComponent.Get())
+                {
+                    OutTargets.Add(TargetASC);
+                }
+            }
+        }
+    }
+}
+
+void UCOTargetGridSubsystem::QuerySegment(const FVector& Start, const FVector& End, float Radius, TArray<UAbilitySystemComponent*>& OutTargets, const AActor* IgnoredActor) const
+{
+    OutTargets.Reset();
+
+    const FVector2D PlaneStart = ToPlane(Start);
+    const FVector2D PlaneEnd = ToPlane(End);
+    const FVector2D Segment = PlaneEnd - PlaneStart;
+    const double SegmentLengthSquared = Segment.SizeSquared();
+
+    const FVector2D Extent(Radius + MaxTargetRadius);
+    const FIntPoint MinCell = ToCell(FVector2D::Min(PlaneStart, PlaneEnd) - Extent);
+    const FIntPoint MaxCell = ToCell(FVector2D::Max(PlaneStart, PlaneEnd) + Extent);
+
+    // Pair of (distance along the segment, ASC) so results can be ordered like a sweep
+    TArray<TPair<double, UAbilitySystemComponent*>, TInlineAllocator<16>> Hits;
+
+    for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+    {
+        for (int32 CellZ = MinCell.Y; CellZ <= MaxCell.Y; ++CellZ)
+        {
+            const FCOTargetGridCell* GridCell = Cells.Find(FIntPoint(CellX, CellZ));
+            if (!GridCell)
+            {
+                continue;
+            }
+
+            for (const FCOTargetGridItem& Item : GridCell->Items)
+            {
+                const double Alpha = SegmentLengthSquared > UE_SMALL_NUMBER
+                    ? FMath::Clamp(FVector2D::DotProduct(Item.Position - PlaneStart, Segment) / SegmentLengthSquared, 0.0, 1.0)
+                    : 0.0;
+                const FVector2D Closest = PlaneStart + Segment * Alpha;
+
+                if (FVector2D::DistSquared(Item.Position, Closest) > FMath::Square(Radius + Item.Radius))
+                {
+                    continue;
+                }
+
+                const FCOTargetGridEntry& Entry = Entries[Item.EntryIndex];
+                if (IgnoredActor && Entry.ActorKey == TObjectKey<AActor>(IgnoredActor))
+                {
+                    continue;
+                }
+
+                if (UAbilitySystemComponent* TargetASC = Entry.AbilitySystemComponent.Get())
+                {
+                    Hits.Emplace(Alpha, TargetASC);
+                }
+            }
+        }
+    }
+
+    Hits.Sort([](const TPair<double, UAbilitySystemComponent*>& A, const TPair<double, UAbilitySystemComponent*>& B)
+    {
+        return A.Key < B.Key;
+    });
+
+    OutTargets.Reserve(Hits.Num());
+    for (const TPair<double, UAbilitySystemComponent*>& Hit : Hits)
+    {
+        OutTargets.Add(Hit.Value);
+    }
+}
@@ -0,0 +1,59 @@
+#include "COTrace.h"
+
+#if CO_TRACE_ENABLED
+
+#include "Abilities/GameplayAbility.h"
+
+UE_TRACE_CHANNEL_DEFINE(CelestialOdysseyChannel);
+
+UE_TRACE_EVENT_BEGIN(CelestialOdyssey, AbilityActivated)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(uint64, Frame)
+    UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Ability)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(CelestialOdyssey, AbilityHits)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(uint64, Frame)
+    UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Ability)
+    UE_TRACE_EVENT_FIELD(int32, NumTargets)
+    UE_TRACE_EVENT_FIELD(int32, NumEffects)
+UE_TRACE_EVENT_END()
+
+/**
+ * @brief Emits an AbilityActivated event; the class name is only built when the channel is enabled.
+ */
+void FCOTrace::OutputAbilityActivated(const UGameplayAbility* Ability)
+{
+    if (!UE_TRACE_CHANNELEXPR_IS_ENABLED(CelestialOdysseyChannel) || !Ability)
+    {
+        return;
+    }
+
+    const FString AbilityName = Ability->GetClass()->GetName();
+    UE_TRACE_LOG(CelestialOdyssey, AbilityActivated, CelestialOdysseyChannel)
+        << AbilityActivated.Cycle(FPlatformTime::Cycles64())
+        << AbilityActivated.Frame(GFrameCounter)
+        << AbilityActivated.Ability(*AbilityName, AbilityName.Len());
+}
+
+/**
+ * @brief Emits an AbilityHits event with the target and effect counts of one activation.
+ */
+void FCOTrace::OutputAbilityHits(const UGameplayAbility* Ability, int32 NumTargets, int32 NumEffects)
+{
+    if (!UE_TRACE_CHANNELEXPR_IS_ENABLED(CelestialOdysseyChannel) || !Ability)
+    {
+        return;
+    }
+
+    const FString AbilityName = Ability->GetClass()->GetName();
+    UE_TRACE_LOG(CelestialOdyssey, AbilityHits, CelestialOdysseyChannel)
+        << AbilityHits.Cycle(FPlatformTime::Cycles64())
+        << AbilityHits.Frame(GFrameCounter)
+        << AbilityHits.Ability(*AbilityName, AbilityName.Len())
+        << AbilityHits.NumTargets(NumTargets)
+        << AbilityHits.NumEffects(NumEffects);
+}
+
+#endif // CO_TRACE_ENABLED
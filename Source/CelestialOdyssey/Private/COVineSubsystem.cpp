@@ -0,0 +1,531 @@
+#include "COVineSubsystem.h"
+#include "COCollisionChannels.h"
+#include "COExpirySubsystem.h"
+#include "COStats.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Async/ParallelFor.h"
+
+DECLARE_CYCLE_STAT(TEXT("Vines Tick"), STAT_CO_VinesTick, STATGROUP_CelestialOdyssey);
+DECLARE_CYCLE_STAT(TEXT("Vines Integrate"), STAT_CO_VinesIntegrate, STATGROUP_CelestialOdyssey);
+DECLARE_CYCLE_STAT(TEXT("Vines Constraints"), STAT_CO_VinesConstraints, STATGROUP_CelestialOdyssey);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vine Particles"), STAT_CO_VineParticles, STATGROUP_CelestialOdyssey);
+
+namespace
+{
+    /** Fraction of velocity kept each step */
+    constexpr float Damping = 0.99f;
+
+    /** Speed at which a grabbed target is reeled in */
+    constexpr float ReelSpeed = 600.0f;
+
+    /** Distance a grabbed target is held at once fully reeled in */
+    constexpr float GrabHoldDistance = 150.0f;
+
+    /** A bridge is settled once no particle moved more than this per step for SettleSteps steps */
+    constexpr float SettleTolerance = 0.05f;
+    constexpr int32 SettleSteps = 30;
+
+    /** Particles moving less than this per step skip the world trace */
+    constexpr float MinTraceDistance = 0.1f;
+
+    /** Depth and thickness of a walkable bridge segment */
+    constexpr float BridgeDepth = 200.0f;
+    constexpr float BridgeThickness = 20.0f;
+
+    /** Size of the engine cube the bridge segments are scaled from */
+    constexpr float CubeSize = 100.0f;
+
+    /** Where released bridge instances wait for reuse */
+    const FTransform ParkedTransform(FQuat::Identity, FVector(0.0f, 0.0f, -1.0e6f));
+}
+
+void UCOVineSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    PosX.Reserve(MaxParticles);
+    PosZ.Reserve(MaxParticles);
+    PrevX.Reserve(MaxParticles);
+    PrevZ.Reserve(MaxParticles);
+    InvMass.Reserve(MaxParticles);
+
+    // Vine lifetimes run on the expiry wheel
+    Collection.InitializeDependency<UCOExpirySubsystem>();
+}
+
+/**
+ * @brief Drops every vine when the world is torn down. The bridge component goes with its actor.
+ */
+void UCOVineSubsystem::Deinitialize()
+{
+    PosX.Empty();
+    PosZ.Empty();
+    PrevX.Empty();
+    PrevZ.Empty();
+    InvMass.Empty();
+    Vines.Empty();
+    FreeBridgeInstances.Empty();
+    BridgeComponent = nullptr;
+
+    Super::Deinitialize();
+}
+
+TStatId UCOVineSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCOVineSubsystem, STATGROUP_Tickables);
+}
+
+bool UCOVineSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+int32 UCOVineSubsystem::AddVine(ECOVineMode Mode, const FVector& Start, const FVector& End, int32 NumSegments, float Slack, AActor* HeadActor, AActor* TailActor, float Lifetime)
+{
+    const int32 ClampedSegments = FMath::Clamp(NumSegments, 1, MaxSegmentsPerVine);
+    const int32 NumParticles = ClampedSegments + 1;
+    if (PosX.Num() + NumParticles > MaxParticles)
+    {
+        return INDEX_NONE;
+    }
+
+    FCOVine& Vine = Vines.AddDefaulted_GetRef();
+    Vine.Id = NextVineId++;
+    Vine.Mode = Mode;
+    Vine.FirstParticle = PosX.Num();
+    Vine.NumParticles = NumParticles;
+    Vine.PlaneY = Start.Y;
+    Vine.HeadActor = HeadActor;
+    Vine.TailActor = TailActor;
+
+    const FVector2f Head(Start.X, Start.Z);
+    const FVector2f Tail(End.X, End.Z);
+    Vine.RopeLength = FMath::Max(FVector2f::Distance(Head, Tail) * Slack, 1.0f);
+    Vine.MinRopeLength = FMath::Min(GrabHoldDistance, Vine.RopeLength);
+    Vine.SegmentLength = Vine.RopeLength / ClampedSegments;
+
+    // Particles start on the straight line between the ends; any slack sags out under gravity
+    const bool bPinnedTail = Mode == ECOVineMode::Bridge || TailActor != nullptr;
+    for (int32 Index = 0; Index < NumParticles; ++Index)
+    {
+        const FVector2f Position = FMath::Lerp(Head, Tail, static_cast<float>(Index) / ClampedSegments);
+        const bool bPinned = Index == 0 || (Index == NumParticles - 1 && bPinnedTail);
+
+        PosX.Add(Position.X);
+        PosZ.Add(Position.Y);
+        PrevX.Add(Position.X);
+        PrevZ.Add(Position.Y);
+        InvMass.Add(bPinned ? 0.0f : 1.0f);
+    }
+
+    if (Lifetime > 0.0f)
+    {
+        if (UCOExpirySubsystem* Expiries = GetWorld()->GetSubsystem<UCOExpirySubsystem>())
+        {
+            Expiries->ScheduleCallback(Lifetime, FSimpleDelegate::CreateUObject(this, &UCOVineSubsystem::RemoveVine, Vine.Id));
+        }
+    }
+
+    return Vine.Id;
+}
+
+/**
+ * @brief Removes a vine and closes the gap it leaves in the particle buffer.
+ */
+void UCOVineSubsystem::RemoveVine(int32 VineId)
+{
+    const int32 VineIndex = Vines.IndexOfByPredicate([VineId](const FCOVine& Vine) { return Vine.Id == VineId; });
+    if (VineIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    FCOVine& Removed = Vines[VineIndex];
+    ReleaseBridge(Removed);
+
+    const int32 First = Removed.FirstParticle;
+    const int32 Count = Removed.NumParticles;
+
+    PosX.RemoveAt(First, Count, EAllowShrinking::No);
+    PosZ.RemoveAt(First, Count, EAllowShrinking::No);
+    PrevX.RemoveAt(First, Count, EAllowShrinking::No);
+    PrevZ.RemoveAt(First, Count, EAllowShrinking::No);
+    InvMass.RemoveAt(First, Count, EAllowShrinking::No);
+
+    Vines.RemoveAtSwap(VineIndex);
+
+    for (FCOVine& Vine : Vines)
+    {
+        if (Vine.FirstParticle > First)
+        {
+            Vine.FirstParticle -= Count;
+        }
+    }
+}
+
+bool UCOVineSubsystem::GetVinePoints(int32 VineId, TArray<FVector>& OutPoints) const
+{
+    const FCOVine* Vine = Vines.FindByPredicate([VineId](const FCOVine& Candidate) { return Candidate.Id == VineId; });
+    if (!Vine)
+    {
+        return false;
+    }
+
+    OutPoints.Reset(Vine->NumParticles);
+    for (int32 Index = 0; Index < Vine->NumParticles; ++Index)
+    {
+        OutPoints.Add(ToWorld(*Vine, Vine->FirstParticle + Index));
+    }
+
+    return true;
+}
+
+/**
+ * @brief Runs the solver at a fixed step. At most MaxStepsPerTick steps run per frame; any time beyond that is dropped.
+ */
+void UCOVineSubsystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_CO_VinesTick);
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    if (Vines.Num() == 0)
+    {
+        TimeAccumulator = 0.0f;
+        LastTickSeconds = 0.0;
+        return;
+    }
+
+    TimeAccumulator = FMath::Min(TimeAccumulator + DeltaTime, MaxStepsPerTick * StepSeconds);
+    while (TimeAccumulator >= StepSeconds)
+    {
+        Step();
+        TimeAccumulator -= StepSeconds;
+    }
+
+    SET_DWORD_STAT(STAT_CO_VineParticles, PosX.Num());
+    LastTickSeconds = FPlatformTime::Seconds() - StartTime;
+}
+
+/**
+ * @brief One solver step over every vine.
+ *
+ * Integration is one pass over the whole buffer. Constraints and world collision only touch a vine's own
+ * particles, so vines are relaxed in parallel. Attached actors are moved afterwards on the game thread.
+ */
+void UCOVineSubsystem::Step()
+{
+    Integrate();
+
+    for (FCOVine& Vine : Vines)
+    {
+        if (!Vine.bSettled)
+        {
+            PinEnds(Vine);
+        }
+    }
+
+    {
+        SCOPE_CYCLE_COUNTER(STAT_CO_VinesConstraints);
+
+        ParallelFor(TEXT("COVineConstraints"), Vines.Num(), 1, [this](int32 VineIndex)
+        {
+            const FCOVine& Vine = Vines[VineIndex];
+            if (!Vine.bSettled)
+            {
+                SolveConstraints(Vine);
+                CollideWithWorld(Vine);
+            }
+        });
+    }
+
+    for (FCOVine& Vine : Vines)
+    {
+        if (Vine.bSettled)
+        {
+            continue;
+        }
+
+        ConstrainTailActor(Vine);
+
+        if (Vine.Mode == ECOVineMode::Bridge && UpdateSettled(Vine))
+        {
+            BuildBridge(Vine);
+        }
+    }
+}
+
+/**
+ * @brief Verlet integration of every particle in the buffer.
+ *
+ * Pinned particles have zero inverse mass and are masked out arithmetically instead of branched over,
+ * which keeps the loop a straight run over float arrays.
+ */
+void UCOVineSubsystem::Integrate()
+{
+    SCOPE_CYCLE_COUNTER(STAT_CO_VinesIntegrate);
+
+    const float GravityStep = GetWorld()->GetGravityZ() * StepSeconds * StepSeconds;
+    const int32 NumParticles = PosX.Num();
+
+    float* RESTRICT X = PosX.GetData();
+    float* RESTRICT Z = PosZ.GetData();
+    float* RESTRICT OldX = PrevX.GetData();
+    float* RESTRICT OldZ = PrevZ.GetData();
+    const float* RESTRICT Mass = InvMass.GetData();
+
+    for (int32 Index = 0; Index < NumParticles; ++Index)
+    {
+        const float Free = Mass[Index] > 0.0f ? 1.0f : 0.0f;
+        const float VelocityX = (X[Index] - OldX[Index]) * Damping;
+        const float VelocityZ = (Z[Index] - OldZ[Index]) * Damping + GravityStep;
+
+        OldX[Index] = X[Index];
+        OldZ[Index] = Z[Index];
+        X[Index] += Free * VelocityX;
+        Z[Index] += Free * VelocityZ;
+    }
+}
+
+/**
+ * @brief Moves pinned ends that follow an actor, and frees the tail once its actor is gone.
+ */
+void UCOVineSubsystem::PinEnds(FCOVine& Vine)
+{
+    if (const AActor* Head = Vine.HeadActor.Get())
+    {
+        const FVector Location = Head->GetActorLocation();
+        PosX[Vine.FirstParticle] = Location.X;
+        PosZ[Vine.FirstParticle] = Location.Z;
+    }
+
+    const int32 Tail = Vine.FirstParticle + Vine.NumParticles - 1;
+    if (const AActor* TailActor = Vine.TailActor.Get())
+    {
+        const FVector Location = TailActor->GetActorLocation();
+        PosX[Tail] = Location.X;
+        PosZ[Tail] = Location.Z;
+    }
+    else if (Vine.Mode != ECOVineMode::Bridge && InvMass[Tail] == 0.0f && Vine.NumParticles > 1)
+    {
+        InvMass[Tail] = 1.0f;
+    }
+}
+
+/**
+ * @brief Relaxes the segment distance constraints of a vine.
+ */
+void UCOVineSubsystem::SolveConstraints(const FCOVine& Vine)
+{
+    const int32 Last = Vine.FirstParticle + Vine.NumParticles - 1;
+
+    for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+    {
+        for (int32 Index = Vine.FirstParticle; Index < Last; ++Index)
+        {
+            const float TotalInvMass = InvMass[Index] + InvMass[Index + 1];
+            if (TotalInvMass == 0.0f)
+            {
+                continue;
+            }
+
+            const float DeltaX = PosX[Index + 1] - PosX[Index];
+            const float DeltaZ = PosZ[Index + 1] - PosZ[Index];
+            const float Distance = FMath::Sqrt(DeltaX * DeltaX + DeltaZ * DeltaZ);
+            if (Distance < KINDA_SMALL_NUMBER)
+            {
+                continue;
+            }
+
+            const float Correction = (Distance - Vine.SegmentLength) / (Distance * TotalInvMass);
+            PosX[Index] += DeltaX * Correction * InvMass[Index];
+            PosZ[Index] += DeltaZ * Correction * InvMass[Index];
+            PosX[Index + 1] -= DeltaX * Correction * InvMass[Index + 1];
+            PosZ[Index + 1] -= DeltaZ * Correction * InvMass[Index + 1];
+        }
+    }
+}
+
+/**
+ * @brief Stops free particles at world geometry on the gameplay plane.
+ *
+ * A particle that crossed a surface this step is placed on it, pushed out along the surface normal
+ * projected onto the plane, and loses its velocity so vines drape over ledges instead of bouncing.
+ */
+void UCOVineSubsystem::CollideWithWorld(const FCOVine& Vine)
+{
+    UWorld* World = GetWorld();
+    const FCollisionObjectQueryParams ObjectParams = COCollision::MakeWorldGeometryParams();
+    const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(COVineTrace), false);
+
+    for (int32 Index = Vine.FirstParticle; Index < Vine.FirstParticle + Vine.NumParticles; ++Index)
+    {
+        if (InvMass[Index] == 0.0f)
+        {
+            continue;
+        }
+
+        const float MoveX = PosX[Index] - PrevX[Index];
+        const float MoveZ = PosZ[Index] - PrevZ[Index];
+        if (MoveX * MoveX + MoveZ * MoveZ < MinTraceDistance * MinTraceDistance)
+        {
+            continue;
+        }
+
+        FHitResult Hit;
+        const FVector Start(PrevX[Index], Vine.PlaneY, PrevZ[Index]);
+        const FVector End(PosX[Index], Vine.PlaneY, PosZ[Index]);
+        if (!World->LineTraceSingleByObjectType(Hit, Start, End, ObjectParams, QueryParams))
+        {
+            continue;
+        }
+
+        const FVector2f Normal = FVector2f(Hit.ImpactNormal.X, Hit.ImpactNormal.Z).GetSafeNormal();
+        PosX[Index] = Hit.Location.X + Normal.X * ParticleRadius;
+        PosZ[Index] = Hit.Location.Z + Normal.Y * ParticleRadius;
+        PrevX[Index] = PosX[Index];
+        PrevZ[Index] = PosZ[Index];
+    }
+}
+
+/**
+ * @brief Keeps the actor held by the tail within rope length of the head.
+ *
+ * The actor is pulled back onto the rope circle and, for characters, loses the part of its velocity
+ * pointing away from the head. What remains is tangential, so a falling character swings like a pendulum.
+ * Grab vines shorten the rope every step to reel their target in.
+ */
+void UCOVineSubsystem::ConstrainTailActor(FCOVine& Vine)
+{
+    AActor* TailActor = Vine.TailActor.Get();
+    if (!TailActor)
+    {
+        return;
+    }
+
+    if (Vine.Mode == ECOVineMode::Grab)
+    {
+        Vine.RopeLength = FMath::Max(Vine.MinRopeLength, Vine.RopeLength - ReelSpeed * StepSeconds);
+        Vine.SegmentLength = Vine.RopeLength / (Vine.NumParticles - 1);
+    }
+
+    const FVector Head = ToWorld(Vine, Vine.FirstParticle);
+    const FVector Location = TailActor->GetActorLocation();
+
+    FVector Offset(Location.X - Head.X, 0.0f, Location.Z - Head.Z);
+    const float Distance = Offset.Size();
+    if (Distance <= Vine.RopeLength || Distance < KINDA_SMALL_NUMBER)
+    {
+        return;
+    }
+
+    const FVector Direction = Offset / Distance;
+    FVector Constrained = Head + Direction * Vine.RopeLength;
+    Constrained.Y = Location.Y;
+    TailActor->SetActorLocation(Constrained, true);
+
+    if (ACharacter* Character = Cast<ACharacter>(TailActor))
+    {
+        UCharacterMovementComponent* Movement = Character->GetCharacterMovement();
+        const float RadialSpeed = FVector::DotProduct(Movement->Velocity, Direction);
+        if (RadialSpeed > 0.0f)
+        {
+            Movement->Velocity -= Direction * RadialSpeed;
+        }
+    }
+}
+
+bool UCOVineSubsystem::UpdateSettled(FCOVine& Vine)
+{
+    float MaxMoveSquared = 0.0f;
+    for (int32 Index = Vine.FirstParticle; Index < Vine.FirstParticle + Vine.NumParticles; ++Index)
+    {
+        const float MoveX = PosX[Index] - PrevX[Index];
+        const float MoveZ = PosZ[Index] - PrevZ[Index];
+        MaxMoveSquared = FMath::Max(MaxMoveSquared, MoveX * MoveX + MoveZ * MoveZ);
+    }
+
+    Vine.NumQuietSteps = MaxMoveSquared < SettleTolerance * SettleTolerance ? Vine.NumQuietSteps + 1 : 0;
+    return Vine.NumQuietSteps >= SettleSteps;
+}
+
+/**
+ * @brief Freezes a settled bridge and lays a collision segment along each of its links.
+ */
+void UCOVineSubsystem::BuildBridge(FCOVine& Vine)
+{
+    Vine.bSettled = true;
+
+    for (int32 Index = Vine.FirstParticle; Index < Vine.FirstParticle + Vine.NumParticles; ++Index)
+    {
+        InvMass[Index] = 0.0f;
+        PrevX[Index] = PosX[Index];
+        PrevZ[Index] = PosZ[Index];
+    }
+
+    if (!BridgeComponent)
+    {
+        UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.ObjectFlags |= RF_Transient;
+        AActor* BridgeActor = CubeMesh ? GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams) : nullptr;
+        if (!BridgeActor)
+        {
+            return;
+        }
+
+        BridgeComponent = NewObject<UInstancedStaticMeshComponent>(BridgeActor, TEXT("VineBridges"));
+        BridgeComponent->SetMobility(EComponentMobility::Movable);
+        BridgeComponent->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+        BridgeComponent->SetStaticMesh(CubeMesh);
+        BridgeActor->SetRootComponent(BridgeComponent);
+        BridgeComponent->RegisterComponent();
+    }
+
+    const int32 Last = Vine.FirstParticle + Vine.NumParticles - 1;
+    for (int32 Index = Vine.FirstParticle; Index < Last; ++Index)
+    {
+        const FVector From = ToWorld(Vine, Index);
+        const FVector To = ToWorld(Vine, Index + 1);
+        const FVector Link = To - From;
+
+        // Pitch tilts the segment's X axis from the horizontal up towards Z to follow the link
+        const FRotator Rotation(FMath::RadiansToDegrees(FMath::Atan2(Link.Z, Link.X)), 0.0f, 0.0f);
+        const FTransform Transform(Rotation, 0.5f * (From + To), FVector(Link.Size() / CubeSize, BridgeDepth / CubeSize, BridgeThickness / CubeSize));
+
+        if (FreeBridgeInstances.Num() > 0)
+        {
+            const int32 InstanceIndex = FreeBridgeInstances.Pop(EAllowShrinking::No);
+            BridgeComponent->UpdateInstanceTransform(InstanceIndex, Transform, true, false, true);
+            Vine.BridgeInstances.Add(InstanceIndex);
+        }
+        else
+        {
+            Vine.BridgeInstances.Add(BridgeComponent->AddInstance(Transform, true));
+        }
+    }
+
+    BridgeComponent->MarkRenderStateDirty();
+}
+
+void UCOVineSubsystem::ReleaseBridge(FCOVine& Vine)
+{
+    if (!BridgeComponent || Vine.BridgeInstances.Num() == 0)
+    {
+        return;
+    }
+
+    for (const int32 InstanceIndex : Vine.BridgeInstances)
+    {
+        BridgeComponent->UpdateInstanceTransform(InstanceIndex, ParkedTransform, true, false, true);
+    }
+
+    BridgeComponent->MarkRenderStateDirty();
+    FreeBridgeInstances.Append(Vine.BridgeInstances);
+    Vine.BridgeInstances.Reset();
+}
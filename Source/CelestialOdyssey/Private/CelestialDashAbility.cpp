@@ -1,4 +1,9 @@
 #include "CelestialDashAbility.h"
+#include "COGameplayTags.h"
+#include "COStats.h"
+#include "COTrace.h"
+#include "COTargetGridSubsystem.h"
+#include "CODamageAccumulatorSubsystem.h"
 #include "AbilitySystemComponent.h"
 #include "GameFramework/Character.h"
 #include "GameplayEffect.h"
@@ -7,6 +12,9 @@
 #include "COEnemyAttributeSet.h"
 #include "GameFramework/CharacterMovementComponent.h"
 
+DECLARE_CYCLE_STAT(TEXT("CelestialDash ActivateAbility"), STAT_CO_CelestialDash_ActivateAbility, STATGROUP_CelestialOdyssey);
+DECLARE_CYCLE_STAT(TEXT("CelestialDash CanActivateAbility"), STAT_CO_CelestialDash_CanActivateAbility, STATGROUP_CelestialOdyssey);
+
 
 /** Default constructor for UCelestialDashAbility */
 UCelestialDashAbility::UCelestialDashAbility()
@@ -32,6 +40,9 @@ UCelestialDashAbility::UCelestialDashAbility()
  */
 void UCelestialDashAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
+    SCOPE_CYCLE_COUNTER(STAT_CO_CelestialDash_ActivateAbility);
+    CO_TRACE_ABILITY_ACTIVATED(this);
+
     Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
 
     UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get();
@@ -46,9 +57,9 @@ void UCelestialDashAbility::ActivateAbility(const FGameplayAbilitySpecHandle Han
         }
 
         // Add "Casting" tag to the player to indicate the ability is in use
-        if (!ASC->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.OnCooldown"))))
+        if (!ASC->HasMatchingGameplayTag(COGameplayTags::State_OnCooldown))
         {
-            ASC->AddLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting")));
+            ASC->AddLooseGameplayTag(COGameplayTags::State_Casting);
         }
 
     }
@@ -81,30 +92,26 @@ void UCelestialDashAbility::ActivateAbility(const FGameplayAbilitySpecHandle Han
 
         Character->LaunchCharacter(DashDirection * DashSpeed, true, true);
 
-        // Set up collision detection (dash will be interrupted by collisions)
-        FCollisionShape CollisionShape = FCollisionShape::MakeSphere(100.0f); // Radius of 100 for detecting overlaps
-        TArray<FHitResult> HitResults;
-        FCollisionQueryParams Params;
-        Params.AddIgnoredActor(Character); // Ignore the player character
+        // Set up collision detection (dash will be interrupted by targets along the path)
+        const float DashHitRadius = 100.0f; // Radius of 100 for detecting overlaps
+        UCOTargetGridSubsystem* TargetGrid = GetWorld()->GetSubsystem<UCOTargetGridSubsystem>();
 
-        if (GetWorld()->SweepMultiByChannel(HitResults, Character->GetActorLocation(), DashDestination, FQuat::Identity, ECC_PhysicsBody, CollisionShape, Params))
+        if (ASC && TargetGrid && DashLevel == 3 && DamageGameplayEffectClass)
         {
-            for (const FHitResult& Hit : HitResults)
+            TArray<UAbilitySystemComponent*> Targets;
+            TargetGrid->QuerySegment(Character->GetActorLocation(), DashDestination, DashHitRadius, Targets, Character);
+
+            if (Targets.Num() > 0)
             {
-                AActor* HitActor = Hit.GetActor();
-                if (HitActor && DashLevel == 3 && DamageGameplayEffectClass)
-                {
-                    if (UAbilitySystemComponent* TargetASC = HitActor->FindComponentByClass<UAbilitySystemComponent>())
-                    {
-                        FGameplayEffectSpecHandle DamageSpecHandle = MakeOutgoingGameplayEffectSpec(DamageGameplayEffectClass, 1.0f);
-                        ASC->ApplyGameplayEffectSpecToTarget(*DamageSpecHandle.Data.Get(), TargetASC);
-                    }
-
-                    // Interrupt the dash if a collision occurs
-                    Character->GetCharacterMovement()->StopMovementImmediately();
-                    break;
-                }
+                // Targets are ordered along the dash, so the first one is the one we run into
+                FGameplayEffectSpecHandle DamageSpecHandle = MakeOutgoingGameplayEffectSpec(DamageGameplayEffectClass, 1.0f);
+                UCODamageAccumulatorSubsystem::QueueOrApplyDamageSpec(GetWorld(), *DamageSpecHandle.Data.Get(), Targets[0]);
+
+                // Interrupt the dash if a collision occurs
+                Character->GetCharacterMovement()->StopMovementImmediately();
             }
+
+            CO_TRACE_ABILITY_HITS(this, FMath::Min(Targets.Num(), 1), FMath::Min(Targets.Num(), 1));
         }
 
         // Maybe use a delay or Ability Task to end the ability properly
@@ -128,6 +135,8 @@ void UCelestialDashAbility::ActivateAbility(const FGameplayAbilitySpecHandle Han
  */
 bool UCelestialDashAbility::CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, FGameplayTagContainer* OptionalRelevantTags) const
 {
+    SCOPE_CYCLE_COUNTER(STAT_CO_CelestialDash_CanActivateAbility);
+
     if (!Super::CanActivateAbility(Handle, ActorInfo, SourceTags, TargetTags, OptionalRelevantTags))
     {
         return false; // If base class conditions aren't met, can't activate
@@ -137,13 +146,13 @@ bool UCelestialDashAbility::CanActivateAbility(const FGameplayAbilitySpecHandle
     UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get();
     if (ASC)
     {
-        if (ASC->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("Cooldown.Ability.CelestialDash"))))
+        if (ASC->HasMatchingGameplayTag(COGameplayTags::Cooldown_Ability_CelestialDash))
         {
             return false;
         }
 
         // Check if any ability is currently casting
-        if (ASC->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting"))))
+        if (ASC->HasMatchingGameplayTag(COGameplayTags::State_Casting))
         {
             return false;
         }
@@ -167,6 +176,6 @@ void UCelestialDashAbility::EndAbility(const FGameplayAbilitySpecHandle Handle,
 
     if (UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get())
     {
-        ASC->RemoveLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting")));
+        ASC->RemoveLooseGameplayTag(COGameplayTags::State_Casting);
     }
 }
@@ -1,8 +1,17 @@
 #include "CosmicStrikeAbility.h"
+#include "COGameplayTags.h"
+#include "COStats.h"
+#include "COTrace.h"
+#include "COCollisionChannels.h"
+#include "COLog.h"
 #include "GameFramework/Character.h"
+#include "Components/PrimitiveComponent.h"
 #include "AbilitySystemComponent.h"
 #include "TimerManager.h"
 
+DECLARE_CYCLE_STAT(TEXT("CosmicStrike ActivateAbility"), STAT_CO_CosmicStrike_ActivateAbility, STATGROUP_CelestialOdyssey);
+DECLARE_CYCLE_STAT(TEXT("CosmicStrike CanActivateAbility"), STAT_CO_CosmicStrike_CanActivateAbility, STATGROUP_CelestialOdyssey);
+
 /** Default constructor for UCosmicStrikeAbility */
 UCosmicStrikeAbility::UCosmicStrikeAbility()
 {
@@ -18,6 +27,9 @@ UCosmicStrikeAbility::UCosmicStrikeAbility()
  */
 void UCosmicStrikeAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
+    SCOPE_CYCLE_COUNTER(STAT_CO_CosmicStrike_ActivateAbility);
+    CO_TRACE_ABILITY_ACTIVATED(this);
+
     Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
 
     ACharacter* Character = Cast<ACharacter>(ActorInfo->AvatarActor.Get());
@@ -63,6 +75,8 @@ void UCosmicStrikeAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, c
  */
 bool UCosmicStrikeAbility::CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, FGameplayTagContainer* OptionalRelevantTags) const
 {
+    SCOPE_CYCLE_COUNTER(STAT_CO_CosmicStrike_CanActivateAbility);
+
     if (!Super::CanActivateAbility(Handle, ActorInfo, SourceTags, TargetTags, OptionalRelevantTags))
     {
         return false;
@@ -71,13 +85,13 @@ bool UCosmicStrikeAbility::CanActivateAbility(const FGameplayAbilitySpecHandle H
     UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get();
     if (ASC)
     {
-        if (ASC->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("Cooldown.Ability.CosmicStrike"))))
+        if (ASC->HasMatchingGameplayTag(COGameplayTags::Cooldown_Ability_CosmicStrike))
         {
             return false;
         }
 
         // Check if any ability is currently casting
-        if (ASC->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting"))))
+        if (ASC->HasMatchingGameplayTag(COGameplayTags::State_Casting))
         {
             return false;
         }
@@ -100,16 +114,18 @@ void UCosmicStrikeAbility::PerformAttack(ACharacter* Character)
         FCollisionQueryParams QueryParams;
         QueryParams.AddIgnoredActor(Character); // Ignore the player character itself
 
-        // Perform a line trace to check for an enemy in front of the player
+        // Perform a line trace to check for an enemy in front of the player; walls block this channel too
         bool bHit = Character->GetWorld()->LineTraceSingleByChannel(
             HitResult,
             StartLocation,
             EndLocation,
-            ECC_Visibility,
+            CO_TraceChannel_Enemy,
             QueryParams
         );
 
-        if (bHit && HitResult.GetActor())
+        // Only an enemy capsule counts as a target; anything else in the way stopped the strike
+        const UPrimitiveComponent* HitComponent = HitResult.GetComponent();
+        if (bHit && HitResult.GetActor() && HitComponent && HitComponent->GetCollisionObjectType() == CO_ObjectChannel_Enemy)
         {
             ACharacter* HitCharacter = Cast<ACharacter>(HitResult.GetActor());
             if (HitCharacter)
@@ -118,14 +134,14 @@ void UCosmicStrikeAbility::PerformAttack(ACharacter* Character)
                 {
                 case 1:
                     // Perform the basic three-hit combo
-                    UE_LOG(LogTemp, Log, TEXT("Performing Level 1: Basic three-hit combo"));
+                    CO_ABILITY_TRACE(TEXT("Performing Level 1: Basic three-hit combo"));
 
                     // Insert logic here for basic three-hit combo animations or effects.
                     break;
 
                 case 2:
                     // Perform the combo, adding a fourth hit with knockback
-                    UE_LOG(LogTemp, Log, TEXT("Performing Level 2: Four-hit combo with knockback"));
+                    CO_ABILITY_TRACE(TEXT("Performing Level 2: Four-hit combo with knockback"));
 
                     // Apply Knockback Effect to the enemy character
                     ApplyKnockbackEffect(HitCharacter);
@@ -133,7 +149,7 @@ void UCosmicStrikeAbility::PerformAttack(ACharacter* Character)
 
                 case 3:
                     // Perform the combo with an energy wave at the end
-                    UE_LOG(LogTemp, Log, TEXT("Performing Level 3: Four-hit combo with energy wave"));
+                    CO_ABILITY_TRACE(TEXT("Performing Level 3: Four-hit combo with energy wave"));
 
                     // Apply Knockback Effect to the enemy character
                     ApplyKnockbackEffect(HitCharacter);
@@ -143,14 +159,14 @@ void UCosmicStrikeAbility::PerformAttack(ACharacter* Character)
                     break;
 
                 default:
-                    UE_LOG(LogTemp, Warning, TEXT("Invalid ability level"));
+                    CO_LOG_RATE_LIMITED(5.0, Warning, TEXT("Invalid ability level"));
                     break;
                 }
             }
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("No enemy detected in front of the character"));
+            CO_ABILITY_TRACE(TEXT("No enemy detected in front of the character"));
         }
     }
 }
@@ -172,7 +188,7 @@ void UCosmicStrikeAbility::ApplyKnockbackEffect(ACharacter* HitCharacter)
 
         float KnockbackStrength = 1000.0f; // Adjust based on gameplay balance
         HitCharacter->LaunchCharacter(KnockbackDirection * KnockbackStrength, true, true);
-        UE_LOG(LogTemp, Log, TEXT("Applying knockback effect to the enemy character."));
+        CO_ABILITY_TRACE(TEXT("Applying knockback effect to the enemy character."));
     }
 }
 
@@ -188,6 +204,6 @@ void UCosmicStrikeAbility::TriggerEnergyWave(ACharacter* Character)
     if (Character)
     {
         // Logic for triggering energy wave.
-        UE_LOG(LogTemp, Log, TEXT("Triggering energy wave."));
+        CO_ABILITY_TRACE(TEXT("Triggering energy wave."));
     }
 }
@@ -1,9 +1,16 @@
 #include "CrystalGrowthAbility.h"
+#include "COGameplayTags.h"
+#include "COStats.h"
+#include "COTrace.h"
+#include "COCollisionChannels.h"
 #include "GameFramework/Character.h"
 #include "AbilitySystemComponent.h"
 #include "GameFramework/PlayerController.h"
 #include "Engine/World.h"
-#include "TimerManager.h"
+#include "COCrystalStructureSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("CrystalGrowth ActivateAbility"), STAT_CO_CrystalGrowth_ActivateAbility, STATGROUP_CelestialOdyssey);
+DECLARE_CYCLE_STAT(TEXT("CrystalGrowth CanActivateAbility"), STAT_CO_CrystalGrowth_CanActivateAbility, STATGROUP_CelestialOdyssey);
 
 UCrystalGrowthAbility::UCrystalGrowthAbility()
 {
@@ -14,10 +21,14 @@ UCrystalGrowthAbility::UCrystalGrowthAbility()
     CrystalDuration = 15.0f;
     MaxRange = 1000.0f;
     StructureType = ECrystalStructureType::Bridge;
+    CrystalMesh = nullptr;
 }
 
 void UCrystalGrowthAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
+    SCOPE_CYCLE_COUNTER(STAT_CO_CrystalGrowth_ActivateAbility);
+    CO_TRACE_ABILITY_ACTIVATED(this);
+
     Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
 
     if (!ActorInfo)
@@ -30,7 +41,7 @@ void UCrystalGrowthAbility::ActivateAbility(const FGameplayAbilitySpecHandle Han
     // Add casting tag
     if (UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get())
     {
-        ASC->AddLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting")));
+        ASC->AddLooseGameplayTag(COGameplayTags::State_Casting);
 
         // Apply cooldown
         if (CooldownEffectClass)
@@ -40,33 +51,28 @@ void UCrystalGrowthAbility::ActivateAbility(const FGameplayAbilitySpecHandle Han
         }
     }
 
-    // Get target location based on aim
-    FVector TargetLocation = GetTargetLocation(Character);
+    // Get target location and surface normal based on aim
+    FVector TargetLocation;
+    FVector SurfaceNormal = FVector::UpVector;
+    if (!TraceTargetSurface(Character, TargetLocation, SurfaceNormal))
+    {
+        TargetLocation = Character->GetActorLocation() + Character->GetActorForwardVector() * MaxRange;
+    }
 
-    // Calculate rotation based on surface normal (implement ray trace here)
-    FRotator TargetRotation = FRotator::ZeroRotator; // Default to level
+    // Lay the structure along the surface, growing in the direction the character faces
+    FRotator TargetRotation = FRotationMatrix::MakeFromZX(SurfaceNormal, Character->GetActorForwardVector()).Rotator();
 
-    // Spawn the crystal structure
+    // Spawn the crystal structure; the structure subsystem removes it after CrystalDuration
     SpawnCrystalStructure(TargetLocation, TargetRotation);
 
-    // Set timer to destroy crystals
-    FTimerHandle TimerHandle;
-    GetWorld()->GetTimerManager().SetTimer(
-        TimerHandle,
-        [this]()
-    {
-        // TODO: Implement crystal cleanup logic
-    },
-    CrystalDuration,
-    false
-    );
+    EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
 }
 
 void UCrystalGrowthAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled)
 {
     if (UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get())
     {
-        ASC->RemoveLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting")));
+        ASC->RemoveLooseGameplayTag(COGameplayTags::State_Casting);
     }
 
     Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
@@ -74,15 +80,17 @@ void UCrystalGrowthAbility::EndAbility(const FGameplayAbilitySpecHandle Handle,
 
 bool UCrystalGrowthAbility::CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, FGameplayTagContainer* OptionalRelevantTags) const
 {
+    SCOPE_CYCLE_COUNTER(STAT_CO_CrystalGrowth_CanActivateAbility);
+
     if (!Super::CanActivateAbility(Handle, ActorInfo, SourceTags, TargetTags, OptionalRelevantTags))
         return false;
 
     if (UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get())
     {
-        if (ASC->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("Cooldown.Ability.CrystalGrowth"))))
+        if (ASC->HasMatchingGameplayTag(COGameplayTags::Cooldown_Ability_CrystalGrowth))
             return false;
 
-        if (ASC->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting"))))
+        if (ASC->HasMatchingGameplayTag(COGameplayTags::State_Casting))
             return false;
     }
 
@@ -94,55 +102,80 @@ FVector UCrystalGrowthAbility::GetTargetLocation(ACharacter* Character) const
     if (!Character)
         return FVector::ZeroVector;
 
-    APlayerController* PC = Cast<APlayerController>(Character->GetController());
-    if (!PC)
+    FVector Location, Normal;
+    if (TraceTargetSurface(Character, Location, Normal))
+    {
+        return Location;
+    }
+
+    if (!Cast<APlayerController>(Character->GetController()))
         return FVector::ZeroVector;
 
+    return Character->GetActorLocation() + Character->GetActorForwardVector() * MaxRange;
+}
+
+bool UCrystalGrowthAbility::TraceTargetSurface(ACharacter* Character, FVector& OutLocation, FVector& OutNormal) const
+{
+    APlayerController* PC = Character ? Cast<APlayerController>(Character->GetController()) : nullptr;
+    if (!PC)
+        return false;
+
     // Get mouse cursor location in world space
     FVector WorldLocation, WorldDirection;
-    if (PC->DeprojectMousePositionToWorld(WorldLocation, WorldDirection))
-    {
-        FHitResult HitResult;
-        FVector TraceStart = WorldLocation;
-        FVector TraceEnd = WorldLocation + WorldDirection * MaxRange;
+    if (!PC->DeprojectMousePositionToWorld(WorldLocation, WorldDirection))
+        return false;
 
-        FCollisionQueryParams QueryParams;
-        QueryParams.AddIgnoredActor(Character);
+    FHitResult HitResult;
+    FVector TraceStart = WorldLocation;
+    FVector TraceEnd = WorldLocation + WorldDirection * MaxRange;
 
-        if (GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECC_Visibility, QueryParams))
-        {
-            return HitResult.Location;
-        }
-    }
+    FCollisionQueryParams QueryParams;
+    QueryParams.AddIgnoredActor(Character);
 
-    return Character->GetActorLocation() + Character->GetActorForwardVector() * MaxRange;
+    // World geometry and existing crystals block this channel; pawns and triggers do not
+    if (!GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, CO_TraceChannel_CrystalSurface, QueryParams))
+        return false;
+
+    OutLocation = HitResult.Location;
+    OutNormal = HitResult.ImpactNormal;
+    return true;
 }
 
 void UCrystalGrowthAbility::SpawnCrystalStructure(const FVector& Location, const FRotator& Rotation)
 {
-    // This would be implemented in Blueprint to spawn the actual crystal mesh/actor
-    // The implementation depends on your specific crystal structure assets
+    if (!GetWorld())
+        return;
 
-    // Different structure types and complexity based on growth level
+    // Different structure types and complexity based on growth level; the configured type is left untouched
+    // so the ability grows the intended structure again once it levels up
+    ECrystalStructureType SpawnType = StructureType;
     switch (GrowthLevel)
     {
     case 1:
         // Basic structures only
-        if (StructureType != ECrystalStructureType::Bridge &&
-            StructureType != ECrystalStructureType::Platform)
+        if (SpawnType != ECrystalStructureType::Bridge &&
+            SpawnType != ECrystalStructureType::Platform)
         {
-            StructureType = ECrystalStructureType::Bridge;
+            SpawnType = ECrystalStructureType::Bridge;
         }
         break;
 
     case 2:
-        // Add more complex structures
-        // Implementation for spiral staircases and arches
+        // Walls and staircases, but no encasement yet
+        if (SpawnType == ECrystalStructureType::Encasement)
+        {
+            SpawnType = ECrystalStructureType::Wall;
+        }
         break;
 
-    case 3:
+    default:
         // All structure types available
-        // Add encasement functionality
         break;
     }
-}
\ No newline at end of file
+
+    if (UCOCrystalStructureSubsystem* CrystalStructures = GetWorld()->GetSubsystem<UCOCrystalStructureSubsystem>())
+    {
+        CrystalStructures->SetSegmentMesh(CrystalMesh);
+        CrystalStructures->SpawnStructure(SpawnType, GrowthLevel, Location, Rotation, CrystalDuration);
+    }
+}
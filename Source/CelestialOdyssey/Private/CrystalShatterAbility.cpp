@@ -1,9 +1,20 @@
 #include "CrystalShatterAbility.h"
+#include "COGameplayTags.h"
+#include "COStats.h"
+#include "COTrace.h"
+#include "COTargetGridSubsystem.h"
+#include "COAreaFieldSubsystem.h"
+#include "CODamageAccumulatorSubsystem.h"
+#include "COFragmentSubsystem.h"
+#include "COStatusEffectSubsystem.h"
 #include "GameFramework/Character.h"
 #include "AbilitySystemComponent.h"
 #include "GameFramework/PlayerController.h"
 #include "Engine/World.h"
-#include "TimerManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("CrystalShatter ActivateAbility"), STAT_CO_CrystalShatter_ActivateAbility, STATGROUP_CelestialOdyssey);
+DECLARE_CYCLE_STAT(TEXT("CrystalShatter CanActivateAbility"), STAT_CO_CrystalShatter_CanActivateAbility, STATGROUP_CelestialOdyssey);
+DECLARE_CYCLE_STAT(TEXT("CrystalShatter PerformShatter"), STAT_CO_CrystalShatter_PerformShatter, STATGROUP_CelestialOdyssey);
 
 UCrystalShatterAbility::UCrystalShatterAbility()
 {
@@ -14,12 +25,21 @@ UCrystalShatterAbility::UCrystalShatterAbility()
     SlowFieldDuration = 5.0f;
     ShatterRadius = 500.0f;
     BaseDamage = 50.0f;
+    NumFragments = 8;
+    FragmentSpeed = 500.0f;
+    FragmentMaxBounces = 2;
+    FragmentLifetime = 3.0f;
+    FragmentDamageScale = 0.25f;
+    FragmentMesh = nullptr;
 }
 
 // Continuing CrystalShatterAbility.cpp
 
 void UCrystalShatterAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
+    SCOPE_CYCLE_COUNTER(STAT_CO_CrystalShatter_ActivateAbility);
+    CO_TRACE_ABILITY_ACTIVATED(this);
+
     Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
 
     if (!ActorInfo)
@@ -32,7 +52,7 @@ void UCrystalShatterAbility::ActivateAbility(const FGameplayAbilitySpecHandle Ha
     // Add casting tag
     if (UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get())
     {
-        ASC->AddLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting")));
+        ASC->AddLooseGameplayTag(COGameplayTags::State_Casting);
 
         // Apply cooldown
         if (CooldownEffectClass)
@@ -53,7 +73,7 @@ void UCrystalShatterAbility::EndAbility(const FGameplayAbilitySpecHandle Handle,
 {
     if (UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get())
     {
-        ASC->RemoveLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting")));
+        ASC->RemoveLooseGameplayTag(COGameplayTags::State_Casting);
     }
 
     Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
@@ -61,15 +81,17 @@ void UCrystalShatterAbility::EndAbility(const FGameplayAbilitySpecHandle Handle,
 
 bool UCrystalShatterAbility::CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, FGameplayTagContainer* OptionalRelevantTags) const
 {
+    SCOPE_CYCLE_COUNTER(STAT_CO_CrystalShatter_CanActivateAbility);
+
     if (!Super::CanActivateAbility(Handle, ActorInfo, SourceTags, TargetTags, OptionalRelevantTags))
         return false;
 
     if (UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get())
     {
-        if (ASC->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("Cooldown.Ability.CrystalShatter"))))
+        if (ASC->HasMatchingGameplayTag(COGameplayTags::Cooldown_Ability_CrystalShatter))
             return false;
 
-        if (ASC->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting"))))
+        if (ASC->HasMatchingGameplayTag(COGameplayTags::State_Casting))
             return false;
     }
 
@@ -78,6 +100,8 @@ bool UCrystalShatterAbility::CanActivateAbility(const FGameplayAbilitySpecHandle
 
 void UCrystalShatterAbility::PerformShatter(const FVector& Location)
 {
+    SCOPE_CYCLE_COUNTER(STAT_CO_CrystalShatter_PerformShatter);
+
     if (!GetWorld())
         return;
 
@@ -97,38 +121,39 @@ void UCrystalShatterAbility::PerformShatter(const FVector& Location)
         break;
     }
 
-    // Detect affected actors
-    TArray<FHitResult> HitResults;
-    FCollisionShape CollisionShape = FCollisionShape::MakeSphere(CurrentRadius);
-    FCollisionQueryParams QueryParams;
-    QueryParams.AddIgnoredActor(GetOwningActorFromActorInfo());
-
-    if (GetWorld()->SweepMultiByChannel(HitResults, Location, Location, FQuat::Identity, ECC_Pawn, CollisionShape, QueryParams))
+    // Detect affected targets
+    if (UCOTargetGridSubsystem* TargetGrid = GetWorld()->GetSubsystem<UCOTargetGridSubsystem>())
     {
-        for (const FHitResult& Hit : HitResults)
+        TArray<UAbilitySystemComponent*> Targets;
+        TargetGrid->QueryCircle(Location, CurrentRadius, Targets, GetOwningActorFromActorInfo());
+
+        // Build each spec once per activation and share it between all targets
+        FGameplayEffectSpecHandle DamageSpec;
+        if (DamageEffectClass && Targets.Num() > 0)
+        {
+            DamageSpec = MakeOutgoingGameplayEffectSpec(DamageEffectClass, GetAbilityLevel());
+            DamageSpec.Data->SetSetByCallerMagnitude(COGameplayTags::Data_Damage, CurrentDamage);
+        }
+
+        // Apply DoT for level 2+
+        FGameplayEffectSpecHandle DoTSpec;
+        if (ShatterLevel >= 2 && DoTEffectClass && Targets.Num() > 0)
+        {
+            DoTSpec = MakeOutgoingGameplayEffectSpec(DoTEffectClass, GetAbilityLevel());
+        }
+
+        // Initial damage is coalesced with any other hit the targets take this frame
+        if (DamageSpec.IsValid())
+        {
+            UCODamageAccumulatorSubsystem::QueueOrApplyDamageSpec(GetWorld(), *DamageSpec.Data.Get(), Targets);
+        }
+
+        if (DoTSpec.IsValid())
         {
-            AActor* HitActor = Hit.GetActor();
-            if (!HitActor || HitActor == GetOwningActorFromActorInfo())
-                continue;
-
-            if (UAbilitySystemComponent* TargetASC = HitActor->FindComponentByClass<UAbilitySystemComponent>())
-            {
-                // Apply initial damage
-                if (DamageEffectClass)
-                {
-                    FGameplayEffectSpecHandle DamageSpec = MakeOutgoingGameplayEffectSpec(DamageEffectClass, GetAbilityLevel());
-                    DamageSpec.Data->SetSetByCallerMagnitude(FGameplayTag::RequestGameplayTag(FName("Data.Damage")), CurrentDamage);
-                    TargetASC->ApplyGameplayEffectSpecToSelf(*DamageSpec.Data.Get());
-                }
-
-                // Apply DoT for level 2+
-                if (ShatterLevel >= 2 && DoTEffectClass)
-                {
-                    FGameplayEffectSpecHandle DoTSpec = MakeOutgoingGameplayEffectSpec(DoTEffectClass, GetAbilityLevel());
-                    TargetASC->ApplyGameplayEffectSpecToSelf(*DoTSpec.Data.Get());
-                }
-            }
+            UCOStatusEffectSubsystem::ApplyStatusOrEffect(GetWorld(), ECOStatusType::DamageOverTime, *DoTSpec.Data.Get(), Targets);
         }
+
+        CO_TRACE_ABILITY_HITS(this, Targets.Num(), Targets.Num() * (int32(DamageSpec.IsValid()) + int32(DoTSpec.IsValid())));
     }
 
     // Create slow field
@@ -143,75 +168,33 @@ void UCrystalShatterAbility::PerformShatter(const FVector& Location)
 
 void UCrystalShatterAbility::CreateSlowField(const FVector& Location)
 {
-    if (!GetWorld())
+    if (!GetWorld() || !SlowEffectClass)
         return;
 
-    FTimerDelegate PeriodicCheckDelegate;
-    PeriodicCheckDelegate.BindLambda([this, Location]()
-    {
-        if (!GetWorld())
-            return;
-
-        TArray<FHitResult> HitResults;
-        FCollisionShape CollisionShape = FCollisionShape::MakeSphere(ShatterRadius);
-        FCollisionQueryParams QueryParams;
-        QueryParams.AddIgnoredActor(GetOwningActorFromActorInfo());
-
-        if (GetWorld()->SweepMultiByChannel(HitResults, Location, Location, FQuat::Identity, ECC_Pawn, CollisionShape, QueryParams))
-        {
-            for (const FHitResult& Hit : HitResults)
-            {
-                if (UAbilitySystemComponent* TargetASC = Hit.GetActor()->FindComponentByClass<UAbilitySystemComponent>())
-                {
-                    if (SlowEffectClass)
-                    {
-                        FGameplayEffectSpecHandle SlowSpec = MakeOutgoingGameplayEffectSpec(SlowEffectClass, GetAbilityLevel());
-                        TargetASC->ApplyGameplayEffectSpecToSelf(*SlowSpec.Data.Get());
-                    }
-                }
-            }
-        }
-    });
-
-    // Start the periodic check
-    GetWorld()->GetTimerManager().SetTimer(
-        SlowFieldTimerHandle,
-        PeriodicCheckDelegate,
-        0.5f,  // Check every half second
-        true   // Looping
-    );
-
-    // Create timer to clear the slow field
-    FTimerHandle CleanupTimerHandle;
-    FTimerDelegate CleanupDelegate;
-    CleanupDelegate.BindLambda([this]()
+    // The field subsystem applies the slow when targets enter and removes it when they leave
+    if (UCOAreaFieldSubsystem* AreaFields = GetWorld()->GetSubsystem<UCOAreaFieldSubsystem>())
     {
-        if (GetWorld())
-        {
-            GetWorld()->GetTimerManager().ClearTimer(SlowFieldTimerHandle);
-        }
-    });
-
-    GetWorld()->GetTimerManager().SetTimer(
-        CleanupTimerHandle,
-        CleanupDelegate,
-        SlowFieldDuration,
-        false
-    );
+        FGameplayEffectSpecHandle SlowSpec = MakeOutgoingGameplayEffectSpec(SlowEffectClass, GetAbilityLevel());
+        AreaFields->AddField(Location, ShatterRadius, SlowFieldDuration, SlowSpec, GetOwningActorFromActorInfo());
+    }
 }
 
 void UCrystalShatterAbility::LaunchFragments(const FVector& Origin)
 {
-    const int32 NumFragments = 8; // Number of fragments to launch
-    const float FragmentSpeed = 500.0f;
+    if (!GetWorld())
+        return;
 
-    for (int32 i = 0; i < NumFragments; ++i)
+    // Fragments are simulated and drawn by the fragment subsystem, no actors are spawned
+    if (UCOFragmentSubsystem* Fragments = GetWorld()->GetSubsystem<UCOFragmentSubsystem>())
     {
-        // Calculate fragment direction (evenly spaced around a circle)
-        float Angle = (2.0f * PI * i) / NumFragments;
-        FVector Direction(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f);
+        FGameplayEffectSpecHandle FragmentSpec;
+        if (DamageEffectClass)
+        {
+            FragmentSpec = MakeOutgoingGameplayEffectSpec(DamageEffectClass, GetAbilityLevel());
+            FragmentSpec.Data->SetSetByCallerMagnitude(COGameplayTags::Data_Damage, BaseDamage * FragmentDamageScale);
+        }
 
-        // Spawn fragment actor/projectile (implement in Blueprint)
-        // The fragment should have its own collision detection for ricochets
+        Fragments->SetFragmentMesh(FragmentMesh);
+        Fragments->LaunchRadial(Origin, NumFragments, FragmentSpeed, FragmentMaxBounces, FragmentLifetime, FragmentSpec, GetOwningActorFromActorInfo());
     }
-}
\ No newline at end of file
+}
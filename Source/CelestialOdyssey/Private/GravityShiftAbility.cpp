@@ -1,12 +1,21 @@
 #include "GravityShiftAbility.h"
+#include "COGameplayTags.h"
+#include "COStats.h"
+#include "COTrace.h"
+#include "COCollisionChannels.h"
 #include "GameFramework/Character.h"
 #include "AbilitySystemComponent.h"
-#include "GameFramework/CharacterMovementComponent.h"
-#include "TimerManager.h"
+#include "COCharacterMovementComponent.h"
+#include "COExpirySubsystem.h"
 #include "Components/CapsuleComponent.h"
+#include "GameFramework/PhysicsVolume.h"
 #include "COPlayerCharacter.h"
 #include "GameplayEffect.h"
 
+DECLARE_CYCLE_STAT(TEXT("GravityShift ActivateAbility"), STAT_CO_GravityShift_ActivateAbility, STATGROUP_CelestialOdyssey);
+DECLARE_CYCLE_STAT(TEXT("GravityShift CanActivateAbility"), STAT_CO_GravityShift_CanActivateAbility, STATGROUP_CelestialOdyssey);
+DECLARE_CYCLE_STAT(TEXT("GravityShift Ceiling Check"), STAT_CO_GravityShift_CeilingCheck, STATGROUP_CelestialOdyssey);
+
 /** Default constructor for UGravityShiftAbility */
 UGravityShiftAbility::UGravityShiftAbility()
 {
@@ -25,13 +34,16 @@ UGravityShiftAbility::UGravityShiftAbility()
  */
 void UGravityShiftAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
+    SCOPE_CYCLE_COUNTER(STAT_CO_GravityShift_ActivateAbility);
+    CO_TRACE_ABILITY_ACTIVATED(this);
+
     Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
 
     UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get();
     if (ASC)
     {
-        ASC->AddLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting")));
-        ASC->AddLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.GravityInverted")));
+        ASC->AddLooseGameplayTag(COGameplayTags::State_Casting);
+        ASC->AddLooseGameplayTag(COGameplayTags::State_GravityInverted);
     }
 
     ACharacter* Character = Cast<ACharacter>(ActorInfo->AvatarActor.Get());
@@ -58,30 +70,33 @@ void UGravityShiftAbility::ActivateAbility(const FGameplayAbilitySpecHandle Hand
         DefaultCapsuleRadius = Character->GetCapsuleComponent()->GetUnscaledCapsuleRadius();
         DefaultCapsuleHeight = Character->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight();
 
-        // Invert gravity
-        Character->GetCharacterMovement()->GravityScale = -1.0f;
+        // Invert gravity; the movement component rolls the capsule so the mesh follows without re-offsetting
+        if (UCOCharacterMovementComponent* Movement = Cast<UCOCharacterMovementComponent>(Character->GetCharacterMovement()))
+        {
+            Movement->SetGravityInverted(true);
+        }
 
         // Set an upward impulse to move the character towards the ceiling
         FVector Impulse = FVector(0.f, 0.f, 5000.f);
         Character->LaunchCharacter(Impulse, true, true);
 
-        // Rotate character mesh to align with ceiling
-        RotateCharacter(Character, true);
+        // The movement sweep reports the ceiling contact; no polling needed
+        BindCeilingContactEvents(Character);
 
-        // Set a timer to continuously check for ceiling collision
-        Character->GetWorldTimerManager().SetTimer(
-            CeilingCheckTimerHandle,
-            FTimerDelegate::CreateUObject(this, &UGravityShiftAbility::CheckForCeilingContact, Character),
-            0.1f, // Frequency of check (every 0.1 seconds)
-            true); // Loop the timer
+        if (bPredictCeilingContact)
+        {
+            if (ACOPlayerCharacter* PlayerCharacter = Cast<ACOPlayerCharacter>(Character))
+            {
+                const float TimeToContact = PredictCeilingContactTime(Character, Impulse.Z);
+                PlayerCharacter->SetPredictedCeilingContactTime(TimeToContact >= 0.0f ? GetWorld()->GetTimeSeconds() + TimeToContact : -1.0f);
+            }
+        }
 
-        // Set a timer to revert gravity after the specified duration
-        FTimerHandle TimerHandle;
-        Character->GetWorldTimerManager().SetTimer(
-            TimerHandle,
-            FTimerDelegate::CreateUObject(this, &UGravityShiftAbility::RevertGravity, Character),
-            GravityShiftDuration,
-            false);
+        // Schedule reverting gravity after the specified duration
+        if (UCOExpirySubsystem* Expiries = GetWorld()->GetSubsystem<UCOExpirySubsystem>())
+        {
+            Expiries->ScheduleCallback(GravityShiftDuration, FSimpleDelegate::CreateUObject(this, &UGravityShiftAbility::RevertGravity, Character));
+        }
 
         // Apply cooldown effect
         if (CooldownEffect && ASC)
@@ -99,16 +114,15 @@ void UGravityShiftAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, c
 {
     Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
 
-    //ACharacter* Character = Cast<ACharacter>(ActorInfo->AvatarActor.Get());
-    //RotateCharacter(Character, true);
+    UnbindCeilingContactEvents();
 
     UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get();
     if (ASC)
     {
-        ASC->RemoveLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting")));
-        ASC->RemoveLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.GravityInverted")));
-        ASC->RemoveLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting")));
-        ASC->RemoveLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("Cooldown.Active")));
+        ASC->RemoveLooseGameplayTag(COGameplayTags::State_Casting);
+        ASC->RemoveLooseGameplayTag(COGameplayTags::State_GravityInverted);
+        ASC->RemoveLooseGameplayTag(COGameplayTags::State_Casting);
+        ASC->RemoveLooseGameplayTag(COGameplayTags::Cooldown_Active);
     }
 }
 
@@ -123,61 +137,29 @@ void UGravityShiftAbility::RevertGravity(ACharacter* Character)
         if (PlayerCharacter)
         {
             PlayerCharacter->SetHasReachedCeiling(false);
+            PlayerCharacter->SetPredictedCeilingContactTime(-1.0f);
         }
 
-        // Revert gravity scale to original
-        Character->GetCharacterMovement()->GravityScale = 1.0f;
+        UnbindCeilingContactEvents();
 
-        // Reset the character's rotation to default
-        RotateCharacter(Character, false);
+        // Restore downward gravity and the upright capsule
+        if (UCOCharacterMovementComponent* Movement = Cast<UCOCharacterMovementComponent>(Character->GetCharacterMovement()))
+        {
+            Movement->SetGravityInverted(false);
+        }
 
         // Properly end the ability
         EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, false);
     }
 }
 
-/**
- * @brief Rotates the character to align with gravity shift.
- */
-void UGravityShiftAbility::RotateCharacter(ACharacter* Character, bool bIsGravityInverted)
-{
-    if (Character)
-    {
-        USkeletalMeshComponent* Mesh = Character->GetMesh();
-        if (Mesh)
-        {
-            FRotator NewRotation = Mesh->GetRelativeRotation();
-            FVector NewLocation = Mesh->GetRelativeLocation();
-
-            if (bIsGravityInverted)
-            {
-                // Rotate character 180 degrees to invert
-                NewRotation.Roll = 180.0f;
-
-                // Move the mesh up to align with the collision capsule (correct for pivot at the feet)
-                NewLocation.Z += Character->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() * 2.0f;
-            }
-            else
-            {
-                // Reset character orientation
-                NewRotation.Roll = 0.0f;
-
-                // Move the mesh back to the original position
-                NewLocation.Z -= Character->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() * 2.0f;
-            }
-
-            // Apply the new rotation and location
-            Mesh->SetRelativeRotation(NewRotation);
-            Mesh->SetRelativeLocation(NewLocation);
-        }
-    }
-}
-
 /**
  * @brief Determines if the ability can be activated.
  */
 bool UGravityShiftAbility::CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, FGameplayTagContainer* OptionalRelevantTags) const
 {
+    SCOPE_CYCLE_COUNTER(STAT_CO_GravityShift_CanActivateAbility);
+
     if (!Super::CanActivateAbility(Handle, ActorInfo, SourceTags, TargetTags, OptionalRelevantTags))
     {
         return false;
@@ -186,13 +168,13 @@ bool UGravityShiftAbility::CanActivateAbility(const FGameplayAbilitySpecHandle H
     UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get();
     if (ASC)
     {
-        if (ASC->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("Cooldown.Ability.GravityShift"))))
+        if (ASC->HasMatchingGameplayTag(COGameplayTags::Cooldown_Ability_GravityShift))
         {
             return false;
         }
 
         // Check if any ability is currently casting
-        if (ASC->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting"))))
+        if (ASC->HasMatchingGameplayTag(COGameplayTags::State_Casting))
         {
             return false;
         }
@@ -202,38 +184,114 @@ bool UGravityShiftAbility::CanActivateAbility(const FGameplayAbilitySpecHandle H
 }
 
 /**
- * @brief Checks if the character has reached the ceiling by performing a line trace upwards.
+ * @brief Starts listening for the capsule touching the ceiling.
  *
- * This function is called periodically after activating the gravity shift ability. It performs a line trace
- * to detect if there is a ceiling above the character. If the ceiling is reached, it stops further checking
- * and sets a flag indicating that the ceiling was reached.
+ * The character movement sweep dispatches a blocking hit on the capsule whenever it runs into geometry,
+ * so the ceiling contact arrives as an event instead of being polled with traces. Landed covers the case
+ * where the movement component treats the ceiling as a floor under inverted gravity.
  *
- * @param Character The character whose ceiling collision is being checked.
+ * @param Character The character whose gravity was inverted.
+ */
+void UGravityShiftAbility::BindCeilingContactEvents(ACharacter* Character)
+{
+    UnbindCeilingContactEvents();
+
+    if (!Character)
+    {
+        return;
+    }
+
+    ContactCharacter = Character;
+    Character->GetCapsuleComponent()->OnComponentHit.AddDynamic(this, &UGravityShiftAbility::OnCapsuleHit);
+    Character->LandedDelegate.AddDynamic(this, &UGravityShiftAbility::OnCharacterLanded);
+}
+
+/**
+ * @brief Stops listening for ceiling contacts.
  */
+void UGravityShiftAbility::UnbindCeilingContactEvents()
+{
+    if (ACharacter* Character = ContactCharacter.Get())
+    {
+        Character->GetCapsuleComponent()->OnComponentHit.RemoveDynamic(this, &UGravityShiftAbility::OnCapsuleHit);
+        Character->LandedDelegate.RemoveDynamic(this, &UGravityShiftAbility::OnCharacterLanded);
+    }
+
+    ContactCharacter.Reset();
+}
 
-void UGravityShiftAbility::CheckForCeilingContact(ACharacter* Character)
+/**
+ * @brief Flags the ceiling as reached and unbinds the contact events.
+ */
+void UGravityShiftAbility::HandleCeilingContact()
 {
-    if (Character)
+    if (ACOPlayerCharacter* PlayerCharacter = Cast<ACOPlayerCharacter>(ContactCharacter.Get()))
     {
-        ACOPlayerCharacter* PlayerCharacter = Cast<ACOPlayerCharacter>(Character);
-        // Line trace to detect ceiling collision
-        FVector Start = Character->GetActorLocation();
-        FVector End = Start + FVector(0.f, 0.f, 500.f); // Trace 500 units upward 
+        PlayerCharacter->SetHasReachedCeiling(true);
+        PlayerCharacter->SetPredictedCeilingContactTime(-1.0f);
+    }
 
-        FHitResult HitResult;
-        FCollisionQueryParams CollisionParams;
-        CollisionParams.AddIgnoredActor(Character); // Ignore the character itself
+    UnbindCeilingContactEvents();
+}
 
-        // Perform the line trace
-        bool bHit = Character->GetWorld()->LineTraceSingleByChannel(HitResult, Start, End, ECC_Visibility, CollisionParams);
+/**
+ * @brief Capsule blocking hit; only surfaces facing downwards count as the ceiling.
+ */
+void UGravityShiftAbility::OnCapsuleHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+{
+    SCOPE_CYCLE_COUNTER(STAT_CO_GravityShift_CeilingCheck);
 
-        if (PlayerCharacter && bHit && HitResult.bBlockingHit)
-        {
-            // We hit something above, assume it's the ceiling
-            PlayerCharacter->SetHasReachedCeiling(true);
+    if (Hit.ImpactNormal.Z < -0.7f)
+    {
+        HandleCeilingContact();
+    }
+}
 
-            // Stop checking since we reached the ceiling
-            Character->GetWorldTimerManager().ClearTimer(CeilingCheckTimerHandle);
-        }
+/**
+ * @brief Landing while gravity is inverted means the character has settled on the ceiling.
+ */
+void UGravityShiftAbility::OnCharacterLanded(const FHitResult& Hit)
+{
+    HandleCeilingContact();
+}
+
+/**
+ * @brief Estimates the time for the launch to carry the capsule to the ceiling.
+ *
+ * Traces once straight up from the top of the capsule, then integrates the launch under the inverted
+ * gravity: constant acceleration until the physics volume's terminal velocity is reached, constant speed after.
+ *
+ * @param Character The launched character.
+ * @param LaunchSpeed Upward launch speed in cm/s.
+ * @return Seconds until contact, or -1 when no ceiling was found within CeilingPredictionDistance.
+ */
+float UGravityShiftAbility::PredictCeilingContactTime(const ACharacter* Character, float LaunchSpeed) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_CO_GravityShift_CeilingCheck);
+
+    const UCharacterMovementComponent* Movement = Character->GetCharacterMovement();
+    const FVector Start = Character->GetActorLocation() + FVector(0.f, 0.f, Character->GetCapsuleComponent()->GetScaledCapsuleHalfHeight());
+    const FVector End = Start + FVector(0.f, 0.f, CeilingPredictionDistance);
+
+    FHitResult HitResult;
+    FCollisionQueryParams CollisionParams(SCENE_QUERY_STAT(GravityShiftCeiling), false, Character);
+    if (!GetWorld()->LineTraceSingleByObjectType(HitResult, Start, End, COCollision::MakeWorldGeometryParams(), CollisionParams))
+    {
+        return -1.0f;
     }
-}
\ No newline at end of file
+
+    const float Distance = HitResult.Distance;
+    const float Acceleration = FMath::Max(FMath::Abs(Movement->GetGravityZ()), UE_KINDA_SMALL_NUMBER);
+    const float TerminalSpeed = FMath::Abs(Movement->GetPhysicsVolume()->TerminalVelocity);
+    const float InitialSpeed = FMath::Min(LaunchSpeed, TerminalSpeed);
+
+    // Accelerating phase: d = v0*t + a*t^2/2 until terminal speed is reached
+    const float TimeToTerminal = (TerminalSpeed - InitialSpeed) / Acceleration;
+    const float DistanceToTerminal = InitialSpeed * TimeToTerminal + 0.5f * Acceleration * TimeToTerminal * TimeToTerminal;
+    if (Distance <= DistanceToTerminal)
+    {
+        return (FMath::Sqrt(InitialSpeed * InitialSpeed + 2.0f * Acceleration * Distance) - InitialSpeed) / Acceleration;
+    }
+
+    return TimeToTerminal + (Distance - DistanceToTerminal) / FMath::Max(TerminalSpeed, UE_KINDA_SMALL_NUMBER);
+}
@@ -1,8 +1,24 @@
 #include "GroundSlamAbility.h"
+#include "COGameplayTags.h"
+#include "COStats.h"
+#include "COTrace.h"
+#include "COCollisionChannels.h"
+#include "COTargetGridSubsystem.h"
+#include "CODamageAccumulatorSubsystem.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "AbilitySystemComponent.h"
-#include "Kismet/GameplayStatics.h"
+#include "Engine/OverlapResult.h"
+#include "COStatusEffectSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("GroundSlam ActivateAbility"), STAT_CO_GroundSlam_ActivateAbility, STATGROUP_CelestialOdyssey);
+DECLARE_CYCLE_STAT(TEXT("GroundSlam CanActivateAbility"), STAT_CO_GroundSlam_CanActivateAbility, STATGROUP_CelestialOdyssey);
+
+namespace
+{
+    /** Actor tag breakable props carried before the Breakable object type existed */
+    const FName BreakableActorTag(TEXT("Environment.Breakable"));
+}
 
 /** Default constructor for UGroundSlamAbility */
 UGroundSlamAbility::UGroundSlamAbility()
@@ -13,6 +29,7 @@ UGroundSlamAbility::UGroundSlamAbility()
     GroundSlamLevel = 1;
     GroundSlamDamage = 50.0f;
     GroundSlamRadius = 300.0f;
+    GroundSlamStunDuration = 2.0f;
 }
 
 /**
@@ -28,11 +45,14 @@ UGroundSlamAbility::UGroundSlamAbility()
  */
 void UGroundSlamAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
+    SCOPE_CYCLE_COUNTER(STAT_CO_GroundSlam_ActivateAbility);
+    CO_TRACE_ABILITY_ACTIVATED(this);
+
     Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
 
     if (UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get())
     {
-        ASC->AddLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting")));
+        ASC->AddLooseGameplayTag(COGameplayTags::State_Casting);
     }
 
     ACharacter* Character = Cast<ACharacter>(ActorInfo->AvatarActor.Get());
@@ -59,87 +79,84 @@ void UGroundSlamAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle
             break;
         }
 
-        // Create the shockwave effect using a sphere collision
-        FVector SlamLocation = Character->GetActorLocation();
-        TArray<AActor*> IgnoredActors;
-        IgnoredActors.Add(Character);
+        // Create the shockwave with a single overlap query over enemies and, at level 3, breakable props
+        const FVector SlamLocation = Character->GetActorLocation();
+        const bool bAffectsBreakables = GroundSlamLevel == 3;
 
-        
-        if (GroundSlamDamageEffect)
+        // Props not yet moved to CO_Breakable are still found by their Environment.Breakable actor tag, on the
+        // WorldDynamic object type they used before
+        FCollisionObjectQueryParams ObjectQueryParams;
+        ObjectQueryParams.AddObjectTypesToQuery(CO_ObjectChannel_Enemy);
+        if (bAffectsBreakables)
         {
-            FGameplayEffectSpecHandle DamageSpecHandle = MakeOutgoingGameplayEffectSpec(GroundSlamDamageEffect, 1.0f);
-            UGameplayStatics::ApplyRadialDamage(
-                this,
-                GroundSlamDamage,
-                SlamLocation,
-                GroundSlamRadius,
-                nullptr, // Use default damage type or create a custom damage class
-                IgnoredActors,
-                Character,
-                Character->GetController(),
-                false // Damage is the same throughout the entire shockwave radius
-            );
+            ObjectQueryParams.AddObjectTypesToQuery(CO_ObjectChannel_Breakable);
+            ObjectQueryParams.AddObjectTypesToQuery(ECC_WorldDynamic);
         }
 
-        //Stun effect if level 3
-        if (GroundSlamLevel == 3 && GroundSlamStunEffect)
+        FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(GroundSlam), false, Character);
+
+        TArray<FOverlapResult> Overlaps;
+        GetWorld()->OverlapMultiByObjectType(Overlaps, SlamLocation, FQuat::Identity, ObjectQueryParams, FCollisionShape::MakeSphere(GroundSlamRadius), QueryParams);
+
+        // Sort the overlaps once into ability targets and breakables
+        UCOTargetGridSubsystem* TargetGrid = GetWorld()->GetSubsystem<UCOTargetGridSubsystem>();
+        TArray<UAbilitySystemComponent*, TInlineAllocator<16>> Targets;
+        TArray<AActor*, TInlineAllocator<8>> Breakables;
+
+        for (const FOverlapResult& Overlap : Overlaps)
         {
-            TArray<FHitResult> HitResults;
-            FCollisionShape CollisionShape = FCollisionShape::MakeSphere(GroundSlamRadius);
-            if (GetWorld()->SweepMultiByChannel(HitResults, SlamLocation, SlamLocation, FQuat::Identity, ECC_Pawn, CollisionShape))
+            AActor* HitActor = Overlap.GetActor();
+            if (!HitActor)
+            {
+                continue;
+            }
+
+            // Breakables are only queried at level 3
+            const UPrimitiveComponent* HitComponent = Overlap.GetComponent();
+            const bool bBreakable = (HitComponent && HitComponent->GetCollisionObjectType() == CO_ObjectChannel_Breakable)
+                || HitActor->ActorHasTag(BreakableActorTag);
+            if (bBreakable)
+            {
+                Breakables.AddUnique(HitActor);
+            }
+            else if (UAbilitySystemComponent* TargetASC = TargetGrid ? TargetGrid->FindAbilitySystemComponent(HitActor) : nullptr)
             {
-                for (const FHitResult& Hit : HitResults)
-                {
-                    AActor* HitActor = Hit.GetActor();
-                    if (HitActor && HitActor != Character)
-                    {
-                        if (UAbilitySystemComponent* TargetASC = HitActor->FindComponentByClass<UAbilitySystemComponent>())
-                        {
-                            // Apply the Ground Slam stun effect
-                            FGameplayEffectSpecHandle StunSpecHandle = MakeOutgoingGameplayEffectSpec(GroundSlamStunEffect, 1.0f);
-                            FActiveGameplayEffectHandle ActiveEffectHandle = TargetASC->ApplyGameplayEffectSpecToTarget(*StunSpecHandle.Data.Get(), TargetASC);
-
-                            // Manually add the State.CC.Stunned tag to the target
-                            TargetASC->AddLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.CC.Stunned")));
-
-                            // Set a timer to remove the tag after the stun effect duration ends
-                            float EffectDuration = 2.0f; // Assuming 2 seconds as the stun duration
-                            FTimerHandle StunEffectTimerHandle;
-
-                            FTimerDelegate TimerCallback;
-                            TimerCallback.BindLambda([TargetASC]()
-                            {
-                                if (TargetASC)
-                                {
-                                    TargetASC->RemoveLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.CC.Stunned")));
-                                }
-                            });
-
-                            // Use the World Timer Manager to set the timer with the specified duration
-                            GetWorld()->GetTimerManager().SetTimer(StunEffectTimerHandle, TimerCallback, EffectDuration, false);
-                        }
-                    }
-                }
+                // An actor with several colliding components shows up once per component
+                Targets.AddUnique(TargetASC);
             }
         }
 
+        // Damage goes through the GAS effect, built once and shared between all targets, and is coalesced
+        // with any other hit the targets take this frame
+        if (GroundSlamDamageEffect && Targets.Num() > 0)
+        {
+            FGameplayEffectSpecHandle DamageSpecHandle = MakeOutgoingGameplayEffectSpec(GroundSlamDamageEffect, 1.0f);
+            DamageSpecHandle.Data->SetSetByCallerMagnitude(COGameplayTags::Data_Damage, GroundSlamDamage);
+
+            UCODamageAccumulatorSubsystem::QueueOrApplyDamageSpec(GetWorld(), *DamageSpecHandle.Data.Get(), Targets);
+        }
+
+        //Stun effect if level 3
+        if (GroundSlamLevel == 3 && GroundSlamStunEffect && Targets.Num() > 0)
+        {
+            // The stun spec is built once and shared between all targets
+            FGameplayEffectSpecHandle StunSpecHandle = MakeOutgoingGameplayEffectSpec(GroundSlamStunEffect, 1.0f);
+
+            // GE_GroundSlamStun's own duration wins; infinite or instant stun effects fall back to the property
+            const float EffectDuration = StunSpecHandle.Data->GetDuration();
+            const float StunDuration = EffectDuration > 0.0f ? EffectDuration : GroundSlamStunDuration;
+
+            // The status subsystem times the stun effect, which grants State.CC.Stunned while it lasts
+            UCOStatusEffectSubsystem::ApplyStatusOrEffect(GetWorld(), ECOStatusType::Stun, *StunSpecHandle.Data.Get(), Targets, StunDuration);
+        }
+
+        const int32 EffectsPerTarget = int32(GroundSlamDamageEffect != nullptr) + int32(GroundSlamLevel == 3 && GroundSlamStunEffect != nullptr);
+        CO_TRACE_ABILITY_HITS(this, Targets.Num(), Targets.Num() * EffectsPerTarget);
 
         // Destroy Breakable Objects if Level 3
-        if (GroundSlamLevel == 3)
+        for (AActor* Breakable : Breakables)
         {
-            TArray<FHitResult> HitResults;
-            FCollisionShape CollisionShape = FCollisionShape::MakeSphere(GroundSlamRadius);
-            if (GetWorld()->SweepMultiByChannel(HitResults, SlamLocation, SlamLocation, FQuat::Identity, ECC_WorldDynamic, CollisionShape))
-            {
-                for (const FHitResult& Hit : HitResults)
-                {
-                    AActor* HitActor = Hit.GetActor();
-                    if (HitActor && HitActor->ActorHasTag(FName("Environment.Breakable")))
-                    {
-                        HitActor->Destroy();
-                    }
-                }
-            }
+            Breakable->Destroy();
         }
     }
 
@@ -162,7 +179,7 @@ void UGroundSlamAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, con
 
     if (UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get())
     {
-        ASC->RemoveLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting")));
+        ASC->RemoveLooseGameplayTag(COGameplayTags::State_Casting);
     }
 }
 
@@ -180,6 +197,8 @@ void UGroundSlamAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, con
  */
 bool UGroundSlamAbility::CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, OUT FGameplayTagContainer* OptionalRelevantTags) const
 {
+    SCOPE_CYCLE_COUNTER(STAT_CO_GroundSlam_CanActivateAbility);
+
     if (!Super::CanActivateAbility(Handle, ActorInfo, SourceTags, TargetTags, OptionalRelevantTags))
     {
         return false;
@@ -189,13 +208,13 @@ bool UGroundSlamAbility::CanActivateAbility(const FGameplayAbilitySpecHandle Han
     UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get();
     if (ASC)
     {
-        if (ASC->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("Cooldown.Ability.GroundSlam"))))
+        if (ASC->HasMatchingGameplayTag(COGameplayTags::Cooldown_Ability_GroundSlam))
         {
             return false;
         }
 
         // Check if any ability is currently casting
-        if (ASC->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting"))))
+        if (ASC->HasMatchingGameplayTag(COGameplayTags::State_Casting))
         {
             return false;
         }
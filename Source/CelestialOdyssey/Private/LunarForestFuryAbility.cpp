@@ -1,9 +1,18 @@
 #include "LunarForestFuryAbility.h"
+#include "COGameplayTags.h"
+#include "COStats.h"
+#include "COTrace.h"
+#include "COLog.h"
+#include "COTargetGridSubsystem.h"
+#include "CODamageAccumulatorSubsystem.h"
 #include "GameFramework/Character.h"
 #include "AbilitySystemComponent.h"
-#include "TimerManager.h"
+#include "COStatusEffectSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 
+DECLARE_CYCLE_STAT(TEXT("LunarForestFury ActivateAbility"), STAT_CO_LunarForestFury_ActivateAbility, STATGROUP_CelestialOdyssey);
+DECLARE_CYCLE_STAT(TEXT("LunarForestFury CanActivateAbility"), STAT_CO_LunarForestFury_CanActivateAbility, STATGROUP_CelestialOdyssey);
+
 ULunarForestFuryAbility::ULunarForestFuryAbility()
 {
     InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
@@ -13,29 +22,32 @@ ULunarForestFuryAbility::ULunarForestFuryAbility()
 
 void ULunarForestFuryAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
-    UE_LOG(LogTemp, Log, TEXT("LunarForestFury: Starting Activation"));
+    SCOPE_CYCLE_COUNTER(STAT_CO_LunarForestFury_ActivateAbility);
+    CO_TRACE_ABILITY_ACTIVATED(this);
+
+    CO_ABILITY_TRACE(TEXT("LunarForestFury: Starting Activation"));
 
     Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
 
     UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get();
     if (ASC)
     {
-        UE_LOG(LogTemp, Log, TEXT("LunarForestFury: Found ASC"));
+        CO_ABILITY_TRACE(TEXT("LunarForestFury: Found ASC"));
 
         // Apply cooldown effect
         if (CooldownEffect)
         {
-            UE_LOG(LogTemp, Log, TEXT("LunarForestFury: Applying Cooldown"));
+            CO_ABILITY_TRACE(TEXT("LunarForestFury: Applying Cooldown"));
             FGameplayEffectSpecHandle CooldownSpecHandle = MakeOutgoingGameplayEffectSpec(CooldownEffect, 1.0f);
             ASC->ApplyGameplayEffectSpecToSelf(*CooldownSpecHandle.Data.Get());
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("LunarForestFury: No Cooldown Effect Set"));
+            CO_LOG_RATE_LIMITED(5.0, Warning, TEXT("LunarForestFury: No Cooldown Effect Set"));
         }
 
-        ASC->AddLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting")));
-        UE_LOG(LogTemp, Log, TEXT("LunarForestFury: Added Casting Tag"));
+        ASC->AddLooseGameplayTag(COGameplayTags::State_Casting);
+        CO_ABILITY_TRACE(TEXT("LunarForestFury: Added Casting Tag"));
     }
 
     ACharacter* Character = Cast<ACharacter>(ActorInfo->AvatarActor.Get());
@@ -45,56 +57,72 @@ void ULunarForestFuryAbility::ActivateAbility(const FGameplayAbilitySpecHandle H
         float BaseRadius = 300.0f;
         float Radius = FuryLevel >= 2 ? BaseRadius * 1.5f : BaseRadius;
 
-        TArray<FHitResult> HitResults;
-        FCollisionShape CollisionShape = FCollisionShape::MakeSphere(Radius);
+        UCOTargetGridSubsystem* TargetGrid = GetWorld()->GetSubsystem<UCOTargetGridSubsystem>();
+        TArray<UAbilitySystemComponent*> Targets;
+        if (TargetGrid)
+        {
+            TargetGrid->QueryCircle(EruptionLocation, Radius, Targets, Character);
+        }
 
-        if (GetWorld()->SweepMultiByChannel(HitResults, EruptionLocation, EruptionLocation,
-            FQuat::Identity, ECC_Pawn, CollisionShape))
+        // Build each spec once per activation and share it between all targets
+        FGameplayEffectSpecHandle DamageSpecHandle;
+        FGameplayEffectSpecHandle RootSpecHandle;
+        FGameplayEffectSpecHandle DoTSpecHandle;
+        if (Targets.Num() > 0)
         {
-            for (const FHitResult& Hit : HitResults)
+            // Base damage effect
+            if (DamageGameplayEffectClass)
+            {
+                DamageSpecHandle = MakeOutgoingGameplayEffectSpec(DamageGameplayEffectClass, GetAbilityLevel());
+            }
+
+            // Root effect at level 2+
+            if (FuryLevel >= 2 && RootGameplayEffectClass)
             {
-                AActor* HitActor = Hit.GetActor();
-                if (!HitActor || HitActor == Character) continue;
-
-                if (UAbilitySystemComponent* TargetASC = HitActor->FindComponentByClass<UAbilitySystemComponent>())
-                {
-                    // Base damage effect
-                    if (DamageGameplayEffectClass)
-                    {
-                        FGameplayEffectSpecHandle DamageSpecHandle = MakeOutgoingGameplayEffectSpec(DamageGameplayEffectClass, GetAbilityLevel());
-                        TargetASC->ApplyGameplayEffectSpecToSelf(*DamageSpecHandle.Data.Get());
-                    }
-
-                    // Level-specific effects
-                    if (FuryLevel >= 2 && RootGameplayEffectClass)
-                    {
-                        // Root effect at level 2+
-                        FGameplayEffectSpecHandle RootSpecHandle = MakeOutgoingGameplayEffectSpec(RootGameplayEffectClass, GetAbilityLevel());
-                        TargetASC->ApplyGameplayEffectSpecToSelf(*RootSpecHandle.Data.Get());
-                    }
-
-                    if (FuryLevel >= 3 && DoTGameplayEffectClass)
-                    {
-                        // DoT effect at level 3
-                        FGameplayEffectSpecHandle DoTSpecHandle = MakeOutgoingGameplayEffectSpec(DoTGameplayEffectClass, GetAbilityLevel());
-                        TargetASC->ApplyGameplayEffectSpecToSelf(*DoTSpecHandle.Data.Get());
-                    }
-
-                    // Apply knockback
-                    FVector KnockbackDirection = (HitActor->GetActorLocation() - EruptionLocation).GetSafeNormal();
-                    KnockbackDirection.Z = 0.5f; // Add some upward force
-                    float KnockbackStrength = 1000.0f;
-
-                    if (ACharacter* HitCharacter = Cast<ACharacter>(HitActor))
-                    {
-                        HitCharacter->LaunchCharacter(KnockbackDirection * KnockbackStrength, true, true);
-                    }
-                }
+                RootSpecHandle = MakeOutgoingGameplayEffectSpec(RootGameplayEffectClass, GetAbilityLevel());
+            }
+
+            // DoT effect at level 3
+            if (FuryLevel >= 3 && DoTGameplayEffectClass)
+            {
+                DoTSpecHandle = MakeOutgoingGameplayEffectSpec(DoTGameplayEffectClass, GetAbilityLevel());
             }
         }
+
+        if (DamageSpecHandle.IsValid())
+        {
+            UCODamageAccumulatorSubsystem::QueueOrApplyDamageSpec(GetWorld(), *DamageSpecHandle.Data.Get(), Targets);
+        }
+
+        // Roots and DoTs run on the status subsystem, which keeps the target tagged as rooted while the roots last
+        if (RootSpecHandle.IsValid())
+        {
+            UCOStatusEffectSubsystem::ApplyStatusOrEffect(GetWorld(), ECOStatusType::Root, *RootSpecHandle.Data.Get(), Targets, RootDuration);
+        }
+
+        if (DoTSpecHandle.IsValid())
+        {
+            UCOStatusEffectSubsystem::ApplyStatusOrEffect(GetWorld(), ECOStatusType::DamageOverTime, *DoTSpecHandle.Data.Get(), Targets);
+        }
+
+        for (UAbilitySystemComponent* TargetASC : Targets)
+        {
+            // Apply knockback
+            if (ACharacter* HitCharacter = Cast<ACharacter>(TargetASC->GetAvatarActor()))
+            {
+                FVector KnockbackDirection = (HitCharacter->GetActorLocation() - EruptionLocation).GetSafeNormal();
+                KnockbackDirection.Z = 0.5f; // Add some upward force
+                float KnockbackStrength = 1000.0f;
+
+                HitCharacter->LaunchCharacter(KnockbackDirection * KnockbackStrength, true, true);
+            }
+        }
+
+        const int32 EffectsPerTarget = int32(DamageSpecHandle.IsValid()) + int32(RootSpecHandle.IsValid()) + int32(DoTSpecHandle.IsValid());
+        CO_TRACE_ABILITY_HITS(this, Targets.Num(), Targets.Num() * EffectsPerTarget);
     }
 
-    UE_LOG(LogTemp, Log, TEXT("LunarForestFury: Calling EndAbility"));
+    CO_ABILITY_TRACE(TEXT("LunarForestFury: Calling EndAbility"));
     EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
 }
 
@@ -102,8 +130,8 @@ void ULunarForestFuryAbility::EndAbility(const FGameplayAbilitySpecHandle Handle
 {
     if (UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get())
     {
-        ASC->RemoveLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting")));
-        ASC->RemoveLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("Cooldown.Active")));
+        ASC->RemoveLooseGameplayTag(COGameplayTags::State_Casting);
+        ASC->RemoveLooseGameplayTag(COGameplayTags::Cooldown_Active);
     }
 
     Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
@@ -111,6 +139,8 @@ void ULunarForestFuryAbility::EndAbility(const FGameplayAbilitySpecHandle Handle
 
 bool ULunarForestFuryAbility::CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, FGameplayTagContainer* OptionalRelevantTags) const
 {
+    SCOPE_CYCLE_COUNTER(STAT_CO_LunarForestFury_CanActivateAbility);
+
     if (!Super::CanActivateAbility(Handle, ActorInfo, SourceTags, TargetTags, OptionalRelevantTags))
     {
         return false;
@@ -120,13 +150,13 @@ bool ULunarForestFuryAbility::CanActivateAbility(const FGameplayAbilitySpecHandl
     if (ASC)
     {
         // Only check for this ability's specific cooldown tag
-        if (ASC->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("Cooldown.Ability.LunarForestFury"))))
+        if (ASC->HasMatchingGameplayTag(COGameplayTags::Cooldown_Ability_LunarForestFury))
         {
             return false;
         }
 
         // Check if any ability is currently casting
-        if (ASC->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting"))))
+        if (ASC->HasMatchingGameplayTag(COGameplayTags::State_Casting))
         {
             return false;
         }
@@ -1,9 +1,18 @@
 #include "VineWhipAbility.h"
+#include "COGameplayTags.h"
+#include "COStats.h"
+#include "COTrace.h"
+#include "COCollisionChannels.h"
+#include "COLog.h"
 #include "GameFramework/Character.h"
 #include "AbilitySystemComponent.h"
-#include "TimerManager.h"
+#include "COTargetGridSubsystem.h"
+#include "COVineSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 
+DECLARE_CYCLE_STAT(TEXT("VineWhip ActivateAbility"), STAT_CO_VineWhip_ActivateAbility, STATGROUP_CelestialOdyssey);
+DECLARE_CYCLE_STAT(TEXT("VineWhip CanActivateAbility"), STAT_CO_VineWhip_CanActivateAbility, STATGROUP_CelestialOdyssey);
+
 /** Default constructor for UVineWhipAbility */
 UVineWhipAbility::UVineWhipAbility()
 {
@@ -12,6 +21,8 @@ UVineWhipAbility::UVineWhipAbility()
     // Set default level and vine duration
     VineWhipLevel = 1;
     VineDuration = 8.0f;
+    VineRange = 500.0f;
+    VineSegments = 16;
 
     VineWhipAction = EVineWhipAction::Grab; // Default to grab
 }
@@ -29,11 +40,14 @@ UVineWhipAbility::UVineWhipAbility()
  */
 void UVineWhipAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
 {
+    SCOPE_CYCLE_COUNTER(STAT_CO_VineWhip_ActivateAbility);
+    CO_TRACE_ABILITY_ACTIVATED(this);
+
     Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
 
     if (UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get())
     {
-        ASC->AddLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting")));
+        ASC->AddLooseGameplayTag(COGameplayTags::State_Casting);
     }
 
     ACharacter* Character = Cast<ACharacter>(ActorInfo->AvatarActor.Get());
@@ -41,24 +55,12 @@ void UVineWhipAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
     {
         // Get the direction and location to use the vine
         FVector StartLocation = Character->GetActorLocation();
-        FVector EndLocation = StartLocation + Character->GetActorForwardVector() * 500.0f;
+        FVector EndLocation = StartLocation + Character->GetActorForwardVector() * VineRange;
 
         // TODO: Replace with Gameplay Targeting to get precise location and target.
+        // The vine subsystem removes the vine after VineDuration
         ExecuteVineAction(StartLocation, EndLocation, VineWhipLevel);
 
-        // Set a timer to destroy the vine after the duration ends
-        FTimerHandle VineTimerHandle;
-        Character->GetWorldTimerManager().SetTimer(
-            VineTimerHandle,
-            [this, StartLocation]()
-        {
-            // TODO: Destroy the vine here using proper Gameplay Effect
-            UE_LOG(LogTemp, Log, TEXT("Vine at %s destroyed."), *StartLocation.ToString());
-        },
-            VineDuration,
-            false
-        );
-
         // End the ability after activation
         EndAbility(Handle, ActorInfo, ActivationInfo, false, false);
     }
@@ -79,7 +81,7 @@ void UVineWhipAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, const
 
     if (UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get())
     {
-        ASC->RemoveLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting")));
+        ASC->RemoveLooseGameplayTag(COGameplayTags::State_Casting);
     }
 }
 
@@ -94,47 +96,76 @@ void UVineWhipAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, const
  */
 void UVineWhipAbility::ExecuteVineAction(const FVector& StartLocation, const FVector& EndLocation, int32 Level)
 {
+    UCOVineSubsystem* Vines = GetWorld() ? GetWorld()->GetSubsystem<UCOVineSubsystem>() : nullptr;
+    if (!Vines)
+    {
+        return;
+    }
+
+    AActor* Caster = GetAvatarActorFromActorInfo();
+
     // TODO: Replace action level logic with Gameplay Tags to manage progression and add targeting to decide action dynamically.
     switch (VineWhipAction)
     {
     case EVineWhipAction::Grab:
         if (Level >= 1)
         {
-            UE_LOG(LogTemp, Log, TEXT("Executing grab action from %s to %s"), *StartLocation.ToString(), *EndLocation.ToString());
-            // TODO: Implement logic to grab an object or pull an enemy using proper Gameplay Effect
+            CO_ABILITY_TRACE(TEXT("Executing grab action from %s to %s"), *StartLocation.ToString(), *EndLocation.ToString());
+
+            // Latch onto the first target along the whip and reel it in; with nothing to grab the vine just hangs from the caster
+            AActor* Target = nullptr;
+            if (UCOTargetGridSubsystem* TargetGrid = GetWorld()->GetSubsystem<UCOTargetGridSubsystem>())
+            {
+                TArray<UAbilitySystemComponent*> Targets;
+                TargetGrid->QuerySegment(StartLocation, EndLocation, 50.0f, Targets, Caster);
+                Target = Targets.Num() > 0 ? Targets[0]->GetAvatarActor() : nullptr;
+            }
+
+            Vines->AddVine(ECOVineMode::Grab, StartLocation, Target ? Target->GetActorLocation() : EndLocation, VineSegments, 1.0f, Caster, Target, VineDuration);
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("Grab action not available at level %d"), Level);
+            CO_LOG_RATE_LIMITED(5.0, Warning, TEXT("Grab action not available at level %d"), Level);
         }
         break;
 
     case EVineWhipAction::Swing:
         if (Level >= 1)
         {
-            UE_LOG(LogTemp, Log, TEXT("Swinging from %s to %s"), *StartLocation.ToString(), *EndLocation.ToString());
-            // TODO: Implement logic to swing across gaps using proper Gameplay Mechanic
+            CO_ABILITY_TRACE(TEXT("Swinging from %s to %s"), *StartLocation.ToString(), *EndLocation.ToString());
+
+            // Anchor to the level geometry or crystal up and ahead; the caster then hangs from the vine on a fixed rope length
+            const FVector SwingEnd = StartLocation + ((EndLocation - StartLocation).GetSafeNormal() + FVector::UpVector).GetSafeNormal() * VineRange;
+
+            FHitResult Hit;
+            FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(VineSwingAnchor), false, Caster);
+            if (GetWorld()->LineTraceSingleByObjectType(Hit, StartLocation, SwingEnd, COCollision::MakeWorldGeometryParams(), QueryParams))
+            {
+                Vines->AddVine(ECOVineMode::Swing, Hit.Location, StartLocation, VineSegments, 1.0f, nullptr, Caster, VineDuration);
+            }
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("Swing action not available at level %d"), Level);
+            CO_LOG_RATE_LIMITED(5.0, Warning, TEXT("Swing action not available at level %d"), Level);
         }
         break;
 
     case EVineWhipAction::Bridge:
         if (Level >= 3)
         {
-            UE_LOG(LogTemp, Log, TEXT("Creating vine bridge from %s to %s"), *StartLocation.ToString(), *EndLocation.ToString());
-            // TODO: Implement logic to create a bridge between two points using proper Gameplay Mechanic
+            CO_ABILITY_TRACE(TEXT("Creating vine bridge from %s to %s"), *StartLocation.ToString(), *EndLocation.ToString());
+
+            // A little slack lets the bridge sag into a catenary before it settles and becomes walkable
+            Vines->AddVine(ECOVineMode::Bridge, StartLocation, EndLocation, UCOVineSubsystem::MaxSegmentsPerVine, 1.05f, nullptr, nullptr, VineDuration);
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("Bridge action not available at level %d"), Level);
+            CO_LOG_RATE_LIMITED(5.0, Warning, TEXT("Bridge action not available at level %d"), Level);
         }
         break;
 
     default:
-        UE_LOG(LogTemp, Warning, TEXT("Unknown vine whip action"));
+        CO_LOG_RATE_LIMITED(5.0, Warning, TEXT("Unknown vine whip action"));
         break;
     }
 }
@@ -153,6 +184,8 @@ void UVineWhipAbility::ExecuteVineAction(const FVector& StartLocation, const FVe
  */
 bool UVineWhipAbility::CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, OUT FGameplayTagContainer* OptionalRelevantTags) const
 {
+    SCOPE_CYCLE_COUNTER(STAT_CO_VineWhip_CanActivateAbility);
+
     if (!Super::CanActivateAbility(Handle, ActorInfo, SourceTags, TargetTags, OptionalRelevantTags))
     {
         return false;
@@ -162,13 +195,13 @@ bool UVineWhipAbility::CanActivateAbility(const FGameplayAbilitySpecHandle Handl
     UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get();
     if (ASC)
     {
-        if (ASC->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("Cooldown.Ability.VineWhip"))))
+        if (ASC->HasMatchingGameplayTag(COGameplayTags::Cooldown_Ability_VineWhip))
         {
             return false;
         }
 
         // Check if any ability is currently casting
-        if (ASC->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting"))))
+        if (ASC->HasMatchingGameplayTag(COGameplayTags::State_Casting))
         {
             return false;
         }
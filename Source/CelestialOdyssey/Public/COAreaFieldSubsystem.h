@@ -0,0 +1,113 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayEffectTypes.h"
+#include "ActiveGameplayEffectHandle.h"
+#include "COExpirySubsystem.h"
+#include "COStatusEffectSubsystem.h"
+#include "COAreaFieldSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+
+/**
+ * @struct FCOAreaFieldMember
+ * @brief A target currently standing inside a field and the effect the field applied to it.
+ */
+struct FCOAreaFieldMember
+{
+    UAbilitySystemComponent* Target = nullptr;
+    TWeakObjectPtr<UAbilitySystemComponent> WeakTarget;
+    FActiveGameplayEffectHandle EffectHandle;
+
+    /** Status added to the target when the field runs on the status subsystem */
+    int32 StatusId = INDEX_NONE;
+
+    /** World time at which a duration-based effect runs out and must be re-applied (0 = never) */
+    double ReapplyTime = 0.0;
+};
+
+/**
+ * @struct FCOAreaField
+ * @brief Compact description of a single persistent zone.
+ */
+struct FCOAreaField
+{
+    int32 Id = INDEX_NONE;
+    FVector Center = FVector::ZeroVector;
+    float Radius = 0.0f;
+
+    /** Pending expiry on the expiry wheel; invalid for fields that last until removed */
+    FCOExpiryHandle ExpiryHandle;
+
+    /** Effect applied to every target entering the field, built once by the owning ability */
+    FGameplayEffectSpecHandle EffectSpec;
+
+    /** True when the effect is a periodic health drain read as native damage; members then get a status instead */
+    bool bUsesStatus = false;
+    FCODamageOverTime StatusDamage;
+
+    /** Actor that never counts as a member (usually the instigator) */
+    TWeakObjectPtr<const AActor> IgnoredActor;
+
+    /** Current members, kept sorted by target pointer so membership changes can be merged */
+    TArray<FCOAreaFieldMember> Members;
+};
+
+/**
+ * @class UCOAreaFieldSubsystem
+ * @brief World subsystem that owns every persistent area-effect zone (slow fields, DoT pools, root fields).
+ *
+ * All zones are updated in a single pass per tick using the target grid. A zone applies its effect when a
+ * target enters and removes it when the target leaves or the zone expires; targets that stay inside are not
+ * touched. Zone lifetimes run on UCOExpirySubsystem.
+ *
+ * A DoT that only drains Health runs on UCOStatusEffectSubsystem while the target is inside. Slows and roots
+ * are applied as gameplay effects, so their modifiers, cues and tags behave as authored.
+ */
+UCLASS()
+class CELESTIALODYSSEY_API UCOAreaFieldSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // UTickableWorldSubsystem interface
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /**
+     * @brief Creates a new persistent zone. What the zone does is defined entirely by its effect.
+     * @param Center Zone center in world space.
+     * @param Radius Zone radius.
+     * @param Duration Lifetime of the zone in seconds; zero or less keeps it until RemoveField.
+     * @param EffectSpec Effect applied to targets while they are inside the zone.
+     * @param IgnoredActor Optional actor the zone never affects.
+     * @return Identifier that can be passed to RemoveField.
+     */
+    int32 AddField(const FVector& Center, float Radius, float Duration, const FGameplayEffectSpecHandle& EffectSpec, const AActor* IgnoredActor = nullptr);
+
+    /** @brief Removes a zone early, stripping its effect from all current members. */
+    void RemoveField(int32 FieldId);
+
+    /** @brief Returns the number of live zones. */
+    int32 GetNumFields() const { return Fields.Num(); }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void UpdateField(FCOAreaField& Field, double Now);
+    void ApplyToMember(const FCOAreaField& Field, FCOAreaFieldMember& Member, double Now) const;
+    void RemoveFromMember(const FCOAreaField& Field, FCOAreaFieldMember& Member) const;
+    void RemoveFieldAt(int32 FieldIndex);
+    void ExpireField(int32 FieldId);
+
+    TArray<FCOAreaField> Fields;
+    int32 NextFieldId = 0;
+
+    /** Scratch buffers reused across fields and frames */
+    TArray<UAbilitySystemComponent*> CandidateScratch;
+    TArray<FCOAreaFieldMember> MemberScratch;
+};
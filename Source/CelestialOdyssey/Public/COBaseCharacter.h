@@ -4,6 +4,9 @@
 #include "GameFramework/Character.h"
 #include "COBaseCharacter.generated.h"
 
+class UCOCharacterMovementComponent;
+class UCOTargetGridComponent;
+
 UCLASS()
 class CELESTIALODYSSEY_API ACOBaseCharacter : public ACharacter
 {
@@ -11,16 +14,17 @@ class CELESTIALODYSSEY_API ACOBaseCharacter : public ACharacter
 
 public:
 	//Constructor
-	ACOBaseCharacter();
+	ACOBaseCharacter(const FObjectInitializer& ObjectInitializer);
+
+	//Returns the movement component as the project-specific subclass
+	UFUNCTION(BlueprintPure, Category = "Movement")
+	UCOCharacterMovementComponent* GetCOCharacterMovement() const;
 
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
+public:
 	// Common functions for all characters
 	virtual void MoveRight(float Value);
 
@@ -28,4 +32,8 @@ protected:
 	//Movement speed (differs between characters)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Movement")
 	float MoveSpeed;
+
+	//Registers the character with the target grid when it owns an Ability System Component
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Targeting")
+	UCOTargetGridComponent* TargetGridComponent;
 };
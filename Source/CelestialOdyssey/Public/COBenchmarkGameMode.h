@@ -0,0 +1,236 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "COGameMode.h"
+#include "GameplayAbilitySpec.h"
+#include "COBenchmarkGameMode.generated.h"
+
+class ACOBaseCharacter;
+class UAbilitySystemComponent;
+class UGameplayAbility;
+struct FGameplayEffectSpec;
+struct FActiveGameplayEffectHandle;
+
+/**
+ *  Headless gameplay benchmark.
+ *
+ *  Builds a flat stress arena, fills it with enemies, fires every configured ability on a fixed schedule and writes
+ *  per-ability game-thread cost, gameplay effect application counts and frame-time percentiles to
+ *  Saved/Benchmarks/<OutputName>.csv/.json (-COBenchmarkOutput=<name> overrides). Results are checked against a threshold file and the process exits with a
+ *  non-zero code on regression when running unattended.
+ *
+ *  Example:
+ *  	UnrealEditor CelestialOdyssey /Engine/Maps/Entry?game=/Script/CelestialOdyssey.COBenchmarkGameMode
+ *  		-game -nullrhi -unattended -COBenchmarkEnemies=200
+ *
+ *  -COBenchmarkFragments=N keeps N crystal fragments alive for the whole run to stress the fragment simulation.
+ *  -COBenchmarkStructures=N keeps N short-lived crystal structures alive, so segments are grown and parked continuously.
+ *  -COBenchmarkVines=N hangs N free-swinging vines of StressVineSegments segments above the arena.
+ *  -COBenchmarkStatuses keeps every enemy slowed, rooted, stunned and burning, re-afflicting them each time the
+ *  statuses run out, to stress the status effect subsystem.
+ *  -COBenchmarkMinions spawns ACOMinionCharacter instead of EnemyClass. Compare the EnemyGASBytes and
+ *  DamageEffectsPerSecond results of a run with and without it to weigh minions against full enemies.
+ *  -COBenchmarkWalkers makes every enemy walk back and forth across the arena, and -COBenchmarkGaps=N splits the
+ *  floor into N+1 platforms separated by gaps narrower than a capsule, so walking crosses ledges and seams.
+ *  -COBenchmarkPlanarFloors=0 turns off the planar floor cache of every character. Compare MovementTickP50Us and
+ *  MovementTickP99Us of a walker run with it set to 0 and 1 (and different -COBenchmarkOutput names) to weigh it;
+ *  the CelestialOdyssey.Perf.PlanarFloorCache automation test writes the same comparison to one CSV.
+ */
+UCLASS(Config = Game)
+class CELESTIALODYSSEY_API ACOBenchmarkGameMode : public ACOGameMode
+{
+	GENERATED_BODY()
+
+public:
+	//Constructor
+	ACOBenchmarkGameMode();
+
+	//Generates the arena before any player is spawned
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
+
+	//Spawns the player above the arena; the generated map has no player starts
+	virtual void RestartPlayer(AController* NewPlayer) override;
+
+	virtual void Tick(float DeltaSeconds) override;
+
+protected:
+	//Spawns enemies and grants the benchmark abilities
+	virtual void StartPlay() override;
+
+	//Stops recording movement cost if the run ends before it finished
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	//Number of enemies spawned across the arena (-COBenchmarkEnemies=N overrides)
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	int32 NumEnemies = 200;
+
+	//Enemy class to spawn; must provide an Ability System Component
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	TSubclassOf<ACOBaseCharacter> EnemyClass;
+
+	//Instant one-point damage effects applied to every enemy when measuring damage throughput
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	int32 DamagePasses = 100;
+
+	//Abilities fired in order, one per AbilityInterval
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	TArray<TSubclassOf<UGameplayAbility>> BenchmarkAbilities;
+
+	//Crystal fragments kept alive throughout the run, on top of those launched by abilities (-COBenchmarkFragments=N overrides)
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	int32 NumStressFragments = 0;
+
+	//Crystal structures kept alive throughout the run; each lives StressStructureLifetime seconds (-COBenchmarkStructures=N overrides)
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	int32 NumStressStructures = 0;
+
+	//Lifetime of each stress structure, short enough that spawn and removal both show up in the results
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	float StressStructureLifetime = 2.0f;
+
+	//Vines simulated throughout the run (-COBenchmarkVines=N overrides)
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	int32 NumStressVines = 0;
+
+	//Segments per stress vine
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	int32 StressVineSegments = 32;
+
+	//Keeps every enemy afflicted by a status of each type for the whole run (-COBenchmarkStatuses enables)
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	bool bStressStatuses = false;
+
+	//Enemies walk back and forth across the arena for the whole run (-COBenchmarkWalkers enables)
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	bool bStressWalkers = false;
+
+	//Value of bUsePlanarFloorCache given to every character's movement component (-COBenchmarkPlanarFloors=0/1 overrides)
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	bool bUsePlanarFloors = true;
+
+	//Gaps that split the arena floor into separate platforms (-COBenchmarkGaps=N overrides)
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	int32 NumArenaGaps = 0;
+
+	//Width of each floor gap, in cm; narrower than a capsule so walkers step across instead of falling in
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	float ArenaGapWidth = 30.0f;
+
+	//Lifetime of each stress status; all of them run out together and are re-applied on the next frame
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	float StressStatusDuration = 1.0f;
+
+	//Width of the generated arena along X, in cm
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	float ArenaWidth = 8000.0f;
+
+	//Seconds to settle before measuring
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	float WarmupSeconds = 2.0f;
+
+	//Seconds of measurement
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	float DurationSeconds = 30.0f;
+
+	//Seconds between ability activations
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	float AbilityInterval = 0.5f;
+
+	//Threshold file relative to the project directory (-COBenchmarkThresholds=<file> overrides)
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	FString ThresholdsFile = TEXT("Config/Benchmark/COBenchmarkThresholds.json");
+
+	//Base name of the result files in Saved/Benchmarks
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Benchmark")
+	FString OutputName = TEXT("COBenchmark");
+
+private:
+	//Per-ability results
+	struct FAbilityResult
+	{
+		FGameplayAbilitySpecHandle Handle;
+		int32 Activations = 0;
+		int32 Failures = 0;
+		int32 EffectsApplied = 0;
+		double TotalCostMs = 0.0;
+		double MaxCostMs = 0.0;
+	};
+
+	//Fires the next ability in the schedule and times the activation
+	void FireNextAbility();
+
+	//Counts effects applied by the player, attributed to the ability that applied them
+	void OnEffectApplied(UAbilitySystemComponent* Target, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle);
+
+	//Writes CSV and JSON, checks thresholds and quits when unattended
+	void FinishBenchmark();
+
+	//Tops the fragment simulation back up to NumStressFragments
+	void RefillStressFragments();
+
+	//Spawns crystal structures until NumStressStructures are alive
+	void RefillStressStructures();
+
+	//Hangs vines until NumStressVines are alive
+	void RefillStressVines();
+
+	//Re-afflicts every enemy once their stress statuses have run out
+	void RefillStressStatuses();
+
+	//Turns walkers around at the arena edges and feeds them movement input
+	void DriveWalkers();
+
+	//Builds the slow, hold (root and stun) and burn effects the stress statuses apply
+	void CreateStressEffects();
+
+	//Measures the gameplay ability memory held per enemy and how fast damage can be applied to them
+	void MeasureEnemyCost(const TArray<AActor*>& Enemies);
+
+	//Compares results with the threshold file; appends a line per violation
+	bool CheckThresholds(double FrameP50Ms, double FrameP99Ms, double FragmentTickP99Ms, double StructureTickP99Ms, double VineTickP99Ms, double StatusTickP99Ms, TArray<FString>& OutFailures) const;
+
+	//Value at the given percentile (0..1) of an already sorted array
+	static double Percentile(const TArray<double>& Sorted, double Fraction);
+
+	UPROPERTY(Transient)
+	UAbilitySystemComponent* PlayerAbilitySystem = nullptr;
+
+	//Enemies afflicted by the stress statuses
+	UPROPERTY(Transient)
+	TArray<UAbilitySystemComponent*> EnemyAbilitySystems;
+
+	//Enemies walking across the arena, and the direction each is heading along X
+	UPROPERTY(Transient)
+	TArray<ACOBaseCharacter*> Walkers;
+	TArray<float> WalkerDirections;
+
+	//Effects behind the stress statuses, built in code on first use so the benchmark needs no content
+	UPROPERTY(Transient)
+	UGameplayEffect* StressSlowEffect = nullptr;
+
+	UPROPERTY(Transient)
+	UGameplayEffect* StressHoldEffect = nullptr;
+
+	UPROPERTY(Transient)
+	UGameplayEffect* StressBurnEffect = nullptr;
+
+	TArray<FAbilityResult> AbilityResults;
+	TArray<double> FrameTimesMs;
+	TArray<double> FragmentTickMs;
+	TArray<double> StructureTickMs;
+	TArray<double> VineTickMs;
+	TArray<double> StatusTickMs;
+	TArray<double> MovementTickUs;
+
+	double EnemyGASBytes = 0.0;
+	double DamageEffectsPerSecond = 0.0;
+
+	int32 StructureSpawns = 0;
+	int32 NextStressStructure = 0;
+	double StructureSpawnTotalMs = 0.0;
+
+	double ElapsedSeconds = 0.0;
+	double NextAbilityTime = 0.0;
+	int32 NextAbilityIndex = 0;
+	bool bFinished = false;
+};
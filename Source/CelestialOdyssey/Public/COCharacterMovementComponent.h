@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "COCharacterMovementComponent.generated.h"
+
+/**
+ *  Movement component shared by every ACOBaseCharacter.
+ *  Adds a first-class inverted-gravity mode on top of the engine's gravity-direction support, so floor finding,
+ *  step-up and jumping run against the ceiling without touching the mesh transform.
+ */
+UCLASS()
+class CELESTIALODYSSEY_API UCOCharacterMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	UCOCharacterMovementComponent();
+
+	/**
+	 * @brief Points gravity up (or back down) and rolls the character to match.
+	 *
+	 * The roll happens on the updated component, so the mesh follows through attachment and keeps its authored
+	 * relative offset. Already airborne characters keep their velocity; walking characters are switched to falling.
+	 *
+	 * @param bInverted True to fall towards the ceiling.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Character Movement: Gravity")
+	void SetGravityInverted(bool bInverted);
+
+	UFUNCTION(BlueprintPure, Category = "Character Movement: Gravity")
+	bool IsGravityInverted() const { return bGravityInverted; }
+
+	void SetUsePlanarFloorCache(bool bUse) { bUsePlanarFloorCache = bUse; }
+
+	/**
+	 * @brief Starts or stops adding up the game-thread time spent in TickComponent by every instance.
+	 * Used by the benchmark to compare movement cost with and without the planar floor cache.
+	 */
+	static void SetRecordTickCost(bool bRecord);
+
+	/** @brief Returns the tick time recorded since the last call, in seconds, and the number of ticks it covers. */
+	static double ConsumeRecordedTickSeconds(int32& OutNumTicks);
+
+	//~ Begin UActorComponent Interface
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~ End UActorComponent Interface
+
+	//~ Begin UCharacterMovementComponent Interface
+	virtual void FindFloor(const FVector& CapsuleLocation, FFindFloorResult& OutFloorResult, bool bCanUseCachedLocation, const FHitResult* DownwardSweepResult = nullptr) const override;
+	virtual FVector GetPenetrationAdjustment(const FHitResult& Hit) const override;
+	//~ End UCharacterMovementComponent Interface
+
+protected:
+	/**
+	 * @brief Whether the current floor can be reused for a capsule at CapsuleLocation without sweeping.
+	 *
+	 * Holds while walking across the flat top of a component that has not moved since it was last swept, at an
+	 * unchanged height, with the whole capsule still inside the component's X extent, and a line trace against
+	 * that component alone still finds the surface under the capsule's center. Everything else (slopes, moving
+	 * platforms, steps, holes, inverted gravity) goes through the regular sweep.
+	 */
+	bool CanReusePlanarFloor(const FVector& CapsuleLocation) const;
+
+	/**
+	 * Replaces the downward floor sweep with a trace against the current floor component while walking along the
+	 * flat top of a platform. Side-scroller levels are mostly long platforms, so most walking ticks hit this path.
+	 * A platform that moves invalidates the cache until it is swept again.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Character Movement: Walking")
+	bool bUsePlanarFloorCache = true;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Character Movement: Gravity")
+	bool bGravityInverted = false;
+
+private:
+	//Floor component of the last swept floor and its transform at that time, so the cache notices it moving
+	mutable TWeakObjectPtr<UPrimitiveComponent> SweptFloorComponent;
+	mutable FTransform SweptFloorTransform;
+};
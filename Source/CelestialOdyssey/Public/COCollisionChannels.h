@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "CollisionQueryParams.h"
+
+/**
+ * @brief Collision channels and profiles used by Celestial Odyssey.
+ *
+ * Mirrors the [/Script/Engine.CollisionProfile] section of Config/DefaultEngine.ini. The engine assigns game
+ * channels by slot, so the slot numbers here must match the ini.
+ *
+ * Object types:
+ *   Enemy           Capsules of enemies and minions. Blocks like a pawn.
+ *   Breakable       Props that Ground Slam can destroy. Ground Slam still accepts WorldDynamic actors tagged
+ *                   Environment.Breakable, so unmigrated content keeps working.
+ *   CrystalSurface  Grown crystal structures, so world queries can tell them from level geometry.
+ *
+ * Trace channels:
+ *   EnemyTrace           Blocked by world geometry and enemies, so a strike stops at the first wall.
+ *   CrystalSurfaceTrace  Blocked by world geometry, so crystals grow on any existing surface. Enemies and
+ *                        invisible walls let it through.
+ *
+ * Both trace channels block by default. The Pawn, CharacterMesh, Spectator, Ragdoll, Trigger, UI and
+ * overlap-only profiles ignore them, so the queries never stop at players, triggers or volumes. A prop that
+ * should let them through needs its own profile.
+ */
+#define CO_ObjectChannel_Enemy          ECC_GameTraceChannel1
+#define CO_ObjectChannel_Breakable      ECC_GameTraceChannel2
+#define CO_ObjectChannel_CrystalSurface ECC_GameTraceChannel3
+#define CO_TraceChannel_Enemy           ECC_GameTraceChannel4
+#define CO_TraceChannel_CrystalSurface  ECC_GameTraceChannel5
+
+namespace COCollisionProfiles
+{
+    CELESTIALODYSSEY_API extern const FName Enemy;
+    CELESTIALODYSSEY_API extern const FName Breakable;
+    CELESTIALODYSSEY_API extern const FName CrystalSurface;
+}
+
+namespace COCollision
+{
+    /** Object types that count as solid world geometry for traces that stop at walls, ceilings and crystals */
+    inline FCollisionObjectQueryParams MakeWorldGeometryParams()
+    {
+        FCollisionObjectQueryParams Params(FCollisionObjectQueryParams::InitType::AllStaticObjects);
+        Params.AddObjectTypesToQuery(CO_ObjectChannel_CrystalSurface);
+        return Params;
+    }
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CrystalGrowthAbility.h"
+#include "COExpirySubsystem.h"
+#include "COCrystalStructureSubsystem.generated.h"
+
+class UHierarchicalInstancedStaticMeshComponent;
+class UStaticMesh;
+
+/**
+ * @struct FCOCrystalStructure
+ * @brief A crystal structure and the instances its segments occupy.
+ */
+struct FCOCrystalStructure
+{
+    int32 Id = INDEX_NONE;
+
+    /** Pending lifetime expiry on the expiry wheel; invalid for structures that last until despawned */
+    FCOExpiryHandle ExpiryHandle;
+
+    /** World-space transform of every segment, in growth order */
+    TArray<FTransform> Segments;
+
+    /** Instance index of each segment grown so far; segments past this count are still waiting to grow */
+    TArray<int32> Instances;
+
+    bool IsFullyGrown() const { return Instances.Num() == Segments.Num(); }
+};
+
+/**
+ * @class UCOCrystalStructureSubsystem
+ * @brief World subsystem that builds, grows and removes crystal structures made of instanced segments.
+ *
+ * Every segment in the world is an instance of one hierarchical instanced static mesh component with
+ * collision, so structures never spawn actors and large crystal fields keep per-cluster culling and LOD.
+ * Instances are pooled: removing a structure parks its instances out of the way and later structures reuse
+ * them instead of adding new ones. The cluster tree is not rebuilt per instance; each tick that moved
+ * instances asks for one asynchronous rebuild.
+ *
+ * Growing and parking are spread over frames. Each tick works through at most MaxSegmentsPerTick
+ * segments or GrowthBudgetSeconds of game-thread time, whichever comes first, so a large staircase
+ * appears over a few frames instead of in a single hitch. Structure lifetimes run on UCOExpirySubsystem.
+ */
+UCLASS()
+class CELESTIALODYSSEY_API UCOCrystalStructureSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Most segments grown or parked in a single tick */
+    static constexpr int32 MaxSegmentsPerTick = 32;
+
+    /** Game-thread time a tick may spend growing and parking segments */
+    static constexpr double GrowthBudgetSeconds = 0.0005;
+
+    /** Edge length of a segment at unit scale; matches the engine cube used by default */
+    static constexpr float SegmentSize = 100.0f;
+
+    // UTickableWorldSubsystem interface
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /**
+     * @brief Lays out a structure and queues its segments for growth.
+     * @param Type Shape of the structure.
+     * @param Level Ability level; higher levels build longer bridges and taller stairs and walls.
+     * @param Location Anchor point on the hit surface.
+     * @param Rotation Structure frame: X runs along the surface, Z along the surface normal.
+     * @param Lifetime Seconds before the structure is removed. Zero or less keeps it until DespawnStructure.
+     * @return Identifier that can be passed to DespawnStructure.
+     */
+    int32 SpawnStructure(ECrystalStructureType Type, int32 Level, const FVector& Location, const FRotator& Rotation, float Lifetime);
+
+    /** @brief Removes a structure, returning its instances to the pool. Segments still waiting to grow are dropped. */
+    void DespawnStructure(int32 StructureId);
+
+    /** @brief Replaces the mesh used for every segment. */
+    void SetSegmentMesh(UStaticMesh* Mesh);
+
+    /**
+     * @brief Computes the world-space segment transforms of a structure.
+     * @param Type Shape of the structure.
+     * @param Level Ability level.
+     * @param StructureTransform Anchor and frame of the structure.
+     * @param OutSegments Receives the segment transforms in growth order. Cleared first.
+     */
+    static void BuildSegments(ECrystalStructureType Type, int32 Level, const FTransform& StructureTransform, TArray<FTransform>& OutSegments);
+
+    /** @brief Returns the number of live structures. */
+    int32 GetNumStructures() const { return Structures.Num(); }
+
+    /** @brief Returns the number of segment instances, grown and parked. */
+    int32 GetNumInstances() const;
+
+    /** @brief Returns the game-thread time spent in the last Tick, in seconds. */
+    double GetLastTickSeconds() const { return LastTickSeconds; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    bool EnsureInstanceComponent();
+    int32 AcquireInstance(const FTransform& Transform);
+    void ExpireStructure(int32 StructureId);
+    void RemoveStructureAt(int32 StructureIndex);
+
+    TArray<FCOCrystalStructure> Structures;
+    int32 NextStructureId = 0;
+
+    /** Instances of removed structures that still have to be moved out of the way */
+    TArray<int32> InstancesToPark;
+
+    /** Parked instances ready for reuse */
+    TArray<int32> FreeInstances;
+
+    UPROPERTY(Transient)
+    UStaticMesh* SegmentMesh = nullptr;
+
+    UPROPERTY(Transient)
+    UHierarchicalInstancedStaticMeshComponent* InstanceComponent = nullptr;
+
+    double LastTickSeconds = 0.0;
+};
@@ -0,0 +1,219 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "GameplayEffect.h"
+#include "CODamageAccumulatorSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+
+/**
+ * @struct FCODamageSource
+ * @brief Who dealt a piece of damage: the instigating Ability System Component and the ability that applied it.
+ */
+struct FCODamageSource
+{
+    TWeakObjectPtr<UAbilitySystemComponent> Instigator;
+    TWeakObjectPtr<const UClass> AbilityClass;
+
+    /** Reads the instigator and source ability from a spec's effect context */
+    static FCODamageSource FromSpec(const FGameplayEffectSpec& Spec);
+
+    /** Name used for telemetry; NAME_None when no ability is known */
+    FName GetAbilityName() const;
+
+    bool operator==(const FCODamageSource& Other) const { return Instigator == Other.Instigator && AbilityClass == Other.AbilityClass; }
+};
+
+/**
+ * @struct FCODamageEvent
+ * @brief One queued hit, kept until the end of the frame for attribution.
+ */
+struct FCODamageEvent
+{
+    int32 TargetIndex = INDEX_NONE;
+    float Amount = 0.0f;
+    FCODamageSource Source;
+};
+
+/**
+ * @struct FCOPendingDamage
+ * @brief Net damage queued against one health attribute of one target this frame.
+ */
+struct FCOPendingDamage
+{
+    TWeakObjectPtr<UAbilitySystemComponent> Target;
+    FGameplayAttribute Attribute;
+    float Total = 0.0f;
+
+    /** Instigator of the first hit; the flushed effect's context is made from it */
+    TWeakObjectPtr<UAbilitySystemComponent> Instigator;
+};
+
+/**
+ * @class UCOCoalescedDamageEffect
+ * @brief Instant effect the accumulator writes a target's net damage with, as a SetByCaller Data.Damage
+ * modifier on enemy (and minion) Health.
+ *
+ * Going through a real effect keeps the attribute set's execute hooks and the target's effect application
+ * queries in the path, exactly as when each hit was applied on its own.
+ */
+UCLASS()
+class CELESTIALODYSSEY_API UCOCoalescedDamageEffect : public UGameplayEffect
+{
+    GENERATED_BODY()
+
+public:
+    UCOCoalescedDamageEffect();
+};
+
+/**
+ * @class UCOCoalescedPlayerDamageEffect
+ * @brief UCOCoalescedDamageEffect for hits on the player, which are taken from Lives.
+ */
+UCLASS()
+class CELESTIALODYSSEY_API UCOCoalescedPlayerDamageEffect : public UCOCoalescedDamageEffect
+{
+    GENERATED_BODY()
+
+public:
+    UCOCoalescedPlayerDamageEffect();
+};
+
+/** Broadcast when queued damage takes a target's Health to zero; the killer is the source that dealt most of it that frame */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FCOOnTargetKilled, UAbilitySystemComponent* /*Target*/, const FCODamageSource& /*Killer*/);
+
+/**
+ * @class UCODamageAccumulatorSubsystem
+ * @brief World subsystem that coalesces every hit a target takes in a frame into a single Health write.
+ *
+ * Abilities, fragments and damage over time queue damage here instead of applying their damage effects one
+ * by one. The subsystem ticks after actors, and then applies one coalesced damage effect per target carrying
+ * the net damage, so the attribute set's hooks, the applied-effect and attribute change delegates and Health
+ * replication fire once per target per frame however many hits landed.
+ *
+ * Only effects whose whole behaviour is an additive change of one health attribute are coalesced; see
+ * ReadSpecDamage and FindCoalescedEffect for the attributes that count.
+ *
+ * Every hit keeps its source until the flush. Damage dealt per ability is added to running totals for telemetry,
+ * and a target whose Health reaches zero is credited to the source that dealt most of that frame's damage.
+ */
+UCLASS()
+class CELESTIALODYSSEY_API UCODamageAccumulatorSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // UTickableWorldSubsystem interface
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /**
+     * @brief Queues damage against a target for the end of the frame.
+     * @param Target Ability System Component whose health is reduced.
+     * @param Amount Damage to deal. Zero or less is ignored.
+     * @param Source Who dealt it.
+     * @param Attribute Health attribute the damage is taken from; enemy Health when not given.
+     */
+    void AddDamage(UAbilitySystemComponent* Target, float Amount, const FCODamageSource& Source, const FGameplayAttribute& Attribute = FGameplayAttribute());
+
+    /**
+     * @brief Queues the damage of a plain instant damage effect against every target.
+     *
+     * The spec qualifies if it is instant, has no executions or gameplay cues and only modifies one health
+     * attribute additively. Its magnitude is evaluated once and shared between all targets. The applied-effect
+     * delegates fire once per target at the flush, for the coalesced effect. Any other spec is applied to the
+     * targets as a regular gameplay effect.
+     */
+    void ApplyDamageSpec(const FGameplayEffectSpec& Spec, TConstArrayView<UAbilitySystemComponent*> Targets);
+
+    /** @brief Single-target form of ApplyDamageSpec. */
+    void ApplyDamageSpec(const FGameplayEffectSpec& Spec, UAbilitySystemComponent* Target);
+
+    /**
+     * @brief Queues a damage spec on the world's accumulator, or applies it to the targets right away when the
+     * world has none, so callers never lose damage.
+     */
+    static void QueueOrApplyDamageSpec(const UWorld* World, const FGameplayEffectSpec& Spec, TConstArrayView<UAbilitySystemComponent*> Targets);
+    static void QueueOrApplyDamageSpec(const UWorld* World, const FGameplayEffectSpec& Spec, UAbilitySystemComponent* Target);
+
+    /**
+     * @brief Applies damage to a target immediately through the coalesced damage effect of the attribute.
+     * @param Instigator Ability System Component the effect context is made from. The target's own is used when null.
+     * @param Attribute Health attribute the damage is taken from; enemy Health when not given.
+     */
+    static void ApplyDamageNow(UAbilitySystemComponent* Target, float Amount, UAbilitySystemComponent* Instigator, const FGameplayAttribute& Attribute = FGameplayAttribute());
+
+    /** @brief Applies a spec to the targets as a regular gameplay effect, from its instigator when known. */
+    static void ApplySpecDirectly(const FGameplayEffectSpec& Spec, TConstArrayView<UAbilitySystemComponent*> Targets);
+
+    /**
+     * @brief Returns the instant effect damage to a health attribute is coalesced into, or null if damage to
+     * the attribute is not coalesced. Enemy and minion Health and player Lives are.
+     */
+    static const UGameplayEffect* FindCoalescedEffect(const FGameplayAttribute& Attribute);
+
+    /**
+     * @brief Returns true if applying the effect does nothing but change HealthAttribute additively.
+     *
+     * The effect must have no executions, no gameplay cues and no effect components (granted or asset tags,
+     * tag requirements, immunity, chance to apply and so on), and every modifier must be an additive
+     * HealthAttribute modifier without source or target tag requirements. Such an effect can be reproduced
+     * exactly by the attribute's coalesced damage effect.
+     */
+    static bool IsPlainHealthEffect(const UGameplayEffect* Definition, const FGameplayAttribute& HealthAttribute);
+
+    /**
+     * @brief Returns the health attribute the effect's modifiers change, if it is one whose damage is coalesced
+     * and the effect is plain (see IsPlainHealthEffect); an invalid attribute otherwise.
+     */
+    static FGameplayAttribute FindPlainHealthAttribute(const UGameplayEffect* Definition);
+
+    /**
+     * @brief Evaluates the damage of a spec that can be coalesced.
+     * @param OutAttribute Receives the health attribute the damage is taken from.
+     * @return False if the spec is not an instant plain health effect that deals damage.
+     */
+    static bool ReadSpecDamage(const FGameplayEffectSpec& Spec, float& OutDamage, FGameplayAttribute& OutAttribute);
+
+    /** @brief Damage dealt by each ability since the world started, keyed by ability class name. */
+    const TMap<FName, double>& GetDamageByAbility() const { return DamageByAbility; }
+
+    /** @brief Kills credited to each ability since the world started, keyed by ability class name. */
+    const TMap<FName, int32>& GetKillsByAbility() const { return KillsByAbility; }
+
+    /** @brief Hits queued by each ability since the world started, keyed by ability class name. */
+    const TMap<FName, int32>& GetHitsByAbility() const { return HitsByAbility; }
+
+    /** @brief Hits queued and Health writes made since the world started; their ratio is the coalescing factor. */
+    int64 GetNumDamageEvents() const { return NumDamageEvents; }
+    int64 GetNumHealthWrites() const { return NumHealthWrites; }
+
+    /** Fired during the flush for every target the queued damage killed */
+    FCOOnTargetKilled OnTargetKilled;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** Returns the source that dealt the most damage to a target in the queue being flushed */
+    FCODamageSource FindKiller(int32 TargetIndex) const;
+
+    /** Damage queued for the next flush */
+    TArray<FCOPendingDamage> PendingTargets;
+    TMap<TPair<TObjectKey<UAbilitySystemComponent>, FGameplayAttribute>, int32> PendingIndices;
+    TArray<FCODamageEvent> Events;
+
+    /** Queue being written during a flush; swapped with the pending one so both keep their allocations */
+    TArray<FCOPendingDamage> FlushingTargets;
+    TArray<FCODamageEvent> FlushingEvents;
+
+    TMap<FName, double> DamageByAbility;
+    TMap<FName, int32> KillsByAbility;
+    TMap<FName, int32> HitsByAbility;
+
+    int64 NumDamageEvents = 0;
+    int64 NumHealthWrites = 0;
+};
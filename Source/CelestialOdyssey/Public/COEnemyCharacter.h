@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "COBaseCharacter.h"
+#include "AbilitySystemInterface.h"
+#include "COEnemyCharacter.generated.h"
+
+class UAbilitySystemComponent;
+class UCOEnemyAttributeSet;
+
+/**
+ *  Enemy character that can be targeted by player abilities.
+ *  Owns its Ability System Component and UCOEnemyAttributeSet, and registers with the target grid through
+ *  ACOBaseCharacter like any other character with an ASC.
+ */
+UCLASS()
+class CELESTIALODYSSEY_API ACOEnemyCharacter : public ACOBaseCharacter, public IAbilitySystemInterface
+{
+	GENERATED_BODY()
+
+public:
+	//Constructor
+	ACOEnemyCharacter(const FObjectInitializer& ObjectInitializer);
+
+	//Returns the enemy's own Ability System Component
+	virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override;
+
+protected:
+	//Initializes the ability actor info before the base class registers the enemy as a target
+	virtual void BeginPlay() override;
+
+	//Receives gameplay effects from player abilities
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Abilities")
+	UAbilitySystemComponent* AbilitySystemComponent;
+
+	//Health and movement speed; null for minions
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Attributes")
+	UCOEnemyAttributeSet* AttributeSet;
+};
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ActiveGameplayEffectHandle.h"
+#include "COExpirySubsystem.generated.h"
+
+class UAbilitySystemComponent;
+
+/**
+ * @struct FCOExpiryHandle
+ * @brief Identifies a scheduled expiry so it can be cancelled.
+ */
+struct FCOExpiryHandle
+{
+    uint32 Id = 0;
+
+    bool IsValid() const { return Id != 0; }
+    void Invalidate() { Id = 0; }
+};
+
+/**
+ * @enum ECOExpiryAction
+ * @brief What happens when an expiry record fires.
+ */
+enum class ECOExpiryAction : uint8
+{
+    RemoveActiveEffect,
+    Callback,
+};
+
+/**
+ * @struct FCOExpiryRecord
+ * @brief Compact record stored in a timing wheel bucket.
+ */
+struct FCOExpiryRecord
+{
+    uint64 ExpireTick = 0;
+    uint32 Id = 0;
+    ECOExpiryAction Action = ECOExpiryAction::Callback;
+    TWeakObjectPtr<UAbilitySystemComponent> Target;
+    FActiveGameplayEffectHandle EffectHandle;
+};
+
+/**
+ * @class UCOExpirySubsystem
+ * @brief Hierarchical timing wheel for gameplay expiries: stuns, roots and slows, area fields, crystal
+ * structures, vines, gravity shifts and minion effects.
+ *
+ * Expiries are stored as compact records in wheel buckets instead of one FTimerManager entry and
+ * lambda per target. The wheel advances in fixed ticks of TickResolution seconds of game time and
+ * fires every record in a bucket as one batch. Three levels of 64 buckets cover roughly two hours;
+ * anything further out waits in an overflow list.
+ *
+ * Subsystems that schedule on the wheel declare it as a dependency, so it exists in every world they do.
+ */
+UCLASS()
+class CELESTIALODYSSEY_API UCOExpirySubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Length of a wheel tick in seconds of game time */
+    static constexpr double TickResolution = 1.0 / 30.0;
+
+    // UTickableWorldSubsystem interface
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /**
+     * @brief Removes an active gameplay effect from a target after a delay.
+     * @param Target ASC owning the effect.
+     * @param EffectHandle Handle of the active effect.
+     * @param Delay Delay in seconds.
+     */
+    FCOExpiryHandle ScheduleEffectRemoval(UAbilitySystemComponent* Target, FActiveGameplayEffectHandle EffectHandle, float Delay);
+
+    /**
+     * @brief Executes a delegate after a delay.
+     * @param Delay Delay in seconds.
+     * @param Callback Delegate to execute. Bind with CreateUObject or CreateWeakLambda so it is skipped once its owner is gone.
+     */
+    FCOExpiryHandle ScheduleCallback(float Delay, FSimpleDelegate Callback);
+
+    /**
+     * @brief Cancels a pending expiry and invalidates the handle.
+     *
+     * Callback records are cancelled in constant time. Effect records are rare to cancel, so they are
+     * searched for in the buckets rather than paying for an id index on every insert. Owners invalidate
+     * their handle once the record has fired, so a fired record is never searched for.
+     */
+    void Cancel(FCOExpiryHandle& Handle);
+
+    /** @brief Returns the number of records waiting to fire. */
+    int32 GetNumPending() const { return NumPending; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    static constexpr int32 NumLevels = 3;
+    static constexpr int32 SlotBits = 6;
+    static constexpr int32 SlotsPerLevel = 1 << SlotBits;
+    static constexpr uint64 SlotMask = SlotsPerLevel - 1;
+
+    FCOExpiryHandle Schedule(FCOExpiryRecord&& Record, float Delay);
+    void Insert(FCOExpiryRecord&& Record);
+    void Cascade(int32 Level, int32 Slot);
+    void Fire(const FCOExpiryRecord& Record);
+
+    /** Buckets per level, indexed [Level * SlotsPerLevel + Slot] */
+    TArray<FCOExpiryRecord> Buckets[NumLevels * SlotsPerLevel];
+
+    /** Records too far in the future for the wheel */
+    TArray<FCOExpiryRecord> Overflow;
+
+    /** Delegates of pending Callback records, keyed by record id */
+    TMap<uint32, FSimpleDelegate> Callbacks;
+
+    /** Records collected from the current bucket, fired after the wheel has been updated */
+    TArray<FCOExpiryRecord> FireBatch;
+
+    uint64 CurrentTick = 0;
+    uint32 NextId = 1;
+    int32 NumPending = 0;
+};
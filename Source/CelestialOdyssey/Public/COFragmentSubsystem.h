@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayEffectTypes.h"
+#include "Containers/SparseArray.h"
+#include "COFragmentSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+/**
+ * @struct FCOFragmentVolley
+ * @brief Data shared by every fragment launched in one call.
+ */
+struct FCOFragmentVolley
+{
+    /** Effect applied to the first target a fragment hits, built once by the launching ability */
+    FGameplayEffectSpecHandle DamageSpec;
+
+    /** Actor fragments never hit (usually the instigator) */
+    TWeakObjectPtr<const AActor> IgnoredActor;
+
+    /** World Y of the gameplay plane the volley was launched on */
+    float PlaneY = 0.0f;
+
+    /** Fragments of this volley still alive; the volley is released when it reaches zero */
+    int32 NumLive = 0;
+};
+
+/**
+ * @class UCOFragmentSubsystem
+ * @brief World subsystem that simulates every crystal fragment in the world.
+ *
+ * Fragments are plain entries in structure-of-arrays storage (position, velocity, lifetime, bounces left)
+ * rather than actors, so launching and expiring them never spawns or destroys anything. Dead fragments are
+ * swap-removed without shrinking, so the arrays act as a pool that grows to the peak fragment count.
+ *
+ * Movement is 2D on the XZ gameplay plane. Fragments ricochet off world geometry, damage the first
+ * target they cross through the target grid, and are drawn by a single instanced static mesh component.
+ */
+UCLASS()
+class CELESTIALODYSSEY_API UCOFragmentSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Upper bound on live fragments; launches beyond it are dropped */
+    static constexpr int32 MaxFragments = 16384;
+
+    /** Collision radius of a fragment when testing against targets */
+    static constexpr float FragmentRadius = 10.0f;
+
+    // UTickableWorldSubsystem interface
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /**
+     * @brief Launches fragments evenly spread around a circle on the gameplay plane.
+     * @param Origin Launch point in world space.
+     * @param NumFragments Number of fragments to launch.
+     * @param Speed Launch speed in units per second.
+     * @param MaxBounces Number of ricochets off world geometry before a fragment breaks.
+     * @param Lifetime Seconds before a fragment that hit nothing expires.
+     * @param DamageSpec Effect applied to the first target each fragment hits. May be invalid.
+     * @param IgnoredActor Optional actor the fragments never hit.
+     * @return Number of fragments actually launched.
+     */
+    int32 LaunchRadial(const FVector& Origin, int32 NumFragments, float Speed, int32 MaxBounces, float Lifetime, const FGameplayEffectSpecHandle& DamageSpec, const AActor* IgnoredActor = nullptr);
+
+    /** @brief Sets the mesh used to draw fragments. Fragments are not drawn until a mesh is set. */
+    void SetFragmentMesh(UStaticMesh* Mesh);
+
+    /** @brief Returns the number of live fragments. */
+    int32 GetNumFragments() const { return Positions.Num(); }
+
+    /** @brief Returns the game-thread time spent in the last Tick, in seconds. */
+    double GetLastTickSeconds() const { return LastTickSeconds; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void SimulateMovement(float DeltaTime);
+    void ApplyTargetHits();
+    void RemoveDeadFragments();
+    void UpdateInstances();
+    void RemoveFragmentAt(int32 Index);
+
+    // Fragment state, one entry per live fragment in every array
+    TArray<FVector2f> Positions;
+    TArray<FVector2f> Velocities;
+    TArray<float> TimeLeft;
+    TArray<uint8> BouncesLeft;
+    TArray<int32> VolleyIndices;
+
+    /** Position at the start of the current tick, used for the target sweep */
+    TArray<FVector2f> PreviousPositions;
+
+    TSparseArray<FCOFragmentVolley> Volleys;
+
+    UPROPERTY(Transient)
+    UInstancedStaticMeshComponent* InstanceComponent = nullptr;
+
+    /** Number of instances currently drawn; instances past this are hidden but kept for reuse */
+    int32 NumVisibleInstances = 0;
+
+    double LastTickSeconds = 0.0;
+
+    /** Scratch buffers reused across frames */
+    TArray<UAbilitySystemComponent*> TargetScratch;
+    TArray<FTransform> TransformScratch;
+};
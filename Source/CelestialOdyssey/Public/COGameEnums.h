@@ -26,6 +26,21 @@ enum class ECOGameLevel : uint8
     CrystallineCaves UMETA(DisplayName = "Crystalline Caves")
 };
 
+/**
+ * @brief Returns the level that follows Level in the campaign.
+ * @return The next level, or None after the last one.
+ */
+inline ECOGameLevel GetNextGameLevel(ECOGameLevel Level)
+{
+    switch (Level)
+    {
+    case ECOGameLevel::EnchantedForestMoon:
+        return ECOGameLevel::CrystallineCaves;
+    default:
+        return ECOGameLevel::None;
+    }
+}
+
 /**
  * @enum ECOAbilitySlot
  * @brief Defines the different slots where abilities can be mapped
@@ -39,7 +54,8 @@ enum class ECOAbilitySlot : uint8
     ComboAbility UMETA(DisplayName = "Combo (Q+R/L1+R1)"), // Gravity Shift
     DashAbility UMETA(DisplayName = "Dash"),
     GroundSlamAbility UMETA(DisplayName = "Ground Slam"),
-    BasicAttack UMETA(DisplayName = "Basic Attack") // Cosmic Strike
+    BasicAttack UMETA(DisplayName = "Basic Attack"), // Cosmic Strike
+    Count UMETA(Hidden) // Number of slots, used to size per-slot tables
 };
 
 /**
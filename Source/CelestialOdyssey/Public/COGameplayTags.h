@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NativeGameplayTags.h"
+
+/**
+ * @brief Native gameplay tags used by Celestial Odyssey.
+ *
+ * Mirrors Config/Tags/CelestialOdysseyTags.ini. The tags are registered with the
+ * gameplay tag manager once when the module loads, so ability code can reference
+ * them directly instead of resolving an FName through RequestGameplayTag on every call.
+ */
+namespace COGameplayTags
+{
+    // Ability availability
+    CELESTIALODYSSEY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Available);
+    CELESTIALODYSSEY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Available_CelestialDash);
+
+    // Per-ability cooldowns
+    CELESTIALODYSSEY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Cooldown_Ability_CelestialDash);
+    CELESTIALODYSSEY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Cooldown_Ability_CosmicStrike);
+    CELESTIALODYSSEY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Cooldown_Ability_CrystalGrowth);
+    CELESTIALODYSSEY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Cooldown_Ability_CrystalShatter);
+    CELESTIALODYSSEY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Cooldown_Ability_GravityShift);
+    CELESTIALODYSSEY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Cooldown_Ability_GroundSlam);
+    CELESTIALODYSSEY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Cooldown_Ability_LunarForestFury);
+    CELESTIALODYSSEY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Cooldown_Ability_VineWhip);
+    CELESTIALODYSSEY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Cooldown_Active);
+    CELESTIALODYSSEY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Cooldown_Active_CelestialDash);
+
+    // Character state
+    CELESTIALODYSSEY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Casting);
+    CELESTIALODYSSEY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_CC_Rooted);
+    CELESTIALODYSSEY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_CC_Stunned);
+    CELESTIALODYSSEY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_GravityInverted);
+    CELESTIALODYSSEY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_OnCooldown);
+    CELESTIALODYSSEY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Stunned);
+
+    // SetByCaller data
+    CELESTIALODYSSEY_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Data_Damage);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Input actions the player controller can capture and replay.
+ * Values are written to disk, so only append new entries.
+ */
+enum class ECOInputRecordAction : uint8
+{
+    MoveRight,
+    StartJump,
+    StopJump,
+    StartSprint,
+    StopSprint,
+    CrouchOrGroundSlam,
+    StopCrouch,
+    PrimaryPressed,
+    PrimaryReleased,
+    SecondaryPressed,
+    SecondaryReleased,
+    Dash,
+    BasicAttack
+};
+
+/** One captured input action, relative to the start of the capture */
+struct FCOInputRecord
+{
+    /** Frames since the capture started */
+    uint32 Frame = 0;
+
+    /** Seconds since the capture started */
+    float Time = 0.0f;
+
+    ECOInputRecordAction Action = ECOInputRecordAction::MoveRight;
+
+    /** Axis value of the action; every bound action is a bool or 1D axis */
+    float Value = 0.0f;
+
+    friend FArchive& operator<<(FArchive& Ar, FCOInputRecord& Record)
+    {
+        uint8 Action = static_cast<uint8>(Record.Action);
+        Ar << Record.Frame << Record.Time << Action << Record.Value;
+        Record.Action = static_cast<ECOInputRecordAction>(Action);
+        return Ar;
+    }
+};
+
+/**
+ * @class FCOInputRecording
+ * @brief A captured input stream plus the fixed timestep it should be replayed at.
+ *
+ * Stored as a small binary file: a magic/version header, the timestep, the frame count and the packed records (13 bytes each).
+ */
+class CELESTIALODYSSEY_API FCOInputRecording
+{
+public:
+    /** Timestep the recording is replayed at, in seconds */
+    float FixedDeltaTime = 1.0f / 60.0f;
+
+    /** Length of the capture in frames; playback runs at least this long */
+    uint32 NumFrames = 0;
+
+    /** Captured actions in the order they were received */
+    TArray<FCOInputRecord> Records;
+
+    /**
+     * @brief Writes the recording to disk.
+     * @param Filename Absolute path, or a path relative to Saved/InputRecordings.
+     * @return true if the file was written.
+     */
+    bool SaveToFile(const FString& Filename) const;
+
+    /**
+     * @brief Replaces this recording with the contents of a file.
+     * @param Filename Absolute path, or a path relative to Saved/InputRecordings.
+     * @return true if the file exists and has a supported header.
+     */
+    bool LoadFromFile(const FString& Filename);
+
+    /** Resolves a relative recording name against Saved/InputRecordings */
+    static FString ResolvePath(const FString& Filename);
+
+private:
+    static constexpr uint32 FileMagic = 0x52494F43; // "COIR"
+    static constexpr uint32 FileVersion = 1;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "COGameEnums.h"
+#include "COLevelAbilitySet.generated.h"
+
+class UGameplayAbility;
+
+/**
+ * @class UCOLevelAbilitySet
+ * @brief Soft-referenced ability mapping for one level, registered with the Asset Manager as a primary asset.
+ *
+ * Every ability is held in the "Abilities" asset bundle, so nothing is loaded until the player state asks
+ * for the set. Loading the set for the next level while the current one plays keeps only two levels'
+ * abilities (and the GameplayEffects they reference) resident at any time.
+ */
+UCLASS(BlueprintType)
+class CELESTIALODYSSEY_API UCOLevelAbilitySet : public UPrimaryDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    /** Primary asset type used for every level ability set */
+    static const FPrimaryAssetType PrimaryAssetType;
+
+    /** Name of the bundle holding the ability classes */
+    static const FName AbilitiesBundle;
+
+    /** Level this set belongs to */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Level")
+    ECOGameLevel Level = ECOGameLevel::None;
+
+    /** Primary ability for this level (Q/L1) */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Abilities", meta = (AssetBundles = "Abilities"))
+    TSoftClassPtr<UGameplayAbility> PrimaryAbility;
+
+    /** Secondary ability for this level (R/R1) */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Abilities", meta = (AssetBundles = "Abilities"))
+    TSoftClassPtr<UGameplayAbility> SecondaryAbility;
+
+    /** Combo ability (Q+R/L1+R1) */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Abilities", meta = (AssetBundles = "Abilities"))
+    TSoftClassPtr<UGameplayAbility> ComboAbility;
+
+    /** Core abilities that are always available in this level */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Abilities", meta = (AssetBundles = "Abilities"))
+    TArray<TSoftClassPtr<UGameplayAbility>> CoreAbilities;
+
+    virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+    /**
+     * @brief Copies the loaded ability classes into a hard mapping.
+     * @param OutMapping Mapping to fill; entries whose class is not loaded yet are left empty.
+     */
+    void ResolveMapping(FCOLevelAbilityMapping& OutMapping) const;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Logging/LogMacros.h"
+
+/**
+ * Log category for the module.
+ * Verbose and VeryVerbose are compiled out of Development builds, and Shipping keeps only warnings and errors.
+ */
+#if UE_BUILD_SHIPPING
+CELESTIALODYSSEY_API DECLARE_LOG_CATEGORY_EXTERN(LogCelestialOdyssey, Warning, Warning);
+#elif UE_BUILD_DEBUG
+CELESTIALODYSSEY_API DECLARE_LOG_CATEGORY_EXTERN(LogCelestialOdyssey, Log, All);
+#else
+CELESTIALODYSSEY_API DECLARE_LOG_CATEGORY_EXTERN(LogCelestialOdyssey, Log, Log);
+#endif
+
+#if !UE_BUILD_SHIPPING
+
+/** Backing value of co.Abilities.Trace */
+extern CELESTIALODYSSEY_API int32 GCOAbilityTrace;
+
+/**
+ * Per-activation and per-input tracing. Off by default; "co.Abilities.Trace 1" turns it on at runtime.
+ * Arguments (including any ToString calls) are only evaluated when tracing is on. Compiled out in Shipping.
+ */
+#define CO_ABILITY_TRACE(Format, ...) \
+    do \
+    { \
+        if (UNLIKELY(GCOAbilityTrace != 0)) \
+        { \
+            UE_LOG(LogCelestialOdyssey, Log, Format, ##__VA_ARGS__); \
+        } \
+    } while (0)
+
+#else
+
+#define CO_ABILITY_TRACE(Format, ...) do {} while (0)
+
+#endif
+
+#if !NO_LOGGING
+
+/**
+ * Logs at most once per IntervalSeconds from each call site, for messages that can fire every frame or activation.
+ * Arguments are only evaluated when the message is actually written.
+ */
+#define CO_LOG_RATE_LIMITED(IntervalSeconds, Verbosity, Format, ...) \
+    do \
+    { \
+        static double CO_LastLogTime = -DBL_MAX; \
+        const double CO_Now = FPlatformTime::Seconds(); \
+        if (CO_Now - CO_LastLogTime >= (IntervalSeconds)) \
+        { \
+            CO_LastLogTime = CO_Now; \
+            UE_LOG(LogCelestialOdyssey, Verbosity, Format, ##__VA_ARGS__); \
+        } \
+    } while (0)
+
+#else
+
+#define CO_LOG_RATE_LIMITED(IntervalSeconds, Verbosity, Format, ...) do {} while (0)
+
+#endif
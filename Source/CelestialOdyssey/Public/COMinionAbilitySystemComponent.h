@@ -0,0 +1,116 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilitySystemComponent.h"
+#include "COMinionAttributeSubsystem.h"
+#include "COMinionAbilitySystemComponent.generated.h"
+
+/**
+ * @struct FCOMinionActiveEffect
+ * @brief Bookkeeping for a duration or infinite effect applied to a minion.
+ */
+struct FCOMinionActiveEffect
+{
+    FActiveGameplayEffectHandle Handle;
+    FGameplayTagContainer GrantedTags;
+
+    /** Definition and instigator, so a stacking effect applied again can find the one it refreshes */
+    TWeakObjectPtr<const UGameplayEffect> Definition;
+    TWeakObjectPtr<UAbilitySystemComponent> Instigator;
+
+    /** Damage over time the status subsystem runs for a periodic effect, INDEX_NONE otherwise */
+    int32 DamageOverTimeId = INDEX_NONE;
+};
+
+/**
+ * @class UCOMinionAbilitySystemComponent
+ * @brief Ability System Component for minion-tier enemies that keeps attributes in UCOMinionAttributeSubsystem.
+ *
+ * It is still an ASC, so the target grid, area fields and abilities keep passing it specs unchanged. Effects are
+ * not added to the active effect container, though: their modifiers are evaluated once and written to the
+ * minion's slot in the world attribute store. The component does not tick and owns no attribute set.
+ * Modifiers on UCOEnemyAttributeSet's Health and MovementSpeed are honoured, so effects authored for full
+ * enemies such as GE_BasicDamage and GE_CrystalShatter_Slow work as before.
+ *
+ * What differs from a regular ASC:
+ *   - The effect's application requirements (chance, tag requirements, custom requirements) and immunity
+ *     granted by effects on the regular container are checked. Modifier tag requirements are checked once,
+ *     when the effect is applied. Immunity granted by an effect applied to the minion itself is not.
+ *   - A stacking effect that is already active is refreshed rather than stacked.
+ *   - Periodic effects that only drain Health run as damage over time on UCOStatusEffectSubsystem; any other
+ *     periodic effect only grants its tags.
+ *   - Execution calculations are not supported.
+ *
+ * The component does not replicate, so granted tags and the CC tags added by UCOStatusEffectSubsystem only
+ * exist on the server. Minion AI runs there, and clients see a rooted or stunned minion through its replicated
+ * movement. A minion whose state clients must read, or that needs any of the above, should use a regular ASC.
+ *
+ * Lightweight here means no attribute set, no tick and no replication. The base ASC's ability and effect
+ * containers are still members of the class and stay empty, so their fixed size is paid per minion.
+ * CelestialOdyssey.Perf.MinionMemory reports the cost against a regular ASC with UCOEnemyAttributeSet.
+ */
+UCLASS(ClassGroup = (AbilitySystem), meta = (BlueprintSpawnableComponent))
+class CELESTIALODYSSEY_API UCOMinionAbilitySystemComponent : public UAbilitySystemComponent
+{
+    GENERATED_BODY()
+
+public:
+    UCOMinionAbilitySystemComponent();
+
+    // UAbilitySystemComponent interface
+    virtual FActiveGameplayEffectHandle ApplyGameplayEffectSpecToSelf(const FGameplayEffectSpec& GameplayEffect, FPredictionKey PredictionKey = FPredictionKey()) override;
+    virtual bool RemoveActiveGameplayEffect(FActiveGameplayEffectHandle Handle, int32 StacksToRemove = -1) override;
+
+    /** Current health, including active modifiers */
+    UFUNCTION(BlueprintPure, Category = "Attributes")
+    float GetHealth() const;
+
+    /** Current movement speed, including active modifiers */
+    UFUNCTION(BlueprintPure, Category = "Attributes")
+    float GetMovementSpeed() const;
+
+    /** Base value of an attribute in the store, for systems that write attributes without an effect spec */
+    float GetAttributeBaseValue(const FGameplayAttribute& Attribute) const;
+
+    /** Applies an instant modifier to an attribute's base value, the minion counterpart of ApplyModToAttribute */
+    void ApplyAttributeModifier(const FGameplayAttribute& Attribute, EGameplayModOp::Type Op, float Magnitude);
+
+    /** Same attributes as UCOEnemyAttributeSet, so effects can target either kind of enemy */
+    static FGameplayAttribute GetHealthAttribute();
+    static FGameplayAttribute GetMovementSpeedAttribute();
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    /** Health the minion starts with */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attributes")
+    float InitialHealth = 100.0f;
+
+    /** Movement speed the minion starts with */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attributes")
+    float InitialMovementSpeed = 600.0f;
+
+private:
+    /** Returns false if the effect's requirements or an active immunity block it */
+    bool CanApplyEffect(const FGameplayEffectSpec& Spec);
+
+    /** Removes the active effect a stacking spec would stack onto, so the new application replaces it */
+    void RemoveStackedEffect(const FGameplayEffectSpec& Spec);
+
+    /** Starts the native damage over time of a periodic effect. Returns INDEX_NONE if it cannot be simulated */
+    int32 StartDamageOverTime(const FGameplayEffectSpec& Spec);
+
+    /** Maps an attribute set attribute to its column in the store */
+    static bool ToMinionAttribute(const FGameplayAttribute& Attribute, ECOMinionAttribute& OutAttribute);
+
+    float GetCurrentValue(ECOMinionAttribute Attribute) const;
+
+    UPROPERTY(Transient)
+    UCOMinionAttributeSubsystem* AttributeStore = nullptr;
+
+    /** Slot of this minion in the attribute store */
+    int32 AttributeSlot = INDEX_NONE;
+
+    TArray<FCOMinionActiveEffect> ActiveEffects;
+};
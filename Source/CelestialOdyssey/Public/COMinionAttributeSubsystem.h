@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayEffectTypes.h"
+#include "ActiveGameplayEffectHandle.h"
+#include "COMinionAttributeSubsystem.generated.h"
+
+/**
+ * @enum ECOMinionAttribute
+ * @brief Attributes stored for minions. Mirrors UCOEnemyAttributeSet.
+ */
+enum class ECOMinionAttribute : uint8
+{
+    Health,
+    MovementSpeed,
+
+    Count
+};
+
+/**
+ * @struct FCOMinionModifier
+ * @brief A modifier from a duration or infinite gameplay effect, applied on top of a minion's base value.
+ */
+struct FCOMinionModifier
+{
+    int32 Slot = INDEX_NONE;
+    FActiveGameplayEffectHandle Handle;
+    ECOMinionAttribute Attribute = ECOMinionAttribute::Health;
+    TEnumAsByte<EGameplayModOp::Type> Op = EGameplayModOp::Additive;
+    float Magnitude = 0.0f;
+};
+
+/**
+ * @class UCOMinionAttributeSubsystem
+ * @brief World-level structure-of-arrays store for minion attributes.
+ *
+ * Every minion owns a slot. Base and current values are kept in one float array per attribute, so a minion costs
+ * a few floats instead of an attribute set object. Instant effects change base values, as in GAS. Duration effects
+ * add modifiers that are folded into the current value, and are removed again by their active effect handle.
+ */
+UCLASS()
+class CELESTIALODYSSEY_API UCOMinionAttributeSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    /**
+     * @brief Reserves a slot for a new minion.
+     * @return The slot index used by every other call.
+     */
+    int32 AllocateSlot(float Health, float MovementSpeed);
+
+    /** @brief Frees a slot and drops its modifiers. */
+    void ReleaseSlot(int32 Slot);
+
+    /** @brief Current value of an attribute, including active modifiers. */
+    float GetCurrentValue(int32 Slot, ECOMinionAttribute Attribute) const { return CurrentValues[static_cast<int32>(Attribute)][Slot]; }
+
+    /** @brief Base value of an attribute. */
+    float GetBaseValue(int32 Slot, ECOMinionAttribute Attribute) const { return BaseValues[static_cast<int32>(Attribute)][Slot]; }
+
+    /** @brief Applies an instant modifier to the base value. */
+    void ApplyInstant(int32 Slot, ECOMinionAttribute Attribute, EGameplayModOp::Type Op, float Magnitude);
+
+    /** @brief Adds a modifier that lasts until RemoveModifiers is called with the same handle. */
+    void AddModifier(int32 Slot, const FActiveGameplayEffectHandle& Handle, ECOMinionAttribute Attribute, EGameplayModOp::Type Op, float Magnitude);
+
+    /** @brief Removes every modifier added with a handle. */
+    void RemoveModifiers(int32 Slot, const FActiveGameplayEffectHandle& Handle);
+
+    /** @brief Returns the number of minions holding a slot. */
+    int32 GetNumMinions() const { return NumAllocated; }
+
+    /** @brief Bytes allocated by the store, used by the benchmark to report memory per minion. */
+    SIZE_T GetAllocatedSize() const;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    static constexpr int32 NumAttributes = static_cast<int32>(ECOMinionAttribute::Count);
+
+    /** Recomputes the current value from the base value and the slot's modifiers */
+    void UpdateCurrentValue(int32 Slot, ECOMinionAttribute Attribute);
+
+    /** Applies the same limits as UCOEnemyAttributeSet::PreAttributeChange */
+    static float ClampValue(ECOMinionAttribute Attribute, float Value);
+
+    TArray<float> BaseValues[NumAttributes];
+    TArray<float> CurrentValues[NumAttributes];
+
+    TArray<int32> FreeSlots;
+    int32 NumAllocated = 0;
+
+    /** Active modifiers of all minions; few minions carry any at a time */
+    TArray<FCOMinionModifier> Modifiers;
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "COEnemyCharacter.h"
+#include "COMinionCharacter.generated.h"
+
+/**
+ *  Minion-tier enemy meant to be spawned in large numbers.
+ *  Swaps the enemy's Ability System Component for UCOMinionAbilitySystemComponent and drops the attribute set;
+ *  health and movement speed live in the world's UCOMinionAttributeSubsystem instead.
+ */
+UCLASS()
+class CELESTIALODYSSEY_API ACOMinionCharacter : public ACOEnemyCharacter
+{
+	GENERATED_BODY()
+
+public:
+	//Constructor
+	ACOMinionCharacter(const FObjectInitializer& ObjectInitializer);
+};
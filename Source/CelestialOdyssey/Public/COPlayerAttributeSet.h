@@ -22,6 +22,9 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attributes")
     FGameplayAttributeData Lives;
 
+    /** Lives attribute, which hits on the player are taken from */
+    GAMEPLAYATTRIBUTE_PROPERTY_GETTER(UCOPlayerAttributeSet, Lives)
+
     /** Getter for Lives attribute */
     UFUNCTION(BlueprintCallable, Category = "Attributes")
     float GetLives() const { return Lives.GetCurrentValue(); }
@@ -17,16 +17,19 @@ class CELESTIALODYSSEY_API ACOPlayerCharacter : public ACOBaseCharacter
 	
 public:
 	//Constructor
-	ACOPlayerCharacter();
+	ACOPlayerCharacter(const FObjectInitializer& ObjectInitializer);
 
 protected:
 	//Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-public:
-	//Called every frame
-	virtual void Tick(float DeltaTime) override;
+	//Keeps the falling/jumping animation flags in sync with the movement mode
+	virtual void OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode = 0) override;
+
+	//Called once the movement component has actually performed a jump
+	virtual void OnJumped_Implementation() override;
 
+public:
 	//Handles player movement input (right/left)
 	virtual void MoveRight(float Value) override;
 
@@ -68,6 +71,14 @@ public:
 	// Setter for bHasReachedCeiling
 	void SetHasReachedCeiling(bool bValue) { bHasReachedCeiling = bValue; }
 
+	// Seconds until the predicted ceiling contact, or -1 when no contact is predicted.
+	// Lets the animation blueprint start the flip before the capsule actually touches.
+	UFUNCTION(BlueprintPure, Category = "Gravity Shift")
+	float GetTimeUntilCeilingContact() const;
+
+	// Records the world time at which the ceiling contact is expected (negative clears it)
+	void SetPredictedCeilingContactTime(float WorldTime) { PredictedCeilingContactTime = WorldTime; }
+
 	//This function allows the character to interact with abilities that are owned by the Player State.
 	virtual UAbilitySystemComponent* GetAbilitySystemComponent() const;
 
@@ -99,6 +110,9 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "Gravity Shift")
 	bool bHasReachedCeiling = false;
 
+	// World time of the predicted ceiling contact, negative when none is pending
+	float PredictedCeilingContactTime = -1.0f;
+
 	// Spring Arm for camera follow
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Camera")
 	class USpringArmComponent* CameraBoom;
@@ -7,8 +7,33 @@
 #include "InputAction.h"
 #include "InputMappingContext.h"
 #include "COGameEnums.h"
+#include "COInputRecording.h"
 #include "COPlayerController.generated.h"
 
+/** Shoulder-button transitions recorded in the controller's input history */
+enum class ECOBufferedInputAction : uint8
+{
+    PrimaryPressed,
+    PrimaryReleased,
+    SecondaryPressed,
+    SecondaryReleased
+};
+
+/** One entry of the input history, stamped with the frame and times it arrived */
+struct FCOBufferedInput
+{
+    ECOBufferedInputAction Action = ECOBufferedInputAction::PrimaryPressed;
+
+    /** GFrameCounter when the input was received */
+    uint64 Frame = 0;
+
+    /** World time when the input was received, used for the combo window */
+    double WorldTime = 0.0;
+
+    /** Platform time when the input was received, used for latency measurement */
+    double PlatformTime = 0.0;
+};
+
 /**
  * @class ACOPlayerController
  * @brief Player-specific controller class that handles input binding and ability activation.
@@ -31,6 +56,39 @@ public:
      * @param Value The input value from Enhanced Input
      */
     void ActivateAbilityFromSlot(ECOAbilitySlot Slot, const FInputActionValue& Value);
+
+    /**
+     * @brief Reports input-to-activation latency of buffered shoulder-button abilities
+     * @param OutAverageMs Mean latency over the recorded samples, in milliseconds
+     * @param OutP99Ms 99th percentile latency over the recorded samples, in milliseconds
+     * @return Number of samples the figures are based on
+     */
+    UFUNCTION(BlueprintCallable, Category = "Input")
+    int32 GetInputLatencyStats(float& OutAverageMs, float& OutP99Ms) const;
+
+    /**
+     * @brief Starts recording every bound input action with frame and time stamps
+     * @param Filename Where the recording is written when capture stops (relative to Saved/InputRecordings)
+     */
+    void StartInputCapture(const FString& Filename);
+
+    /** @brief Stops recording and writes the capture to disk; no-op when not capturing */
+    void StopInputCapture();
+
+    /**
+     * @brief Replays a recording through the input handlers under a fixed timestep, ignoring live input
+     *
+     * Started automatically with -COInputPlayback=<file>; add -COQuitAfterPlayback to exit when it ends.
+     * A CSV profiler capture covers the playback when the build has the CSV profiler.
+     *
+     * @param Filename Recording to load (relative to Saved/InputRecordings)
+     * @return true if the recording was loaded and playback started
+     */
+    bool StartInputPlayback(const FString& Filename);
+
+    /** @brief True while a recording is driving the handlers */
+    bool IsPlayingBackInput() const { return bIsPlayingBackInput; }
+
 protected:
     /**
      * @brief Wrapper function to activate the Dash ability from the ability slot system
@@ -53,9 +111,15 @@ protected:
     /** @brief Called when the game starts */
     virtual void BeginPlay() override;
 
+    /** @brief Flushes an active input capture */
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
     /** @brief Sets up input bindings */
     virtual void SetupInputComponent() override;
 
+    /** @brief Resolves buffered shoulder-button input after this frame's input has been processed */
+    virtual void PlayerTick(float DeltaTime) override;
+
     // Movement Input Handlers
     /** @brief Handles horizontal movement input */
     void MoveRight(const FInputActionValue& Value);
@@ -85,36 +149,48 @@ protected:
     /** @brief Handles primary ability input (Q/L1) */
     void HandlePrimaryAbility(const FInputActionValue& Value);
 
+    /** @brief Handles primary ability release (Q/L1) */
+    void HandlePrimaryAbilityReleased(const FInputActionValue& Value);
+
     /** @brief Handles secondary ability input (R/R1) */
     void HandleSecondaryAbility(const FInputActionValue& Value);
 
+    /** @brief Handles secondary ability release (R/R1) */
+    void HandleSecondaryAbilityReleased(const FInputActionValue& Value);
+
     /** @brief Handles combo ability input (Q+R/L1+R1) */
     void HandleComboAbility(const FInputActionValue& Value);
 
-    // Input State Management
-    /** @brief Checks for gravity shift combo activation */
-    bool CheckForGravityShift();
-
-    /** @brief Resets shoulder button states */
-    void ResetShoulderButtonStates();
-
-    /** @brief Updates input mappings when changing levels */
-    void UpdateInputMappingForCurrentLevel();
+    // Input Buffer
+    /** @brief Appends an input to the history, overwriting the oldest entry when full */
+    void BufferInput(ECOBufferedInputAction Action);
 
     /**
-     * @brief Processes any pending ability activation
+     * @brief Walks the inputs received since the last call and fires single or combo abilities
      *
-     * This function is called after the combo time window expires to activate
-     * any pending single-button ability if no combo was detected.
+     * A press waits for the other shoulder button only while the chord is still possible: it fires as soon as
+     * its button is released, the same button is pressed again, or the combo window elapses.
      */
-    void ProcessPendingAbility();
+    void ResolveBufferedInput();
 
-    /**
-     * @brief Checks if both buttons were pressed within the combo time window
-     *
-     * @return true if both buttons were pressed within ComboTimeWindow seconds of each other
-     */
-    bool CheckForSimultaneousPress();
+    /** @brief Activates a slot on behalf of a buffered input and records the latency since that input */
+    void ActivateBufferedAbility(ECOAbilitySlot Slot, const FCOBufferedInput& SourceInput);
+
+    // Input Recording
+    /** @brief Binds an action so it goes through DispatchInputAction, where it can be recorded */
+    void BindRecordedAction(UEnhancedInputComponent* EnhancedInputComponent, const UInputAction* Action, ETriggerEvent TriggerEvent, ECOInputRecordAction RecordAction);
+
+    /** @brief Records the action if capturing, then calls its handler; shared by live input and playback */
+    void DispatchInputAction(ECOInputRecordAction Action, const FInputActionValue& Value);
+
+    /** @brief Feeds the recorded actions due this frame into DispatchInputAction */
+    void PumpInputPlayback();
+
+    /** @brief Ends playback, closes the CSV capture and optionally quits */
+    void FinishInputPlayback();
+
+    /** @brief Updates input mappings when changing levels */
+    void UpdateInputMappingForCurrentLevel();
 
     // Level Properties
     /** @brief Current level identifier */
@@ -130,13 +206,6 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input")
     UInputMappingContext* GeneralInputMappingContext;
 
-    // Input State Tracking
-    /** @brief Tracks left shoulder button state */
-    bool bGamepadShoulderLeftPressed = false;
-
-    /** @brief Tracks right shoulder button state */
-    bool bGamepadShoulderRightPressed = false;
-
     // Input Actions
     /** @brief Movement right/left */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input")
@@ -170,18 +239,50 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input")
     UInputAction* GamepadShoulderRightAction;
 
-    /** Time of last left shoulder button/Q key press */
-    float LastShoulderLeftPressTime;
+    /** Time window in seconds in which both shoulder buttons must be pressed to trigger the combo */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input", meta = (ClampMin = "0.0", Units = "s"))
+    float ComboTimeWindow = 0.2f;
+
+    /** Capacity of the input history ring buffer */
+    static constexpr int32 InputHistoryCapacity = 32;
+
+    /** Ring buffer of recent shoulder-button inputs */
+    TStaticArray<FCOBufferedInput, InputHistoryCapacity> InputHistory;
+
+    /** Total inputs ever buffered; the newest lives at (NumBufferedInputs - 1) % InputHistoryCapacity */
+    uint32 NumBufferedInputs = 0;
+
+    /** Total inputs already resolved */
+    uint32 NumResolvedInputs = 0;
+
+    /** Press waiting to see whether it becomes a combo */
+    TOptional<FCOBufferedInput> PendingPress;
+
+    /** Capacity of the latency sample ring */
+    static constexpr int32 LatencySampleCapacity = 256;
+
+    /** Recent input-to-activation latencies in milliseconds */
+    TStaticArray<float, LatencySampleCapacity> LatencySamplesMs;
+
+    /** Total latency samples ever recorded */
+    uint32 NumLatencySamples = 0;
+
+    /** Recording being captured or played back */
+    FCOInputRecording InputRecording;
+
+    /** Destination of the active capture */
+    FString InputCaptureFilename;
 
-    /** Time of last right shoulder button/R key press */
-    float LastShoulderRightPressTime;
+    bool bIsCapturingInput = false;
+    uint64 InputCaptureStartFrame = 0;
+    double InputCaptureStartTime = 0.0;
 
-    /** Time window in seconds for detecting simultaneous button presses */
-    static constexpr float ComboTimeWindow = 0.2f;
+    bool bIsPlayingBackInput = false;
+    bool bQuitAfterPlayback = false;
 
-    /** Tracks if an ability activation is currently pending */
-    bool bIsAbilityActivationPending;
+    /** Next record to replay */
+    int32 PlaybackRecordIndex = 0;
 
-    /** Stores the type of ability pending activation */
-    ECOAbilitySlot PendingAbilitySlot;
+    /** Frames since playback started */
+    uint32 PlaybackFrame = 0;
 };
\ No newline at end of file
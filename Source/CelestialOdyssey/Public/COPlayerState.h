@@ -6,6 +6,7 @@
 #include "AbilitySystemInterface.h"
 #include "COPlayerAttributeSet.h"
 #include "COGameEnums.h" // Add this new include
+#include "Engine/StreamableManager.h"
 #include "COPlayerState.generated.h"
 
 /**
@@ -33,10 +34,17 @@ public:
     UPROPERTY(BlueprintReadWrite, Category = "Level")
     ECOGameLevel CurrentLevel;
 
-    /** Mapping of abilities for each level */
+    /**
+     * Inline mapping of abilities for each level (hard references), used for any level whose ability set is not
+     * loaded. Keeps levels playable until their LevelAbilitySets entries are authored.
+     */
     UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Abilities")
     TMap<ECOGameLevel, FCOLevelAbilityMapping> LevelAbilityMappings;
 
+    /** Soft-referenced ability set for each level, loaded when the level starts and preloaded one level ahead */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Abilities", meta = (AllowedTypes = "COLevelAbilitySet"))
+    TMap<ECOGameLevel, FPrimaryAssetId> LevelAbilitySets;
+
     /** Gets the Ability System Component */
     virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override;
 
@@ -53,6 +61,13 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Level Management")
     void SetCurrentLevel(ECOGameLevel NewLevel);
 
+    /**
+     * @brief Starts loading a level's ability set in the background
+     * @param Level The level whose abilities should be made resident
+     */
+    UFUNCTION(BlueprintCallable, Category = "Level Management")
+    void PreloadLevelAbilities(ECOGameLevel Level);
+
     /**
      * @brief Gets the ability assigned to a specific slot for the current level
      * @param Slot The ability slot to query
@@ -61,37 +76,47 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Abilities")
     TSubclassOf<UGameplayAbility> GetAbilityForSlot(ECOAbilitySlot Slot) const;
 
-    /** @deprecated Use LevelAbilityMappings instead */
+    /**
+     * @brief Gets the granted spec handle for a slot, filled in by UpdateAvailableAbilities
+     * @param Slot The ability slot to query
+     * @return The spec handle to activate, invalid if nothing is granted in that slot
+     */
+    FGameplayAbilitySpecHandle GetAbilityHandleForSlot(ECOAbilitySlot Slot) const
+    {
+        return SlotAbilityHandles[static_cast<int32>(Slot)];
+    }
+
+    /** @deprecated Use LevelAbilitySets instead. Only identifies which core ability fills a slot; never loaded here */
     UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Abilities|Legacy")
-    TSubclassOf<UGameplayAbility> CelestialDashAbilityClass;
+    TSoftClassPtr<UGameplayAbility> CelestialDashAbilityClass;
 
-    /** @deprecated Use LevelAbilityMappings instead */
+    /** @deprecated Use LevelAbilitySets instead. Only identifies which core ability fills a slot; never loaded here */
     UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Abilities|Legacy")
-    TSubclassOf<UGameplayAbility> GroundSlamAbilityClass;
+    TSoftClassPtr<UGameplayAbility> GroundSlamAbilityClass;
 
-    /** @deprecated Use LevelAbilityMappings instead */
+    /** @deprecated Use LevelAbilitySets instead. Only identifies which core ability fills a slot; never loaded here */
     UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Abilities|Legacy")
-    TSubclassOf<UGameplayAbility> GravityShiftAbilityClass;
+    TSoftClassPtr<UGameplayAbility> GravityShiftAbilityClass;
 
-    /** @deprecated Use LevelAbilityMappings instead */
+    /** @deprecated Use LevelAbilitySets instead. Only identifies which core ability fills a slot; never loaded here */
     UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Abilities|Legacy")
-    TSubclassOf<UGameplayAbility> CosmicStrikeAbilityClass;
+    TSoftClassPtr<UGameplayAbility> CosmicStrikeAbilityClass;
 
-    /** @deprecated Use LevelAbilityMappings instead */
+    /** @deprecated Use LevelAbilitySets instead. Only identifies which core ability fills a slot; never loaded here */
     UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Abilities|Legacy")
-    TSubclassOf<UGameplayAbility> CrystalGrowthAbilityClass;
+    TSoftClassPtr<UGameplayAbility> CrystalGrowthAbilityClass;
 
-    /** @deprecated Use LevelAbilityMappings instead */
+    /** @deprecated Use LevelAbilitySets instead. Only identifies which core ability fills a slot; never loaded here */
     UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Abilities|Legacy")
-    TSubclassOf<UGameplayAbility> CrystalShatterAbilityClass;
+    TSoftClassPtr<UGameplayAbility> CrystalShatterAbilityClass;
 
-    /** @deprecated Use LevelAbilityMappings instead */
+    /** @deprecated Use LevelAbilitySets instead. Only identifies which core ability fills a slot; never loaded here */
     UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Abilities|Legacy")
-    TSubclassOf<UGameplayAbility> VineWhipAbilityClass;
+    TSoftClassPtr<UGameplayAbility> VineWhipAbilityClass;
 
-    /** @deprecated Use LevelAbilityMappings instead */
+    /** @deprecated Use LevelAbilitySets instead. Only identifies which core ability fills a slot; never loaded here */
     UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Abilities|Legacy")
-    TSubclassOf<UGameplayAbility> LunarForestFuryAbilityClass;
+    TSoftClassPtr<UGameplayAbility> LunarForestFuryAbilityClass;
 
 protected:
     /** Called when the game starts */
@@ -100,6 +125,28 @@ protected:
     /** Updates available abilities based on current level */
     void UpdateAvailableAbilities();
 
+    /** Returns the loaded data-asset mapping for a level, falling back to LevelAbilityMappings */
+    const FCOLevelAbilityMapping* FindAbilityMapping(ECOGameLevel Level) const;
+
+    /** Returns the core ability of a mapping that a legacy slot property points to, without loading the property */
+    static TSubclassOf<UGameplayAbility> FindCoreAbility(const FCOLevelAbilityMapping& Mapping, const TSoftClassPtr<UGameplayAbility>& SlotAbilityClass);
+
+    /** Requests a level's ability set bundle from the Asset Manager; no-op when already requested */
+    void RequestLevelAbilitySet(ECOGameLevel Level);
+
+    /** Resolves a loaded ability set and refreshes abilities if it belongs to the current level */
+    void OnLevelAbilitySetLoaded(ECOGameLevel Level);
+
+    /** Unloads every requested ability set other than the current and next level's */
+    void ReleaseUnusedLevelAbilitySets();
+
+    /** Mappings resolved from loaded ability sets; holding them keeps the classes resident */
+    UPROPERTY(Transient)
+    TMap<ECOGameLevel, FCOLevelAbilityMapping> LoadedAbilityMappings;
+
+    /** In-flight or completed ability set loads, per level */
+    TMap<ECOGameLevel, TSharedPtr<FStreamableHandle>> LevelAbilitySetHandles;
+
     /** Ability System Component that manages abilities */
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Abilities")
     UAbilitySystemComponent* AbilitySystemComponent;
@@ -108,6 +155,9 @@ protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Attributes")
     UCOPlayerAttributeSet* AttributeSet;
 
+    /** Spec handle granted for each ECOAbilitySlot in the current level, indexed by the slot value */
+    TStaticArray<FGameplayAbilitySpecHandle, static_cast<int32>(ECOAbilitySlot::Count)> SlotAbilityHandles;
+
     /** Data table for initializing attributes */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attributes")
     UDataTable* AttributeDataTable;
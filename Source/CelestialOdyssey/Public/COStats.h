@@ -0,0 +1,14 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+/**
+ * Stat group for gameplay systems in this module. View in game with "stat CelestialOdyssey" or in Insights.
+ */
+DECLARE_STATS_GROUP(TEXT("CelestialOdyssey"), STATGROUP_CelestialOdyssey, STATCAT_Advanced);
+
+// Ability granting
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Available Abilities"), STAT_CO_UpdateAvailableAbilities, STATGROUP_CelestialOdyssey, CELESTIALODYSSEY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Abilities Granted"), STAT_CO_AbilitiesGranted, STATGROUP_CelestialOdyssey, CELESTIALODYSSEY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Abilities Removed"), STAT_CO_AbilitiesRemoved, STATGROUP_CelestialOdyssey, CELESTIALODYSSEY_API);
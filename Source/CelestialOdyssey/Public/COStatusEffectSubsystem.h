@@ -0,0 +1,234 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayTagContainer.h"
+#include "UObject/ObjectKey.h"
+#include "ActiveGameplayEffectHandle.h"
+#include "CODamageAccumulatorSubsystem.h"
+#include "COExpirySubsystem.h"
+#include "COStatusEffectSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+struct FGameplayEffectSpec;
+
+/**
+ * @enum ECOStatusType
+ * @brief Status kinds timed by UCOStatusEffectSubsystem.
+ */
+enum class ECOStatusType : uint8
+{
+    /** The effect's MovementSpeed modifiers, held for the status' duration */
+    Slow,
+
+    /** The effect, which also grants State.CC.Rooted */
+    Root,
+
+    /** The effect, which also grants State.CC.Stunned */
+    Stun,
+
+    /** Drains health natively, one period's damage at a time */
+    DamageOverTime,
+
+    Count
+};
+
+/**
+ * @struct FCOStatusList
+ * @brief Packed storage for every active status of one type. Entries are swap-removed, so order is not stable.
+ */
+struct FCOStatusList
+{
+    TArray<int32> Ids;
+    TArray<int32> TargetSlots;
+
+    /** Index of each status id in the arrays above */
+    TMap<int32, int32> IndicesById;
+
+    /** Slows, roots and stuns: the active effect held for the status, invalid for instant effects. Empty for DoTs */
+    TArray<FActiveGameplayEffectHandle> EffectHandles;
+
+    /** Slows, roots and stuns: the status' expiry on the expiry wheel. Empty for DoTs */
+    TArray<FCOExpiryHandle> ExpiryHandles;
+
+    /**
+     * Damage over time only: seconds left, the effect's period, seconds until the next period, damage per period,
+     * damage of the periods that elapsed this frame, who dealt it and the health attribute it is taken from
+     */
+    TArray<float> TimeLeft;
+    TArray<float> Periods;
+    TArray<float> TimeToNextPeriod;
+    TArray<float> DamagePerPeriod;
+    TArray<float> PendingDamage;
+    TArray<FCODamageSource> Sources;
+    TArray<FGameplayAttribute> Attributes;
+
+    int32 Num() const { return Ids.Num(); }
+};
+
+/**
+ * @struct FCODamageOverTime
+ * @brief Damage a periodic health drain deals, as read from its gameplay effect.
+ */
+struct FCODamageOverTime
+{
+    float DamagePerPeriod = 0.0f;
+    float Period = 0.0f;
+
+    /** Whether the first period's damage is dealt on application, as bExecutePeriodicEffectOnApplication */
+    bool bDamageOnApplication = false;
+
+    /** Health attribute the damage is taken from */
+    FGameplayAttribute Attribute;
+};
+
+/**
+ * @struct FCOStatusTarget
+ * @brief Per-target bookkeeping shared by every status on one Ability System Component.
+ */
+struct FCOStatusTarget
+{
+    TWeakObjectPtr<UAbilitySystemComponent> AbilitySystem;
+
+    /** Lookup key of the component; stays usable after the component is destroyed */
+    TObjectKey<UAbilitySystemComponent> Key;
+
+    /** False while the slot sits in the free list */
+    bool bInUse = false;
+
+    /** Set once the component is gone; the target's statuses are dropped in the same tick */
+    bool bStale = false;
+
+    /** Active statuses of each type on this target */
+    int32 NumStatuses[static_cast<int32>(ECOStatusType::Count)] = {};
+
+    bool HasStatuses() const
+    {
+        for (const int32 Count : NumStatuses)
+        {
+            if (Count > 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+/**
+ * @class UCOStatusEffectSubsystem
+ * @brief World subsystem that times slows, roots and stuns and runs damage over time without active gameplay effects.
+ *
+ * Each status type keeps its entries in packed arrays (target slot and the type's payload). Slows, roots and
+ * stuns expire from UCOExpirySubsystem; DoTs are counted down in one straight loop per frame together with
+ * their periods.
+ *
+ * Slows, roots and stuns still apply their gameplay effect, so its modifiers, cues and granted tags behave as
+ * authored and replicate as usual. The effect is applied without a duration and the subsystem removes it when
+ * the status runs out, which takes the per-effect duration timers out of GAS. Roots and stuns add their State.CC
+ * tag to the effect's granted tags, so the held effect is the tag's only source.
+ *
+ * Damage over time is simulated natively when its effect is a periodic plain health drain (see
+ * UCODamageAccumulatorSubsystem::IsPlainHealthEffect). Each DoT deals its modifiers' damage once per period
+ * of the effect, like GAS would, and that damage is queued on UCODamageAccumulatorSubsystem with its source.
+ *
+ * Anything the subsystem cannot time, such as an effect without a finite duration, is applied as a regular
+ * gameplay effect instead.
+ */
+UCLASS()
+class CELESTIALODYSSEY_API UCOStatusEffectSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // UTickableWorldSubsystem interface
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /**
+     * @brief Adds the status described by a gameplay effect spec to every target.
+     *
+     * The spec is applied as a regular gameplay effect instead when the status would have no finite duration,
+     * when a DoT's effect is not a periodic plain health drain, or when a root or stun effect is instant and so
+     * cannot hold its tag.
+     *
+     * @param Type Kind of status.
+     * @param Spec Spec built by the applying ability.
+     * @param TargetsToAfflict Targets the status is added to.
+     * @param Duration Seconds the status lasts. Zero or less uses the spec's duration.
+     */
+    void ApplyStatus(ECOStatusType Type, const FGameplayEffectSpec& Spec, TConstArrayView<UAbilitySystemComponent*> TargetsToAfflict, float Duration = 0.0f);
+
+    /**
+     * @brief Adds a status through the world's status subsystem, or applies the spec as a regular gameplay effect
+     * when the world has none, so callers never lose the effect.
+     */
+    static void ApplyStatusOrEffect(const UWorld* World, ECOStatusType Type, const FGameplayEffectSpec& Spec, TConstArrayView<UAbilitySystemComponent*> TargetsToAfflict, float Duration = 0.0f);
+
+    /**
+     * @brief Adds a natively simulated damage over time to a target.
+     * @param Target Ability System Component of the afflicted target.
+     * @param DamageOverTime Damage per period, period and attribute, as read by ReadDamageOverTime.
+     * @param Duration Seconds the DoT lasts. Zero or less keeps it until RemoveStatus, which the caller must then call.
+     * @param Source Who the damage is credited to.
+     * @return Identifier that can be passed to RemoveStatus, or INDEX_NONE if Target is null or the period is not positive.
+     */
+    int32 AddDamageOverTime(UAbilitySystemComponent* Target, const FCODamageOverTime& DamageOverTime, float Duration, const FCODamageSource& Source);
+
+    /** @brief Removes a status early. Unknown or already expired identifiers are ignored. */
+    void RemoveStatus(ECOStatusType Type, int32 StatusId);
+
+    /**
+     * @brief Reads the damage of a DoT effect that can be simulated natively.
+     *
+     * The effect's additive health modifiers are dealt once per period. Non-periodic duration effects are
+     * temporary buffs or debuffs rather than damage, so they are not read.
+     *
+     * @return False if the effect is not periodic or is not a plain health drain.
+     */
+    static bool ReadDamageOverTime(const FGameplayEffectSpec& Spec, FCODamageOverTime& OutDamageOverTime);
+
+    /** @brief Tag kept on targets while a status of this type is active, if any. */
+    static FGameplayTag GetStatusTag(ECOStatusType Type);
+
+    /** @brief Returns the number of active statuses of a type. */
+    int32 GetNumStatuses(ECOStatusType Type) const { return Statuses[static_cast<int32>(Type)].Num(); }
+
+    /** @brief Returns the game-thread time spent in the last Tick, in seconds. */
+    double GetLastTickSeconds() const { return LastTickSeconds; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    static constexpr int32 NumStatusTypes = static_cast<int32>(ECOStatusType::Count);
+
+    FCOStatusList& GetList(ECOStatusType Type) { return Statuses[static_cast<int32>(Type)]; }
+
+    /** Applies a slow, root or stun effect whose duration was already cleared, and starts timing it */
+    int32 AddEffectStatus(ECOStatusType Type, UAbilitySystemComponent* Target, const FGameplayEffectSpec& UntimedSpec, float Duration);
+
+    int32 AddEntry(ECOStatusType Type, UAbilitySystemComponent* Target, float Duration);
+    void UpdateTargets();
+    void AccumulateDamage(float DeltaTime);
+    void ExpireStatus(ECOStatusType Type, int32 StatusId);
+    void RemoveExpired(ECOStatusType Type);
+    void RemoveStatusAt(ECOStatusType Type, int32 Index);
+    void FlushPendingDamage();
+    void FlushDamage(int32 Index, UCODamageAccumulatorSubsystem* DamageAccumulator);
+    void DealDamage(UAbilitySystemComponent* Target, float Damage, const FCODamageSource& Source, const FGameplayAttribute& Attribute, UCODamageAccumulatorSubsystem* DamageAccumulator) const;
+
+    int32 FindOrAddTarget(UAbilitySystemComponent* Target);
+    void ReleaseTarget(int32 Slot);
+
+    FCOStatusList Statuses[NumStatusTypes];
+    int32 NextStatusId = 0;
+
+    TArray<FCOStatusTarget> Targets;
+    TArray<int32> FreeTargetSlots;
+    TMap<TObjectKey<UAbilitySystemComponent>, int32> TargetSlotsByComponent;
+
+    double LastTickSeconds = 0.0;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Components/SceneComponent.h"
+#include "COTargetGridComponent.generated.h"
+
+/**
+ * @class UCOTargetGridComponent
+ * @brief Registers its owner with UCOTargetGridSubsystem so area abilities can find it.
+ *
+ * Any actor whose Ability System Component can be found through UAbilitySystemGlobals (IAbilitySystemInterface
+ * or an ASC component) opts in by adding this component; it does not have to be a character. The owner is
+ * registered on BeginPlay and removed on EndPlay. An owner whose ASC only becomes available later, such as a
+ * pawn using its player state's ASC, calls RefreshRegistration once it is.
+ *
+ * The component listens to its owner's root component and moves the grid entry as soon as the root moves.
+ */
+UCLASS(ClassGroup = (AbilitySystem), meta = (BlueprintSpawnableComponent))
+class CELESTIALODYSSEY_API UCOTargetGridComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UCOTargetGridComponent();
+
+    /** @brief Registers the owner with its current ASC, or removes it from the grid if it has none. */
+    UFUNCTION(BlueprintCallable, Category = "Targeting")
+    void RefreshRegistration();
+
+protected:
+    // UActorComponent interface
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+    void OnOwnerMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+    /** Root component whose moves are pushed to the grid */
+    TWeakObjectPtr<USceneComponent> TrackedRoot;
+};
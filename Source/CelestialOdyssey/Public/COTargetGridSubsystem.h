@@ -0,0 +1,148 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "COTargetGridSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+
+/**
+ * @struct FCOTargetGridItem
+ * @brief Compact per-cell record scanned by area queries.
+ *
+ * Positions are kept inline in the cell so a query only touches the cell's item array.
+ */
+struct FCOTargetGridItem
+{
+    /** Actor position projected onto the XZ gameplay plane (X, Z) */
+    FVector2D Position;
+
+    /** Collision radius of the actor, added to the query radius */
+    float Radius;
+
+    /** Index of the owning entry in the subsystem's entry array */
+    int32 EntryIndex;
+};
+
+/**
+ * @struct FCOTargetGridCell
+ * @brief Bucket of targets that currently overlap a single grid cell.
+ */
+struct FCOTargetGridCell
+{
+    TArray<FCOTargetGridItem> Items;
+};
+
+/**
+ * @struct FCOTargetGridEntry
+ * @brief Registration record for an actor that owns an Ability System Component.
+ */
+struct FCOTargetGridEntry
+{
+    TObjectKey<AActor> ActorKey;
+    TWeakObjectPtr<AActor> Actor;
+    TWeakObjectPtr<UAbilitySystemComponent> AbilitySystemComponent;
+
+    /** Cell the actor is currently bucketed in */
+    FIntPoint Cell;
+
+    /** Slot of this entry inside its cell's item array */
+    int32 SlotInCell;
+
+    /** True when moves are reported through UpdateTarget, so Tick does not poll the actor's location */
+    bool bPushesMoves;
+};
+
+/**
+ * @class UCOTargetGridSubsystem
+ * @brief World subsystem that keeps a 2D spatial hash of actors owning an Ability System Component.
+ *
+ * Actors are added by UCOTargetGridComponent, which every ACOBaseCharacter has and any other actor with an
+ * ASC can add. Gameplay is locked to the XZ plane (see ACOBaseCharacter), so targets are hashed on X and Z
+ * only. Entries are re-bucketed incrementally, and only when an actor crosses a cell boundary.
+ * A cell is removed when its last target leaves, so the map only holds occupied cells.
+ *
+ * Targets added by UCOTargetGridComponent push their position whenever their root component moves, so
+ * queries see where they are now. Targets registered directly are polled in Tick; until then a query sees
+ * their position from the last tick, up to a frame old.
+ * Area abilities query the grid with circle and segment tests that return ASC pointers directly,
+ * instead of running a physics sweep and a component search on every hit.
+ */
+UCLASS()
+class CELESTIALODYSSEY_API UCOTargetGridSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Size of a grid cell in world units */
+    static constexpr float CellSize = 512.0f;
+
+    // UTickableWorldSubsystem interface
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /**
+     * @brief Adds an actor to the grid.
+     * @param Actor The actor to track.
+     * @param AbilitySystemComponent The ASC returned to queries for this actor.
+     * @param bPushesMoves True if the caller reports every move through UpdateTarget; otherwise Tick polls the actor.
+     */
+    void RegisterTarget(AActor* Actor, UAbilitySystemComponent* AbilitySystemComponent, bool bPushesMoves = false);
+
+    /** @brief Removes an actor from the grid. */
+    void UnregisterTarget(AActor* Actor);
+
+    /** @brief Moves an actor's entry to the actor's current location. */
+    void UpdateTarget(const AActor* Actor);
+
+    /**
+     * @brief Finds every registered target whose collision circle overlaps the given circle.
+     * @param Center Query center in world space (Y is ignored).
+     * @param Radius Query radius.
+     * @param OutTargets Receives the ASCs of overlapping targets. Cleared first.
+     * @param IgnoredActor Optional actor excluded from the results (usually the instigator).
+     */
+    void QueryCircle(const FVector& Center, float Radius, TArray<UAbilitySystemComponent*>& OutTargets, const AActor* IgnoredActor = nullptr) const;
+
+    /**
+     * @brief Finds every registered target overlapping a swept circle, ordered from Start to End.
+     * @param Start Segment start in world space (Y is ignored).
+     * @param End Segment end in world space (Y is ignored).
+     * @param Radius Radius of the swept circle.
+     * @param OutTargets Receives the ASCs of overlapping targets, nearest to Start first. Cleared first.
+     * @param IgnoredActor Optional actor excluded from the results (usually the instigator).
+     */
+    void QuerySegment(const FVector& Start, const FVector& End, float Radius, TArray<UAbilitySystemComponent*>& OutTargets, const AActor* IgnoredActor = nullptr) const;
+
+    /**
+     * @brief Looks up the ASC registered for an actor without searching its components.
+     * @return The registered ASC, or nullptr if the actor is not tracked.
+     */
+    UAbilitySystemComponent* FindAbilitySystemComponent(const AActor* Actor) const;
+
+    /** @brief Returns the number of registered targets. */
+    int32 GetNumTargets() const { return Entries.Num(); }
+
+    /** @brief Returns the number of cells holding at least one target. */
+    int32 GetNumCells() const { return Cells.Num(); }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    static FVector2D ToPlane(const FVector& Location) { return FVector2D(Location.X, Location.Z); }
+    static FIntPoint ToCell(const FVector2D& PlanePosition);
+
+    void UpdateEntryLocation(int32 EntryIndex, const FVector& Location);
+    void AddToCell(int32 EntryIndex, const FIntPoint& Cell, const FVector2D& Position, float Radius);
+    void RemoveFromCell(int32 EntryIndex);
+    void RemoveEntryAt(int32 EntryIndex);
+
+    /** Largest collision radius seen, used to widen the cell range scanned by queries */
+    float MaxTargetRadius = 0.0f;
+
+    TArray<FCOTargetGridEntry> Entries;
+    TMap<FIntPoint, FCOTargetGridCell> Cells;
+    TMap<TObjectKey<AActor>, int32> ActorToEntry;
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+
+class UGameplayAbility;
+
+/**
+ * Insights trace channel for gameplay events in this module.
+ * Enable with -trace=default,CelestialOdyssey (or "Trace.Enable CelestialOdyssey" at runtime). The channel and every
+ * CO_TRACE_* call compile to nothing in Shipping.
+ */
+#define CO_TRACE_ENABLED (UE_TRACE_ENABLED && !UE_BUILD_SHIPPING)
+
+#if CO_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_EXTERN(CelestialOdysseyChannel, CELESTIALODYSSEY_API);
+
+struct CELESTIALODYSSEY_API FCOTrace
+{
+    /** Records that an ability was activated this frame */
+    static void OutputAbilityActivated(const UGameplayAbility* Ability);
+
+    /** Records how many targets an ability activation hit and how many gameplay effects it applied to them */
+    static void OutputAbilityHits(const UGameplayAbility* Ability, int32 NumTargets, int32 NumEffects);
+};
+
+#define CO_TRACE_ABILITY_ACTIVATED(Ability) FCOTrace::OutputAbilityActivated(Ability)
+#define CO_TRACE_ABILITY_HITS(Ability, NumTargets, NumEffects) FCOTrace::OutputAbilityHits(Ability, NumTargets, NumEffects)
+
+#else
+
+#define CO_TRACE_ABILITY_ACTIVATED(Ability)
+#define CO_TRACE_ABILITY_HITS(Ability, NumTargets, NumEffects)
+
+#endif
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "COVineSubsystem.generated.h"
+
+class UInstancedStaticMeshComponent;
+
+/**
+ * @enum ECOVineMode
+ * @brief How a vine's ends are held and what happens when it settles.
+ */
+enum class ECOVineMode : uint8
+{
+    /** Head follows the caster, tail holds a target that is reeled in */
+    Grab,
+
+    /** Head is pinned to a world point, tail holds the caster on a fixed rope length */
+    Swing,
+
+    /** Both ends are pinned; once the chain settles it becomes a walkable bridge */
+    Bridge,
+
+    /** Head is pinned, tail hangs free */
+    Hang,
+};
+
+/**
+ * @struct FCOVine
+ * @brief A vine's slice of the shared particle buffer and how its ends are attached.
+ */
+struct FCOVine
+{
+    int32 Id = INDEX_NONE;
+    ECOVineMode Mode = ECOVineMode::Hang;
+
+    /** First particle of this vine in the shared buffer; its particles are contiguous */
+    int32 FirstParticle = 0;
+    int32 NumParticles = 0;
+
+    /** Rest length of each segment */
+    float SegmentLength = 0.0f;
+
+    /** World Y of the gameplay plane the vine lives on */
+    float PlaneY = 0.0f;
+
+    /** Actor the head particle follows, if any */
+    TWeakObjectPtr<AActor> HeadActor;
+
+    /** Actor held by the tail particle, if any */
+    TWeakObjectPtr<AActor> TailActor;
+
+    /** Distance the tail actor is allowed from the head; shrinks while reeling in */
+    float RopeLength = 0.0f;
+
+    /** Rope length a grabbed target is reeled in to */
+    float MinRopeLength = 0.0f;
+
+    /** Consecutive steps in which no particle moved more than the settle tolerance */
+    int32 NumQuietSteps = 0;
+
+    /** Settled bridges stop simulating and own these collision instances instead */
+    bool bSettled = false;
+    TArray<int32> BridgeInstances;
+};
+
+/**
+ * @class UCOVineSubsystem
+ * @brief World subsystem that simulates every active vine as a Verlet particle chain.
+ *
+ * All particles of all vines live in one contiguous structure-of-arrays buffer (X, Z, previous X, previous Z,
+ * inverse mass), so integration is a single branch-free loop over plain float arrays that the compiler
+ * vectorizes. Distance constraints are then relaxed vine by vine and particles are pushed out of world
+ * geometry on the XZ gameplay plane.
+ *
+ * The solver runs at a fixed step with a capped number of steps and iterations per frame, so its cost
+ * depends only on the number of live particles. Swinging and grabbing hold the attached character with a
+ * rope-length constraint on its position and velocity rather than a physics handle. Bridges stop
+ * simulating once they settle and are replaced by a chain of collision segments that can be walked on.
+ */
+UCLASS()
+class CELESTIALODYSSEY_API UCOVineSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Most segments a single vine may have */
+    static constexpr int32 MaxSegmentsPerVine = 32;
+
+    /** Most particles across all vines; vines beyond this are refused */
+    static constexpr int32 MaxParticles = 128 * (MaxSegmentsPerVine + 1);
+
+    /** Solver step length in seconds */
+    static constexpr float StepSeconds = 1.0f / 60.0f;
+
+    /** Most solver steps per frame; time beyond this is dropped rather than caught up */
+    static constexpr int32 MaxStepsPerTick = 2;
+
+    /** Constraint relaxation passes per step */
+    static constexpr int32 NumIterations = 8;
+
+    /** Collision radius of a particle */
+    static constexpr float ParticleRadius = 8.0f;
+
+    // UTickableWorldSubsystem interface
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /**
+     * @brief Creates a vine between two points.
+     * @param Mode How the ends are held.
+     * @param Start Head position in world space.
+     * @param End Tail position in world space.
+     * @param NumSegments Number of segments, clamped to MaxSegmentsPerVine.
+     * @param Slack Rope length as a multiple of the distance between Start and End.
+     * @param HeadActor Actor the head follows (Grab), or null.
+     * @param TailActor Actor the tail holds (Grab target or Swing caster), or null.
+     * @param Lifetime Seconds before the vine is removed. Zero or less keeps it until RemoveVine.
+     * @return Identifier that can be passed to RemoveVine, or INDEX_NONE if the particle buffer is full.
+     */
+    int32 AddVine(ECOVineMode Mode, const FVector& Start, const FVector& End, int32 NumSegments, float Slack, AActor* HeadActor = nullptr, AActor* TailActor = nullptr, float Lifetime = 0.0f);
+
+    /** @brief Removes a vine and, for a settled bridge, its collision segments. */
+    void RemoveVine(int32 VineId);
+
+    /**
+     * @brief Copies a vine's particle positions in world space, head first.
+     * @return False if no vine has this id.
+     */
+    bool GetVinePoints(int32 VineId, TArray<FVector>& OutPoints) const;
+
+    /** @brief Returns the number of live vines. */
+    int32 GetNumVines() const { return Vines.Num(); }
+
+    /** @brief Returns the game-thread time spent in the last Tick, in seconds. */
+    double GetLastTickSeconds() const { return LastTickSeconds; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void Step();
+    void Integrate();
+    void PinEnds(FCOVine& Vine);
+    void SolveConstraints(const FCOVine& Vine);
+    void CollideWithWorld(const FCOVine& Vine);
+    void ConstrainTailActor(FCOVine& Vine);
+    bool UpdateSettled(FCOVine& Vine);
+    void BuildBridge(FCOVine& Vine);
+    void ReleaseBridge(FCOVine& Vine);
+
+    FVector ToWorld(const FCOVine& Vine, int32 Particle) const { return FVector(PosX[Particle], Vine.PlaneY, PosZ[Particle]); }
+
+    // Particle buffer shared by every vine
+    TArray<float> PosX;
+    TArray<float> PosZ;
+    TArray<float> PrevX;
+    TArray<float> PrevZ;
+    TArray<float> InvMass;
+
+    TArray<FCOVine> Vines;
+    int32 NextVineId = 0;
+
+    /** Unsimulated time carried over to the next frame */
+    float TimeAccumulator = 0.0f;
+
+    UPROPERTY(Transient)
+    UInstancedStaticMeshComponent* BridgeComponent = nullptr;
+
+    /** Bridge instances of removed vines, reused by later bridges */
+    TArray<int32> FreeBridgeInstances;
+
+    double LastTickSeconds = 0.0;
+};
@@ -4,6 +4,8 @@
 #include "Abilities/GameplayAbility.h"
 #include "CrystalGrowthAbility.generated.h"
 
+class UStaticMesh;
+
 UENUM(BlueprintType)
 enum class ECrystalStructureType : uint8
 {
@@ -36,7 +38,7 @@ protected:
 
     virtual bool CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, FGameplayTagContainer* OptionalRelevantTags) const override;
 
-    /** Spawns the selected crystal structure at the target location */
+    /** Grows the selected crystal structure at the target location; X of the rotation runs along the surface, Z along its normal */
     UFUNCTION(BlueprintCallable, Category = "Crystal Growth")
     void SpawnCrystalStructure(const FVector& Location, const FRotator& Rotation);
 
@@ -60,11 +62,15 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crystal Growth")
     ECrystalStructureType StructureType;
 
+    /** Mesh used for every crystal segment; the engine cube is used when unset */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Crystal Growth")
+    UStaticMesh* CrystalMesh;
+
     /** Cooldown gameplay effect */
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Effects")
     TSubclassOf<UGameplayEffect> CooldownEffectClass;
 
 private:
-    /** Timer handle for crystal duration */
-    FTimerHandle CrystalTimerHandle;
+    /** Traces from the cursor for the surface the structure grows on */
+    bool TraceTargetSurface(ACharacter* Character, FVector& OutLocation, FVector& OutNormal) const;
 };
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include "Abilities/GameplayAbility.h"
 #include "CrystalShatterAbility.generated.h"
 
+class UStaticMesh;
+
 /**
  * @class UCrystalShatterAbility
  * @brief Ability that shatters nearby crystals causing damage and area control.
@@ -35,7 +37,7 @@ protected:
     UFUNCTION(BlueprintCallable, Category = "Crystal Shatter")
     void CreateSlowField(const FVector& Location);
 
-    /** Launches crystal fragments */
+    /** Launches crystal fragments that ricochet off walls and damage the first enemy they hit */
     UFUNCTION(BlueprintCallable, Category = "Crystal Shatter")
     void LaunchFragments(const FVector& Origin);
 
@@ -55,6 +57,30 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crystal Shatter")
     float BaseDamage;
 
+    /** Number of fragments launched at level 3 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crystal Shatter|Fragments")
+    int32 NumFragments;
+
+    /** Launch speed of the fragments */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crystal Shatter|Fragments")
+    float FragmentSpeed;
+
+    /** Ricochets off world geometry before a fragment breaks */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crystal Shatter|Fragments")
+    int32 FragmentMaxBounces;
+
+    /** Seconds before a fragment that hit nothing breaks */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crystal Shatter|Fragments")
+    float FragmentLifetime;
+
+    /** Fraction of the shatter damage dealt by each fragment */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crystal Shatter|Fragments")
+    float FragmentDamageScale;
+
+    /** Mesh drawn for every fragment */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Crystal Shatter|Fragments")
+    UStaticMesh* FragmentMesh;
+
     /** Gameplay effect for the cooldown */
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Effects")
     TSubclassOf<UGameplayEffect> CooldownEffectClass;
@@ -70,8 +96,4 @@ protected:
     /** Gameplay effect for the slow effect */
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Effects")
     TSubclassOf<UGameplayEffect> SlowEffectClass;
-
-private:
-    /** Timer handle for the slow field */
-    FTimerHandle SlowFieldTimerHandle;
 };
\ No newline at end of file
@@ -39,8 +39,26 @@ protected:
     ) const override;
 
 private:
-    void RotateCharacter(ACharacter* Character, bool bIsGravityInverted);
-    void CheckForCeilingContact(ACharacter* Character);
+    /** Subscribes to the capsule hit and landed notifications for the duration of the inversion. */
+    void BindCeilingContactEvents(ACharacter* Character);
+
+    /** Removes the notifications bound by BindCeilingContactEvents, if any. */
+    void UnbindCeilingContactEvents();
+
+    /** Marks the ceiling as reached and stops listening for further contacts. */
+    void HandleCeilingContact();
+
+    /**
+     * Predicts how long the launch takes to reach the ceiling from one upward trace and the launch velocity.
+     * @return Seconds until contact, or a negative value when there is no ceiling within range.
+     */
+    float PredictCeilingContactTime(const ACharacter* Character, float LaunchSpeed) const;
+
+    UFUNCTION()
+    void OnCapsuleHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+
+    UFUNCTION()
+    void OnCharacterLanded(const FHitResult& Hit);
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gravity Shift", meta = (AllowPrivateAccess = "true"))
     float GravityShiftDuration;
@@ -51,9 +69,17 @@ private:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Cooldown", meta = (AllowPrivateAccess = "true"))
     TSubclassOf<class UGameplayEffect> CooldownEffect;
 
+    /** When true, the expected contact time is published to the player character as soon as the launch starts. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Gravity Shift", meta = (AllowPrivateAccess = "true"))
+    bool bPredictCeilingContact = true;
+
+    /** Upward distance searched for a ceiling when predicting the contact time. */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Gravity Shift", meta = (AllowPrivateAccess = "true", EditCondition = "bPredictCeilingContact"))
+    float CeilingPredictionDistance = 5000.0f;
+
     float DefaultCapsuleRadius;
     float DefaultCapsuleHeight;
 
-    /** Handle for the timer that periodically checks if the character has reached the ceiling. */
-    FTimerHandle CeilingCheckTimerHandle;
+    /** Character whose contact notifications are currently bound. */
+    TWeakObjectPtr<ACharacter> ContactCharacter;
 };
\ No newline at end of file
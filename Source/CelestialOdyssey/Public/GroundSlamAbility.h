@@ -36,6 +36,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ground Slam Effects")
 	TSubclassOf<UGameplayEffect> GroundSlamStunEffect;
 
+	/** Stun length used when the stun effect has no duration of its own */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ground Slam Effects")
+	float GroundSlamStunDuration;
+
 public:
 	/** Getter for Ground Slam level */
 	UFUNCTION(BlueprintCallable, Category="Ground Slam Progression")
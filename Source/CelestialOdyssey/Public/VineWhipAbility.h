@@ -51,9 +51,18 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Vine Whip Progression")
     float VineDuration;
 
+    /** Reach of the vine */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Vine Whip Progression")
+    float VineRange;
+
+    /** Number of simulated segments for grab and swing vines; bridges always use the maximum */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Vine Whip Progression")
+    int32 VineSegments;
+
     /** Type of vine action the player wants to perform */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vine Whip Action")
     EVineWhipAction VineWhipAction;
 	
+    /** Creates the vine for the selected action in the vine subsystem */
     void ExecuteVineAction(const FVector& StartLocation, const FVector& EndLocation, int32 Level);
 };
@@ -10,6 +10,6 @@ public class CelestialOdysseyEditorTarget : TargetRules
 		Type = TargetType.Editor;
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_4;
-		ExtraModuleNames.Add("CelestialOdyssey");
+		ExtraModuleNames.AddRange(new string[] { "CelestialOdyssey", "CelestialOdysseyEditor", "CelestialOdysseyTests" });
 	}
 }
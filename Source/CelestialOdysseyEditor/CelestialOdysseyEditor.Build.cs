@@ -0,0 +1,16 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class CelestialOdysseyEditor : ModuleRules
+{
+	public CelestialOdysseyEditor(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine" });
+
+		// The collision audit commandlet loads and saves assets through the editor
+		PrivateDependencyModuleNames.AddRange(new string[] { "CelestialOdyssey", "UnrealEd", "AssetRegistry" });
+	}
+}
@@ -0,0 +1,220 @@
+#include "COCollisionAuditCommandlet.h"
+#include "COCollisionChannels.h"
+#include "COEnemyCharacter.h"
+#include "COLog.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Actor.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Engine/World.h"
+#include "FileHelpers.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Misc/PackagePath.h"
+#include "UObject/UObjectHash.h"
+
+namespace
+{
+    /** Actor tag designers used to mark props Ground Slam destroys; the commandlet turns it into a collision profile */
+    const FName BreakableTag(TEXT("Environment.Breakable"));
+
+    /** Object types only specific actors may use. CrystalSurface is left out, as any static geometry may carry it */
+    bool IsReservedObjectType(ECollisionChannel ObjectType)
+    {
+        return ObjectType == CO_ObjectChannel_Enemy || ObjectType == CO_ObjectChannel_Breakable;
+    }
+}
+
+UCOCollisionAuditCommandlet::UCOCollisionAuditCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+/**
+ * @brief Loads every map, external actor and Blueprint package under the root path and audits its actors.
+ *
+ * Packages are processed one at a time and garbage is collected after each, so memory stays flat on
+ * large projects. Fixed packages are saved before they are unloaded.
+ *
+ * @return 0 if every issue was fixed or none was found, 1 otherwise.
+ */
+int32 UCOCollisionAuditCommandlet::Main(const FString& Params)
+{
+    TArray<FString> Tokens;
+    TArray<FString> Switches;
+    TMap<FString, FString> ParamValues;
+    ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+    bFix = Switches.Contains(TEXT("fix"));
+    const FString* RootPath = ParamValues.Find(TEXT("path"));
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetRegistry.SearchAllAssets(true);
+
+    FARFilter Filter;
+    Filter.PackagePaths.Add(RootPath ? FName(**RootPath) : FName(TEXT("/Game")));
+    Filter.bRecursivePaths = true;
+
+    TArray<FAssetData> Assets;
+    AssetRegistry.GetAssets(Filter, Assets);
+
+    // Levels saved with one file per actor keep their placed actors in packages of their own
+    const FString ExternalActorsFolder = FPackagePath::GetExternalActorsFolderName();
+
+    TSet<FName> PackageNames;
+    for (const FAssetData& Asset : Assets)
+    {
+        const bool bIsMap = Asset.AssetClassPath == UWorld::StaticClass()->GetClassPathName();
+        const bool bIsBlueprint = Asset.AssetClassPath == UBlueprint::StaticClass()->GetClassPathName();
+        const bool bIsExternalActor = Asset.PackagePath.ToString().Contains(ExternalActorsFolder);
+        if (bIsMap || bIsBlueprint || bIsExternalActor)
+        {
+            PackageNames.Add(Asset.PackageName);
+        }
+    }
+
+    UE_LOG(LogCelestialOdyssey, Display, TEXT("Auditing collision profiles in %d packages%s"), PackageNames.Num(), bFix ? TEXT(", fixing mismatches") : TEXT(""));
+
+    for (const FName PackageName : PackageNames)
+    {
+        UPackage* Package = LoadPackage(nullptr, *PackageName.ToString(), LOAD_None);
+        if (!Package)
+        {
+            UE_LOG(LogCelestialOdyssey, Warning, TEXT("Could not load %s"), *PackageName.ToString());
+            continue;
+        }
+
+        const int32 NumFixedBefore = NumFixed;
+
+        TArray<UObject*> Objects;
+        GetObjectsWithPackage(Package, Objects, true);
+        for (UObject* Object : Objects)
+        {
+            AActor* Actor = Cast<AActor>(Object);
+            if (Actor && !Actor->IsTemplate())
+            {
+                AuditActor(Actor, Actor->GetPathName());
+            }
+            else if (UBlueprint* Blueprint = Cast<UBlueprint>(Object))
+            {
+                AuditBlueprint(Blueprint);
+            }
+        }
+
+        if (NumFixed > NumFixedBefore)
+        {
+            UEditorLoadingAndSavingUtils::SavePackages({ Package }, true);
+        }
+
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+
+    UE_LOG(LogCelestialOdyssey, Display, TEXT("Collision audit finished: %d issues, %d fixed"), NumIssues, NumFixed);
+    return NumIssues > NumFixed ? 1 : 0;
+}
+
+FName UCOCollisionAuditCommandlet::GetExpectedProfile(const AActor* Actor)
+{
+    if (Actor->IsA<ACOEnemyCharacter>())
+    {
+        return COCollisionProfiles::Enemy;
+    }
+    if (Actor->ActorHasTag(BreakableTag))
+    {
+        return COCollisionProfiles::Breakable;
+    }
+    return NAME_None;
+}
+
+bool UCOCollisionAuditCommandlet::AuditActor(AActor* Actor, const FString& Context)
+{
+    const FName ExpectedProfile = GetExpectedProfile(Actor);
+    const bool bIsEnemy = ExpectedProfile == COCollisionProfiles::Enemy;
+
+    bool bChanged = false;
+    Actor->ForEachComponent<UPrimitiveComponent>(false, [&](UPrimitiveComponent* Component)
+    {
+        // Only an enemy's capsule is queried; its mesh keeps the character mesh profile
+        const bool bAudited = !bIsEnemy || Component == Actor->GetRootComponent();
+        bChanged |= AuditComponent(Component, bAudited ? ExpectedProfile : NAME_None, Context);
+    });
+    return bChanged;
+}
+
+void UCOCollisionAuditCommandlet::AuditBlueprint(UBlueprint* Blueprint)
+{
+    UClass* GeneratedClass = Blueprint->GeneratedClass;
+    if (!GeneratedClass || !GeneratedClass->IsChildOf<AActor>())
+    {
+        return;
+    }
+
+    // Native components, such as the enemy capsule, are checked on the class default object
+    AActor* DefaultActor = GeneratedClass->GetDefaultObject<AActor>();
+    const FString Context = Blueprint->GetPathName();
+    bool bChanged = AuditActor(DefaultActor, Context);
+
+    if (Blueprint->SimpleConstructionScript)
+    {
+        // Components added by the Blueprint itself are never the enemy capsule
+        const FName ExpectedProfile = GetExpectedProfile(DefaultActor);
+        const FName TemplateProfile = ExpectedProfile == COCollisionProfiles::Enemy ? NAME_None : ExpectedProfile;
+
+        for (USCS_Node* Node : Blueprint->SimpleConstructionScript->GetAllNodes())
+        {
+            if (UPrimitiveComponent* Template = Cast<UPrimitiveComponent>(Node->ComponentTemplate))
+            {
+                bChanged |= AuditComponent(Template, TemplateProfile, Context);
+            }
+        }
+    }
+
+    if (bChanged)
+    {
+        FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+    }
+}
+
+bool UCOCollisionAuditCommandlet::AuditComponent(UPrimitiveComponent* Component, FName ExpectedProfile, const FString& Context)
+{
+    if (Component->GetCollisionEnabled() == ECollisionEnabled::NoCollision)
+    {
+        return false;
+    }
+
+    const FName Profile = Component->GetCollisionProfileName();
+
+    if (ExpectedProfile.IsNone())
+    {
+        // Anything else that lands in the Enemy or Breakable object types only adds broadphase candidates the abilities discard
+        if (IsReservedObjectType(Component->GetCollisionObjectType()))
+        {
+            ++NumIssues;
+            UE_LOG(LogCelestialOdyssey, Warning, TEXT("%s: %s (profile %s) uses the Enemy or Breakable object type but is not an enemy capsule or breakable"),
+                *Context, *Component->GetName(), *Profile.ToString());
+        }
+        return false;
+    }
+
+    if (Profile == ExpectedProfile)
+    {
+        return false;
+    }
+
+    ++NumIssues;
+    UE_LOG(LogCelestialOdyssey, Warning, TEXT("%s: %s uses profile %s, expected %s"), *Context, *Component->GetName(), *Profile.ToString(), *ExpectedProfile.ToString());
+
+    if (!bFix)
+    {
+        return false;
+    }
+
+    Component->Modify();
+    Component->SetCollisionProfileName(ExpectedProfile);
+    ++NumFixed;
+    return true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "COCollisionAuditCommandlet.generated.h"
+
+class AActor;
+class UBlueprint;
+class UPrimitiveComponent;
+
+/**
+ * @class UCOCollisionAuditCommandlet
+ * @brief Checks that maps and Blueprints put actors on the collision profiles the abilities query.
+ *
+ * Expected profiles:
+ *   - Enemy characters use CO_Enemy on their capsule.
+ *   - Colliding components of actors tagged Environment.Breakable use CO_Breakable. Ground Slam still accepts
+ *     the tag on WorldDynamic props, but the Breakable object type keeps them out of the enemy query.
+ *
+ * Level geometry is not migrated: the EnemyTrace and CrystalSurfaceTrace channels block by default, so existing
+ * walls and floors keep stopping strikes and hosting crystals. CO_CrystalSurface is only set on grown structures,
+ * at runtime.
+ *
+ * Any other component that uses the Enemy or Breakable object type is reported as a stray broadphase candidate.
+ * Those are not fixed automatically, as only a designer knows what they were meant to be.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd CelestialOdyssey -run=COCollisionAudit [-path=/Game/Maps] [-fix]
+ *
+ * Without -fix the commandlet only reports and returns 1 if anything was found. With -fix it also moves
+ * mismatched components to their expected profile and saves the packages it changed.
+ */
+UCLASS()
+class CELESTIALODYSSEYEDITOR_API UCOCollisionAuditCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UCOCollisionAuditCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+    /** Profile every colliding component of the actor should use, or NAME_None if the actor is not audited */
+    static FName GetExpectedProfile(const AActor* Actor);
+
+    /** Checks the components of a placed actor, or of a Blueprint's class default object. Returns true if any was changed */
+    bool AuditActor(AActor* Actor, const FString& Context);
+
+    /** Checks the components a Blueprint adds in its construction script */
+    void AuditBlueprint(UBlueprint* Blueprint);
+
+    /** Reports and, with -fix, repairs one component. Returns true if it was changed */
+    bool AuditComponent(UPrimitiveComponent* Component, FName ExpectedProfile, const FString& Context);
+
+    bool bFix = false;
+    int32 NumIssues = 0;
+    int32 NumFixed = 0;
+};
@@ -0,0 +1,16 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class CelestialOdysseyTests : ModuleRules
+{
+	public CelestialOdysseyTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine" });
+
+		// Automation tests drive the game's world subsystems in a throwaway game world, or play test maps in PIE
+		PrivateDependencyModuleNames.AddRange(new string[] { "CelestialOdyssey", "GameplayAbilities", "GameplayTags", "GameplayTasks", "Json", "UnrealEd" });
+	}
+}
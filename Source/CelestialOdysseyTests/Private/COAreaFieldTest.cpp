@@ -0,0 +1,137 @@
+#include "COTestWorld.h"
+#include "COBenchmarkThresholds.h"
+#include "COAreaFieldSubsystem.h"
+#include "COTargetGridSubsystem.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    constexpr float FieldRadius = 200.0f;
+    constexpr float FieldSpacing = 800.0f;
+    constexpr int32 TargetsPerField = 4;
+
+    /** Builds a transient infinite slow, like the effect a slow field applies for as long as a target is inside */
+    UGameplayEffect* MakeSlowEffect()
+    {
+        UGameplayEffect* Effect = NewObject<UGameplayEffect>(GetTransientPackage());
+        Effect->DurationPolicy = EGameplayEffectDurationType::Infinite;
+
+        FGameplayModifierInfo& Modifier = Effect->Modifiers.AddDefaulted_GetRef();
+        Modifier.Attribute = UCOEnemyAttributeSet::GetMovementSpeedAttribute();
+        Modifier.ModifierOp = EGameplayModOp::Multiplicitive;
+        Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(0.5f));
+        return Effect;
+    }
+
+    /** Center of a field laid out on a square grid on the XZ plane */
+    FVector GetFieldCenter(int32 FieldIndex)
+    {
+        return FVector((FieldIndex % 64) * FieldSpacing, 0.0f, (FieldIndex / 64) * FieldSpacing);
+    }
+
+    /** Where a target is in a given frame: it sways across its field's edge, so it keeps entering and leaving */
+    FVector GetTargetLocation(int32 TargetIndex, int32 Frame)
+    {
+        const FVector Center = GetFieldCenter(TargetIndex / TargetsPerField);
+        const float Phase = 0.5f * PI * (TargetIndex % TargetsPerField) + 0.05f * Frame;
+        return Center + FVector(1.5f * FieldRadius * FMath::Sin(Phase), 0.0f, 0.0f);
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOAreaFieldScalingBenchmark, "CelestialOdyssey.Perf.AreaFieldScaling", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+/**
+ * @brief Runs 100 to 2000 slow fields with targets moving in and out of them, checks every target carries the slow
+ * exactly while it is inside, that the cost per field stays close to flat as fields are added, and writes the
+ * results to Saved/Benchmarks/AreaFieldScaling.csv.
+ */
+bool FCOAreaFieldScalingBenchmark::RunTest(const FString& Parameters)
+{
+    constexpr float FrameTime = 1.0f / 60.0f;
+    constexpr int32 NumFrames = 240;
+
+    const UGameplayEffect* SlowEffect = MakeSlowEffect();
+
+    FString Csv = TEXT("Fields,Targets,TickP50Us,TickP99Us,PerFieldP50Us\n");
+    TMap<int32, double> PerFieldMicroseconds;
+
+    for (const int32 NumFields : { 100, 500, 1000, 2000 })
+    {
+        FCOTestWorld TestWorld;
+        UCOAreaFieldSubsystem* AreaFields = TestWorld.GetSubsystem<UCOAreaFieldSubsystem>();
+        UCOTargetGridSubsystem* TargetGrid = TestWorld.GetSubsystem<UCOTargetGridSubsystem>();
+        if (!TestNotNull(TEXT("Area field subsystem"), AreaFields) || !TestNotNull(TEXT("Target grid"), TargetGrid))
+        {
+            return false;
+        }
+
+        UAbilitySystemComponent* Instigator = TestWorld.SpawnTarget(FVector(0.0f, 0.0f, -1.0e5f));
+        const FGameplayEffectSpecHandle SlowSpec(new FGameplayEffectSpec(SlowEffect, Instigator->MakeEffectContext(), 1.0f));
+
+        TArray<AActor*> Actors;
+        TArray<UAbilitySystemComponent*> Targets;
+        for (int32 TargetIndex = 0; TargetIndex < NumFields * TargetsPerField; ++TargetIndex)
+        {
+            AActor* Actor = nullptr;
+            UAbilitySystemComponent* Target = TestWorld.SpawnTarget(GetTargetLocation(TargetIndex, 0), &Actor);
+            TargetGrid->RegisterTarget(Actor, Target);
+            Actors.Add(Actor);
+            Targets.Add(Target);
+        }
+
+        for (int32 FieldIndex = 0; FieldIndex < NumFields; ++FieldIndex)
+        {
+            AreaFields->AddField(GetFieldCenter(FieldIndex), FieldRadius, 0.0f, SlowSpec);
+        }
+
+        TArray<double> TickMicroseconds;
+        for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+        {
+            for (int32 TargetIndex = 0; TargetIndex < Actors.Num(); ++TargetIndex)
+            {
+                Actors[TargetIndex]->SetActorLocation(GetTargetLocation(TargetIndex, Frame));
+            }
+            TargetGrid->Tick(FrameTime);
+
+            const double StartTime = FPlatformTime::Seconds();
+            AreaFields->Tick(FrameTime);
+            TickMicroseconds.Add((FPlatformTime::Seconds() - StartTime) * 1.0e6);
+        }
+
+        // Targets right on the edge may fall either way, so only the clear cases are checked
+        int32 NumWrong = 0;
+        for (int32 TargetIndex = 0; TargetIndex < Targets.Num(); ++TargetIndex)
+        {
+            const float Distance = FVector::Dist(Actors[TargetIndex]->GetActorLocation(), GetFieldCenter(TargetIndex / TargetsPerField));
+            if (FMath::Abs(Distance - FieldRadius) > 10.0f)
+            {
+                const int32 Expected = Distance < FieldRadius ? 1 : 0;
+                NumWrong += Targets[TargetIndex]->GetActiveGameplayEffects().GetNumGameplayEffects() != Expected;
+            }
+        }
+        TestEqual(FString::Printf(TEXT("%d fields: targets whose slow does not match where they stand"), NumFields), NumWrong, 0);
+
+        TickMicroseconds.Sort();
+        const double P50 = TickMicroseconds[NumFrames / 2];
+        const double P99 = TickMicroseconds[NumFrames * 99 / 100];
+        PerFieldMicroseconds.Add(NumFields, P50 / NumFields);
+
+        Csv += FString::Printf(TEXT("%d,%d,%.3f,%.3f,%.4f\n"), NumFields, Targets.Num(), P50, P99, P50 / NumFields);
+        AddInfo(FString::Printf(TEXT("%d fields, %d targets: tick P50 %.1f us, P99 %.1f us, %.3f us per field"), NumFields, Targets.Num(), P50, P99, P50 / NumFields));
+    }
+
+    // Near-linear: twenty times the fields may cost a little more per field for cache misses, not a multiple
+    TestTrue(TEXT("Cost per field stays close to flat from 100 to 2000 fields"), PerFieldMicroseconds[2000] < 3.0 * PerFieldMicroseconds[100]);
+    FCOBenchmarkThresholds::Check(*this, TEXT("AreaFieldTickUsPerField"), PerFieldMicroseconds[2000]);
+
+    const FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), TEXT("AreaFieldScaling.csv"));
+    TestTrue(TEXT("Wrote the CSV"), FFileHelper::SaveStringToFile(Csv, *OutputPath));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+/**
+ * @class FCOBenchmarkThresholds
+ * @brief Limits from Config/Benchmark/COBenchmarkThresholds.json, the file ACOBenchmarkGameMode checks its run against.
+ *
+ * Perf automation tests check their headline number against the same file, so one place holds every budget.
+ */
+class FCOBenchmarkThresholds
+{
+public:
+    /**
+     * @brief Fails the test if Value is over the limit stored under Field.
+     *
+     * A missing file or field is reported as a warning rather than a failure, so a new benchmark can land before
+     * its budget is agreed.
+     */
+    static void Check(FAutomationTestBase& Test, const TCHAR* Field, double Value)
+    {
+        double Limit = 0.0;
+        const TSharedPtr<FJsonObject> Thresholds = Load();
+        if (!Thresholds.IsValid() || !Thresholds->TryGetNumberField(Field, Limit))
+        {
+            Test.AddWarning(FString::Printf(TEXT("No %s threshold in Config/Benchmark/COBenchmarkThresholds.json"), Field));
+            return;
+        }
+
+        if (Value > Limit)
+        {
+            Test.AddError(FString::Printf(TEXT("%s %.3f is over its threshold of %.3f"), Field, Value, Limit));
+        }
+        else
+        {
+            Test.AddInfo(FString::Printf(TEXT("%s %.3f is within its threshold of %.3f"), Field, Value, Limit));
+        }
+    }
+
+private:
+    static TSharedPtr<FJsonObject> Load()
+    {
+        const FString Path = FPaths::Combine(FPaths::ProjectDir(), TEXT("Config/Benchmark/COBenchmarkThresholds.json"));
+
+        FString Text;
+        TSharedPtr<FJsonObject> Thresholds;
+        if (!FFileHelper::LoadFileToString(Text, *Path) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Thresholds))
+        {
+            return nullptr;
+        }
+        return Thresholds;
+    }
+};
@@ -0,0 +1,99 @@
+#include "COTestWorld.h"
+#include "COBenchmarkThresholds.h"
+#include "COCrystalStructureSubsystem.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOCrystalStructureChurnBenchmark, "CelestialOdyssey.Perf.CrystalStructureChurn", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+/**
+ * @brief Keeps 100 level 3 structures alive while replacing the oldest one every few frames, checks the instance
+ * pool stops growing once warm, and writes the subsystem tick cost to Saved/Benchmarks/CrystalStructures.csv.
+ */
+bool FCOCrystalStructureChurnBenchmark::RunTest(const FString& Parameters)
+{
+    constexpr float FrameTime = 1.0f / 60.0f;
+    constexpr int32 NumStructures = 100;
+    constexpr int32 NumFrames = 600;
+
+    const ECrystalStructureType Types[] = { ECrystalStructureType::Bridge, ECrystalStructureType::Wall, ECrystalStructureType::Platform,
+        ECrystalStructureType::Staircase, ECrystalStructureType::Encasement };
+
+    FCOTestWorld TestWorld;
+    UCOCrystalStructureSubsystem* Crystals = TestWorld.GetSubsystem<UCOCrystalStructureSubsystem>();
+    if (!TestNotNull(TEXT("Crystal structure subsystem"), Crystals))
+    {
+        return false;
+    }
+
+    int32 NumSpawned = 0;
+    auto SpawnNext = [&]()
+    {
+        const FVector Location((NumSpawned % 20) * 1500.0f, 0.0f, (NumSpawned / 20 % 10) * 1500.0f);
+        const int32 Id = Crystals->SpawnStructure(Types[NumSpawned % UE_ARRAY_COUNT(Types)], 3, Location, FRotator::ZeroRotator, 0.0f);
+        ++NumSpawned;
+        return Id;
+    };
+
+    TArray<int32> Live;
+    for (int32 Index = 0; Index < NumStructures; ++Index)
+    {
+        Live.Add(SpawnNext());
+    }
+
+    // Let the first structures grow fully before churning
+    for (int32 Frame = 0; Frame < 120; ++Frame)
+    {
+        TestWorld.Step(FrameTime);
+    }
+
+    TArray<double> TickMicroseconds;
+    TArray<double> ChurnMicroseconds;
+    int32 InstancesAfterWarmUp = 0;
+    for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        // Replace the oldest structure every few frames, about as often as the growth budget can keep up with
+        if (Frame % 4 == 0)
+        {
+            const double ChurnStart = FPlatformTime::Seconds();
+            Crystals->DespawnStructure(Live[0]);
+            Live.RemoveAt(0, 1, EAllowShrinking::No);
+            Live.Add(SpawnNext());
+            ChurnMicroseconds.Add((FPlatformTime::Seconds() - ChurnStart) * 1.0e6);
+        }
+
+        TestWorld.Step(FrameTime);
+        TickMicroseconds.Add(Crystals->GetLastTickSeconds() * 1.0e6);
+
+        if (Frame == NumFrames / 2)
+        {
+            InstancesAfterWarmUp = Crystals->GetNumInstances();
+        }
+    }
+
+    TestEqual(TEXT("Live structures"), Crystals->GetNumStructures(), NumStructures);
+    TestEqual(TEXT("Pool stops growing once warm"), Crystals->GetNumInstances(), InstancesAfterWarmUp);
+
+    TickMicroseconds.Sort();
+    ChurnMicroseconds.Sort();
+    const double TickP50 = TickMicroseconds[NumFrames / 2];
+    const double TickP99 = TickMicroseconds[NumFrames * 99 / 100];
+    const double ChurnP50 = ChurnMicroseconds[ChurnMicroseconds.Num() / 2];
+
+    FString Csv = TEXT("Structures,Instances,TickP50Us,TickP99Us,ReplaceP50Us\n");
+    Csv += FString::Printf(TEXT("%d,%d,%.3f,%.3f,%.3f\n"), NumStructures, Crystals->GetNumInstances(), TickP50, TickP99, ChurnP50);
+
+    FCOBenchmarkThresholds::Check(*this, TEXT("StructureTickP99Ms"), TickP99 / 1000.0);
+
+    const FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), TEXT("CrystalStructures.csv"));
+    TestTrue(TEXT("Wrote the CSV"), FFileHelper::SaveStringToFile(Csv, *OutputPath));
+
+    AddInfo(FString::Printf(TEXT("%d structures, %d instances: tick P50 %.2f us, P99 %.2f us, replacing a structure %.2f us"),
+        NumStructures, Crystals->GetNumInstances(), TickP50, TickP99, ChurnP50));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
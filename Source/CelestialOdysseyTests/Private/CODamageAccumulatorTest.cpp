@@ -0,0 +1,200 @@
+#include "COTestWorld.h"
+#include "CODamageAccumulatorSubsystem.h"
+#include "COPlayerAttributeSet.h"
+#include "CosmicStrikeAbility.h"
+#include "GroundSlamAbility.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    float GetHealth(const UAbilitySystemComponent* AbilitySystem)
+    {
+        return AbilitySystem->GetNumericAttribute(UCOEnemyAttributeSet::GetHealthAttribute());
+    }
+
+    /** Builds a transient instant effect with a single additive modifier */
+    UGameplayEffect* MakeInstantEffect(const FGameplayAttribute& Attribute, float Magnitude)
+    {
+        UGameplayEffect* Effect = NewObject<UGameplayEffect>(GetTransientPackage());
+        Effect->DurationPolicy = EGameplayEffectDurationType::Instant;
+
+        FGameplayModifierInfo& Modifier = Effect->Modifiers.AddDefaulted_GetRef();
+        Modifier.Attribute = Attribute;
+        Modifier.ModifierOp = EGameplayModOp::Additive;
+        Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(Magnitude));
+        return Effect;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCODamageAccumulatorCoalesceTest, "CelestialOdyssey.DamageAccumulator.Coalescing", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/**
+ * @brief Every hit of a frame lands as one Health write at the flush.
+ */
+bool FCODamageAccumulatorCoalesceTest::RunTest(const FString& Parameters)
+{
+    FCOTestWorld TestWorld;
+    UCODamageAccumulatorSubsystem* DamageAccumulator = TestWorld.GetSubsystem<UCODamageAccumulatorSubsystem>();
+    if (!TestNotNull(TEXT("Damage accumulator"), DamageAccumulator))
+    {
+        return false;
+    }
+
+    UAbilitySystemComponent* Target = TestWorld.SpawnTarget(FVector::ZeroVector);
+    const float StartHealth = GetHealth(Target);
+
+    for (int32 Hit = 0; Hit < 3; ++Hit)
+    {
+        DamageAccumulator->AddDamage(Target, 10.0f, FCODamageSource());
+    }
+    DamageAccumulator->AddDamage(Target, 0.0f, FCODamageSource());
+
+    TestEqual(TEXT("Health before the flush"), GetHealth(Target), StartHealth);
+
+    DamageAccumulator->Tick(0.0f);
+    TestEqual(TEXT("Health after the flush"), GetHealth(Target), StartHealth - 30.0f);
+    TestEqual(TEXT("Queued hits"), DamageAccumulator->GetNumDamageEvents(), int64(3));
+    TestEqual(TEXT("Health writes"), DamageAccumulator->GetNumHealthWrites(), int64(1));
+
+    DamageAccumulator->Tick(0.0f);
+    TestEqual(TEXT("An empty queue writes nothing"), DamageAccumulator->GetNumHealthWrites(), int64(1));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCODamageAccumulatorKillTest, "CelestialOdyssey.DamageAccumulator.KillCredit", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/**
+ * @brief A kill is credited to the source that dealt most of the frame's damage, and damage totals are kept per ability.
+ */
+bool FCODamageAccumulatorKillTest::RunTest(const FString& Parameters)
+{
+    FCOTestWorld TestWorld;
+    UCODamageAccumulatorSubsystem* DamageAccumulator = TestWorld.GetSubsystem<UCODamageAccumulatorSubsystem>();
+    if (!TestNotNull(TEXT("Damage accumulator"), DamageAccumulator))
+    {
+        return false;
+    }
+
+    UAbilitySystemComponent* Target = TestWorld.SpawnTarget(FVector::ZeroVector);
+    const float StartHealth = GetHealth(Target);
+
+    FCODamageSource Strike;
+    Strike.AbilityClass = UCosmicStrikeAbility::StaticClass();
+    FCODamageSource Slam;
+    Slam.AbilityClass = UGroundSlamAbility::StaticClass();
+
+    UAbilitySystemComponent* KilledTarget = nullptr;
+    FCODamageSource Killer;
+    DamageAccumulator->OnTargetKilled.AddLambda([&KilledTarget, &Killer](UAbilitySystemComponent* InTarget, const FCODamageSource& InKiller)
+    {
+        KilledTarget = InTarget;
+        Killer = InKiller;
+    });
+
+    DamageAccumulator->AddDamage(Target, 0.25f * StartHealth, Strike);
+    DamageAccumulator->AddDamage(Target, StartHealth, Slam);
+    DamageAccumulator->Tick(0.0f);
+
+    TestTrue(TEXT("Target is out of health"), GetHealth(Target) <= 0.0f);
+    TestEqual(TEXT("Killed target"), KilledTarget, Target);
+    TestTrue(TEXT("Kill goes to the largest share of damage"), Killer == Slam);
+
+    const FName SlamName = UGroundSlamAbility::StaticClass()->GetFName();
+    const FName StrikeName = UCosmicStrikeAbility::StaticClass()->GetFName();
+    TestEqual(TEXT("Kills credited to Ground Slam"), DamageAccumulator->GetKillsByAbility().FindRef(SlamName), 1);
+    TestEqual(TEXT("Damage dealt by Cosmic Strike"), DamageAccumulator->GetDamageByAbility().FindRef(StrikeName), double(0.25f * StartHealth));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCODamageAccumulatorSpecTest, "CelestialOdyssey.DamageAccumulator.SpecFilter", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/**
+ * @brief Only instant, additive Health damage is coalesced; anything else goes through GAS unchanged.
+ */
+bool FCODamageAccumulatorSpecTest::RunTest(const FString& Parameters)
+{
+    FCOTestWorld TestWorld;
+    UCODamageAccumulatorSubsystem* DamageAccumulator = TestWorld.GetSubsystem<UCODamageAccumulatorSubsystem>();
+    if (!TestNotNull(TEXT("Damage accumulator"), DamageAccumulator))
+    {
+        return false;
+    }
+
+    UAbilitySystemComponent* Target = TestWorld.SpawnTarget(FVector::ZeroVector);
+    const float StartHealth = GetHealth(Target);
+
+    const FGameplayEffectSpec DamageSpec(MakeInstantEffect(UCOEnemyAttributeSet::GetHealthAttribute(), -25.0f), Target->MakeEffectContext(), 1.0f);
+    const FGameplayEffectSpec HealSpec(MakeInstantEffect(UCOEnemyAttributeSet::GetHealthAttribute(), 5.0f), Target->MakeEffectContext(), 1.0f);
+    const FGameplayEffectSpec SpeedSpec(MakeInstantEffect(UCOEnemyAttributeSet::GetMovementSpeedAttribute(), -25.0f), Target->MakeEffectContext(), 1.0f);
+
+    float Damage = 0.0f;
+    FGameplayAttribute Attribute;
+    TestTrue(TEXT("Health damage is readable"), UCODamageAccumulatorSubsystem::ReadSpecDamage(DamageSpec, Damage, Attribute));
+    TestEqual(TEXT("Read damage"), Damage, 25.0f);
+    TestTrue(TEXT("Read attribute"), Attribute == UCOEnemyAttributeSet::GetHealthAttribute());
+    TestFalse(TEXT("Healing is not coalesced"), UCODamageAccumulatorSubsystem::ReadSpecDamage(HealSpec, Damage, Attribute));
+    TestFalse(TEXT("Other attributes are not coalesced"), UCODamageAccumulatorSubsystem::ReadSpecDamage(SpeedSpec, Damage, Attribute));
+
+    int32 NumAppliedBroadcasts = 0;
+    Target->OnGameplayEffectAppliedDelegateToSelf.AddLambda([&NumAppliedBroadcasts](UAbilitySystemComponent*, const FGameplayEffectSpec&, FActiveGameplayEffectHandle)
+    {
+        ++NumAppliedBroadcasts;
+    });
+
+    // The damage is queued, the heal lands right away
+    DamageAccumulator->ApplyDamageSpec(DamageSpec, Target);
+    DamageAccumulator->ApplyDamageSpec(DamageSpec, Target);
+    DamageAccumulator->ApplyDamageSpec(HealSpec, Target);
+    TestEqual(TEXT("Health before the flush"), GetHealth(Target), StartHealth + 5.0f);
+    TestEqual(TEXT("Only the heal was applied before the flush"), NumAppliedBroadcasts, 1);
+
+    DamageAccumulator->Tick(0.0f);
+    TestEqual(TEXT("Health after the flush"), GetHealth(Target), StartHealth - 45.0f);
+    TestEqual(TEXT("Both hits were applied as one effect"), NumAppliedBroadcasts, 2);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCODamageAccumulatorPlayerTest, "CelestialOdyssey.DamageAccumulator.PlayerLives", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/**
+ * @brief Hits on the player are taken from Lives and coalesced like enemy Health, without touching other attributes.
+ */
+bool FCODamageAccumulatorPlayerTest::RunTest(const FString& Parameters)
+{
+    FCOTestWorld TestWorld;
+    UCODamageAccumulatorSubsystem* DamageAccumulator = TestWorld.GetSubsystem<UCODamageAccumulatorSubsystem>();
+    if (!TestNotNull(TEXT("Damage accumulator"), DamageAccumulator))
+    {
+        return false;
+    }
+
+    UAbilitySystemComponent* Player = TestWorld.SpawnTarget(FVector::ZeroVector);
+    Player->InitStats(UCOPlayerAttributeSet::StaticClass(), nullptr);
+
+    const FGameplayAttribute LivesAttribute = UCOPlayerAttributeSet::GetLivesAttribute();
+    const float StartLives = Player->GetNumericAttribute(LivesAttribute);
+    const float StartHealth = GetHealth(Player);
+
+    const FGameplayEffectSpec HitSpec(MakeInstantEffect(LivesAttribute, -1.0f), Player->MakeEffectContext(), 1.0f);
+
+    float Damage = 0.0f;
+    FGameplayAttribute Attribute;
+    TestTrue(TEXT("Lives damage is readable"), UCODamageAccumulatorSubsystem::ReadSpecDamage(HitSpec, Damage, Attribute));
+    TestTrue(TEXT("Read attribute"), Attribute == LivesAttribute);
+
+    DamageAccumulator->ApplyDamageSpec(HitSpec, Player);
+    DamageAccumulator->ApplyDamageSpec(HitSpec, Player);
+    DamageAccumulator->AddDamage(Player, 10.0f, FCODamageSource());
+    TestEqual(TEXT("Lives before the flush"), Player->GetNumericAttribute(LivesAttribute), StartLives);
+
+    DamageAccumulator->Tick(0.0f);
+    TestEqual(TEXT("Lives after the flush"), Player->GetNumericAttribute(LivesAttribute), StartLives - 2.0f);
+    TestEqual(TEXT("Health keeps its own queue"), GetHealth(Player), StartHealth - 10.0f);
+    TestEqual(TEXT("One write per attribute"), DamageAccumulator->GetNumHealthWrites(), int64(2));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
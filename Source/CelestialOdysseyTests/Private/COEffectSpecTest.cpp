@@ -0,0 +1,134 @@
+#include "COTestWorld.h"
+#include "CODamageAccumulatorSubsystem.h"
+#include "COGameplayTags.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    /**
+     * @brief Allocator that forwards to the engine's and counts calls while installed as GMalloc.
+     *
+     * Other threads allocate through it too, so counts are an upper bound; compare them on an idle editor.
+     */
+    class FCOCountingMalloc final : public FMalloc
+    {
+    public:
+        explicit FCOCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+        virtual void* Malloc(SIZE_T Count, uint32 Alignment) override { NumAllocations.Increment(); return Inner->Malloc(Count, Alignment); }
+        virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override { NumAllocations.Increment(); return Inner->TryMalloc(Count, Alignment); }
+        virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override { NumAllocations.Increment(); return Inner->Realloc(Original, Count, Alignment); }
+        virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override { NumAllocations.Increment(); return Inner->TryRealloc(Original, Count, Alignment); }
+        virtual void Free(void* Original) override { Inner->Free(Original); }
+        virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+        virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+        virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+        virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+        virtual const TCHAR* GetDescriptiveName() override { return TEXT("COCountingMalloc"); }
+
+        int64 GetNumAllocations() const { return NumAllocations.GetValue(); }
+
+    private:
+        FMalloc* Inner;
+        FThreadSafeCounter64 NumAllocations;
+    };
+
+    /** Builds a transient instant Health effect whose damage is set by caller, like the abilities' damage effects */
+    UGameplayEffect* MakeDamageEffect()
+    {
+        UGameplayEffect* Effect = NewObject<UGameplayEffect>(GetTransientPackage());
+        Effect->DurationPolicy = EGameplayEffectDurationType::Instant;
+
+        FSetByCallerFloat SetByCaller;
+        SetByCaller.DataTag = COGameplayTags::Data_Damage;
+
+        FGameplayModifierInfo& Modifier = Effect->Modifiers.AddDefaulted_GetRef();
+        Modifier.Attribute = UCOEnemyAttributeSet::GetHealthAttribute();
+        Modifier.ModifierOp = EGameplayModOp::Additive;
+        Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(SetByCaller);
+        return Effect;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOEffectSpecSharingBenchmark, "CelestialOdyssey.Perf.SharedEffectSpec", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+/**
+ * @brief Applies a damage effect to 100 targets, once with a spec built per target as the abilities used to and
+ * once with one spec shared by the activation, and reports allocations and time per activation.
+ */
+bool FCOEffectSpecSharingBenchmark::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumTargets = 100;
+    constexpr int32 NumActivations = 200;
+
+    FCOTestWorld TestWorld;
+    UAbilitySystemComponent* Instigator = TestWorld.SpawnTarget(FVector::ZeroVector);
+
+    TArray<UAbilitySystemComponent*> Targets;
+    for (int32 Index = 0; Index < NumTargets; ++Index)
+    {
+        Targets.Add(TestWorld.SpawnTarget(FVector(Index * 50.0f, 0.0f, 0.0f)));
+    }
+
+    // Zero damage keeps every target alive for all activations
+    const UGameplayEffect* DamageEffect = MakeDamageEffect();
+
+    auto PerTargetActivation = [&]()
+    {
+        for (UAbilitySystemComponent* Target : Targets)
+        {
+            // What MakeOutgoingSpec builds: a heap spec and a fresh context for every target
+            const FGameplayEffectSpecHandle Spec(new FGameplayEffectSpec(DamageEffect, Instigator->MakeEffectContext(), 1.0f));
+            Spec.Data->SetSetByCallerMagnitude(COGameplayTags::Data_Damage, 0.0f);
+            UCODamageAccumulatorSubsystem::ApplySpecDirectly(*Spec.Data.Get(), MakeArrayView(&Target, 1));
+        }
+    };
+
+    auto SharedActivation = [&]()
+    {
+        FGameplayEffectSpec Spec(DamageEffect, Instigator->MakeEffectContext(), 1.0f);
+        Spec.SetSetByCallerMagnitude(COGameplayTags::Data_Damage, 0.0f);
+        UCODamageAccumulatorSubsystem::ApplySpecDirectly(Spec, Targets);
+    };
+
+    auto Measure = [&](TFunctionRef<void()> Activation, double& OutMicroseconds, int64& OutAllocations)
+    {
+        // Warm up so first-use allocations are not counted
+        Activation();
+
+        // Static so a thread that picked up the proxy just before it is uninstalled never sees it destroyed
+        FMalloc* EngineMalloc = GMalloc;
+        static FCOCountingMalloc CountingMalloc(EngineMalloc);
+        const int64 StartAllocations = CountingMalloc.GetNumAllocations();
+        GMalloc = &CountingMalloc;
+
+        const double StartTime = FPlatformTime::Seconds();
+        for (int32 Run = 0; Run < NumActivations; ++Run)
+        {
+            Activation();
+        }
+        OutMicroseconds = (FPlatformTime::Seconds() - StartTime) * 1.0e6 / NumActivations;
+
+        GMalloc = EngineMalloc;
+        OutAllocations = (CountingMalloc.GetNumAllocations() - StartAllocations) / NumActivations;
+    };
+
+    double PerTargetMicroseconds = 0.0;
+    double SharedMicroseconds = 0.0;
+    int64 PerTargetAllocations = 0;
+    int64 SharedAllocations = 0;
+    Measure(PerTargetActivation, PerTargetMicroseconds, PerTargetAllocations);
+    Measure(SharedActivation, SharedMicroseconds, SharedAllocations);
+
+    TestTrue(TEXT("Sharing the spec allocates less"), SharedAllocations < PerTargetAllocations);
+
+    AddInfo(FString::Printf(TEXT("%d targets, per activation: spec per target %.1f us, %lld allocations  |  shared spec %.1f us, %lld allocations"),
+        NumTargets, PerTargetMicroseconds, PerTargetAllocations, SharedMicroseconds, SharedAllocations));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,138 @@
+#include "COTestWorld.h"
+#include "COExpirySubsystem.h"
+#include "GameplayEffect.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "TimerManager.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOExpiryWheelTest, "CelestialOdyssey.StatusEffects.ExpiryWheel", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/**
+ * @brief Expiries fire once game time reaches them, including ones cascaded down from the upper wheel levels,
+ * and cancelled ones never fire.
+ */
+bool FCOExpiryWheelTest::RunTest(const FString& Parameters)
+{
+    FCOTestWorld TestWorld;
+    UCOExpirySubsystem* Expiries = TestWorld.GetSubsystem<UCOExpirySubsystem>();
+    if (!TestNotNull(TEXT("Expiry subsystem"), Expiries))
+    {
+        return false;
+    }
+
+    UAbilitySystemComponent* Target = TestWorld.SpawnTarget(FVector::ZeroVector);
+
+    UGameplayEffect* HeldEffect = NewObject<UGameplayEffect>(GetTransientPackage());
+    HeldEffect->DurationPolicy = EGameplayEffectDurationType::Infinite;
+    const FActiveGameplayEffectHandle EffectHandle = Target->ApplyGameplayEffectSpecToSelf(FGameplayEffectSpec(HeldEffect, Target->MakeEffectContext(), 1.0f));
+
+    bool bSoonFired = false;
+    bool bLateFired = false;
+    bool bCancelledFired = false;
+    Expiries->ScheduleCallback(0.5f, FSimpleDelegate::CreateLambda([&bSoonFired]() { bSoonFired = true; }));
+    Expiries->ScheduleCallback(30.0f, FSimpleDelegate::CreateLambda([&bLateFired]() { bLateFired = true; }));
+    FCOExpiryHandle Cancelled = Expiries->ScheduleCallback(0.5f, FSimpleDelegate::CreateLambda([&bCancelledFired]() { bCancelledFired = true; }));
+    Expiries->ScheduleEffectRemoval(Target, EffectHandle, 1.0f);
+
+    Expiries->Cancel(Cancelled);
+    TestFalse(TEXT("Cancelling invalidates the handle"), Cancelled.IsValid());
+
+    TestWorld.SetTimeSeconds(0.4);
+    Expiries->Tick(0.4f);
+    TestFalse(TEXT("Nothing fires early"), bSoonFired);
+
+    TestWorld.SetTimeSeconds(1.2);
+    Expiries->Tick(0.8f);
+    TestTrue(TEXT("Short expiry fired"), bSoonFired);
+    TestFalse(TEXT("Cancelled expiry never fires"), bCancelledFired);
+    TestEqual(TEXT("Effect removed on expiry"), Target->GetActiveGameplayEffects().GetNumGameplayEffects(), 0);
+    TestFalse(TEXT("Long expiry still waiting"), bLateFired);
+
+    TestWorld.SetTimeSeconds(31.0);
+    Expiries->Tick(29.8f);
+    TestTrue(TEXT("Long expiry fired"), bLateFired);
+    TestEqual(TEXT("Pending expiries"), Expiries->GetNumPending(), 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOExpiryWheelBenchmark, "CelestialOdyssey.Perf.ExpiryWheelVsTimerManager", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+/**
+ * @brief Schedules the same expiries on the wheel and on an FTimerManager, then runs both at 60 Hz until every
+ * expiry fired, and reports the insertion and expiry time of each.
+ */
+bool FCOExpiryWheelBenchmark::RunTest(const FString& Parameters)
+{
+    constexpr float FrameTime = 1.0f / 60.0f;
+    constexpr float MaxDelay = 5.0f;
+
+    for (const int32 NumExpiries : { 500, 5000, 50000 })
+    {
+        FRandomStream Random(NumExpiries);
+        TArray<float> Delays;
+        Delays.SetNumUninitialized(NumExpiries);
+        for (float& Delay : Delays)
+        {
+            Delay = Random.FRandRange(0.5f, MaxDelay);
+        }
+
+        // Expiry wheel
+        FCOTestWorld TestWorld;
+        UCOExpirySubsystem* Expiries = TestWorld.GetSubsystem<UCOExpirySubsystem>();
+        if (!TestNotNull(TEXT("Expiry subsystem"), Expiries))
+        {
+            return false;
+        }
+
+        int32 NumWheelFired = 0;
+        double StartTime = FPlatformTime::Seconds();
+        for (const float Delay : Delays)
+        {
+            Expiries->ScheduleCallback(Delay, FSimpleDelegate::CreateLambda([&NumWheelFired]() { ++NumWheelFired; }));
+        }
+        const double WheelInsertSeconds = FPlatformTime::Seconds() - StartTime;
+
+        StartTime = FPlatformTime::Seconds();
+        for (float Time = FrameTime; Time <= MaxDelay + FrameTime; Time += FrameTime)
+        {
+            TestWorld.SetTimeSeconds(Time);
+            Expiries->Tick(FrameTime);
+        }
+        const double WheelExpirySeconds = FPlatformTime::Seconds() - StartTime;
+
+        // Timer manager, one timer and lambda per expiry as the abilities used to register them
+        FTimerManager TimerManager;
+        int32 NumTimersFired = 0;
+        TArray<FTimerHandle> TimerHandles;
+        TimerHandles.SetNum(NumExpiries);
+
+        StartTime = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < NumExpiries; ++Index)
+        {
+            TimerManager.SetTimer(TimerHandles[Index], FTimerDelegate::CreateLambda([&NumTimersFired]() { ++NumTimersFired; }), Delays[Index], false);
+        }
+        const double TimerInsertSeconds = FPlatformTime::Seconds() - StartTime;
+
+        StartTime = FPlatformTime::Seconds();
+        for (float Time = FrameTime; Time <= MaxDelay + FrameTime; Time += FrameTime)
+        {
+            // FTimerManager only ticks once per engine frame
+            ++GFrameCounter;
+            TimerManager.Tick(FrameTime);
+        }
+        const double TimerExpirySeconds = FPlatformTime::Seconds() - StartTime;
+
+        TestEqual(FString::Printf(TEXT("Wheel expiries fired (%d)"), NumExpiries), NumWheelFired, NumExpiries);
+        TestEqual(FString::Printf(TEXT("Timers fired (%d)"), NumExpiries), NumTimersFired, NumExpiries);
+
+        AddInfo(FString::Printf(TEXT("%6d expiries  wheel insert %.3f ms  expire %.3f ms  |  timer manager insert %.3f ms  expire %.3f ms"),
+            NumExpiries, WheelInsertSeconds * 1000.0, WheelExpirySeconds * 1000.0, TimerInsertSeconds * 1000.0, TimerExpirySeconds * 1000.0));
+    }
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,62 @@
+#include "COTestWorld.h"
+#include "COGameplayTags.h"
+#include "GroundSlamAbility.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOGameplayTagsCanActivateBenchmark, "CelestialOdyssey.Perf.CanActivateAbilityTags", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+/**
+ * @brief Times the tag checks of UGroundSlamAbility::CanActivateAbility with tags requested by name, as every
+ * ability used to, against the native tags, and reports the cost of a whole CanActivateAbility call.
+ */
+bool FCOGameplayTagsCanActivateBenchmark::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumCalls = 100000;
+
+    FCOTestWorld TestWorld;
+    UAbilitySystemComponent* AbilitySystem = TestWorld.SpawnTarget(FVector::ZeroVector);
+    const FGameplayAbilitySpecHandle Handle = AbilitySystem->GiveAbility(FGameplayAbilitySpec(UGroundSlamAbility::StaticClass()));
+    const FGameplayAbilitySpec* Spec = AbilitySystem->FindAbilitySpecFromHandle(Handle);
+    if (!TestNotNull(TEXT("Ground Slam spec"), Spec))
+    {
+        return false;
+    }
+
+    int32 NumBlocked = 0;
+
+    double StartTime = FPlatformTime::Seconds();
+    for (int32 Call = 0; Call < NumCalls; ++Call)
+    {
+        NumBlocked += AbilitySystem->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("Cooldown.Ability.GroundSlam")))
+            || AbilitySystem->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("State.Casting")));
+    }
+    const double RequestedSeconds = FPlatformTime::Seconds() - StartTime;
+
+    StartTime = FPlatformTime::Seconds();
+    for (int32 Call = 0; Call < NumCalls; ++Call)
+    {
+        NumBlocked += AbilitySystem->HasMatchingGameplayTag(COGameplayTags::Cooldown_Ability_GroundSlam)
+            || AbilitySystem->HasMatchingGameplayTag(COGameplayTags::State_Casting);
+    }
+    const double NativeSeconds = FPlatformTime::Seconds() - StartTime;
+
+    int32 NumActivatable = 0;
+    StartTime = FPlatformTime::Seconds();
+    for (int32 Call = 0; Call < NumCalls; ++Call)
+    {
+        NumActivatable += Spec->Ability->CanActivateAbility(Handle, AbilitySystem->AbilityActorInfo.Get());
+    }
+    const double CanActivateSeconds = FPlatformTime::Seconds() - StartTime;
+
+    TestEqual(TEXT("Tag checks that blocked"), NumBlocked, 0);
+    TestEqual(TEXT("Calls that could activate"), NumActivatable, NumCalls);
+
+    AddInfo(FString::Printf(TEXT("Tag checks per call: requested by name %.1f ns, native %.1f ns"),
+        RequestedSeconds * 1.0e9 / NumCalls, NativeSeconds * 1.0e9 / NumCalls));
+    AddInfo(FString::Printf(TEXT("GroundSlam CanActivateAbility: %.1f ns per call"), CanActivateSeconds * 1.0e9 / NumCalls));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,87 @@
+#include "COTestWorld.h"
+#include "COCharacterMovementComponent.h"
+#include "COPlayerCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "GravityShiftAbility.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOGravityShiftCeilingLatencyTest, "CelestialOdyssey.GravityShift.CeilingContactLatency", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/**
+ * @brief Launches a player character at a ceiling with Gravity Shift and checks that the ceiling flag is set in
+ * the frame the capsule reaches it. The old 0.1 s polling trace could be up to six frames late at 60 Hz.
+ * Also reports how far the predicted contact time was off.
+ */
+bool FCOGravityShiftCeilingLatencyTest::RunTest(const FString& Parameters)
+{
+    constexpr float FrameTime = 1.0f / 60.0f;
+    constexpr float CeilingHeight = 600.0f;
+
+    // Contact means the capsule stopped within the movement component's floor distance of the ceiling
+    constexpr float ContactTolerance = 3.0f;
+
+    FCOTestWorld TestWorld;
+    TestWorld.SpawnBlock(FVector(0.0f, 0.0f, -50.0f), FVector(4000.0f, 400.0f, 100.0f));
+    TestWorld.SpawnBlock(FVector(0.0f, 0.0f, CeilingHeight + 50.0f), FVector(4000.0f, 400.0f, 100.0f));
+
+    ACOPlayerCharacter* Character = TestWorld.Get()->SpawnActor<ACOPlayerCharacter>(FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator);
+    if (!TestNotNull(TEXT("Player character"), Character))
+    {
+        return false;
+    }
+    Character->GetCharacterMovement()->bRunPhysicsWithNoController = true;
+
+    UAbilitySystemComponent* AbilitySystem = NewObject<UAbilitySystemComponent>(Character, TEXT("AbilitySystem"));
+    AbilitySystem->RegisterComponent();
+    AbilitySystem->InitAbilityActorInfo(Character, Character);
+    const FGameplayAbilitySpecHandle Handle = AbilitySystem->GiveAbility(FGameplayAbilitySpec(UGravityShiftAbility::StaticClass()));
+
+    // Let the character settle on the floor
+    for (int32 Frame = 0; Frame < 30; ++Frame)
+    {
+        TestWorld.Step(FrameTime);
+    }
+
+    if (!TestTrue(TEXT("Gravity Shift activated"), AbilitySystem->TryActivateAbility(Handle)))
+    {
+        return false;
+    }
+
+    const double LaunchTime = TestWorld.Get()->GetTimeSeconds();
+    const float PredictedTimeToContact = Character->GetTimeUntilCeilingContact();
+
+    int32 ContactFrame = INDEX_NONE;
+    int32 FlagFrame = INDEX_NONE;
+    double ContactTime = 0.0;
+    for (int32 Frame = 0; Frame < 180 && (ContactFrame == INDEX_NONE || FlagFrame == INDEX_NONE); ++Frame)
+    {
+        TestWorld.Step(FrameTime);
+
+        const float CapsuleTop = Character->GetActorLocation().Z + Character->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+        if (ContactFrame == INDEX_NONE && CeilingHeight - CapsuleTop <= ContactTolerance)
+        {
+            ContactFrame = Frame;
+            ContactTime = TestWorld.Get()->GetTimeSeconds() - LaunchTime;
+        }
+        if (FlagFrame == INDEX_NONE && Character->GetHasReachedCeiling())
+        {
+            FlagFrame = Frame;
+        }
+    }
+
+    if (!TestTrue(TEXT("Capsule reached the ceiling"), ContactFrame != INDEX_NONE) || !TestTrue(TEXT("Ceiling flag set"), FlagFrame != INDEX_NONE))
+    {
+        return false;
+    }
+
+    TestTrue(TEXT("Ceiling flag set no later than the contact frame"), FlagFrame <= ContactFrame);
+    TestTrue(TEXT("Contact was predicted"), PredictedTimeToContact >= 0.0f);
+
+    AddInfo(FString::Printf(TEXT("Contact after %.3f s (frame %d), flag at frame %d, predicted %.3f s"),
+        ContactTime, ContactFrame, FlagFrame, PredictedTimeToContact));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,73 @@
+#include "COTestWorld.h"
+#include "COLevelAbilitySet.h"
+#include "COPlayerState.h"
+#include "Engine/AssetManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOLevelAbilitySetMemoryTest, "CelestialOdyssey.Perf.LevelAbilitySetMemory", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+/**
+ * @brief Writes a memreport before and after walking the campaign's levels and checks that only the current and
+ * next level's ability sets stay loaded.
+ *
+ * The reports land in Saved/Profiling/MemReports as LevelAbilitySets_Before and LevelAbilitySets_After.
+ */
+bool FCOLevelAbilitySetMemoryTest::RunTest(const FString& Parameters)
+{
+    UAssetManager& AssetManager = UAssetManager::Get();
+
+    TArray<FPrimaryAssetId> SetIds;
+    AssetManager.GetPrimaryAssetIdList(UCOLevelAbilitySet::PrimaryAssetType, SetIds);
+    if (SetIds.IsEmpty())
+    {
+        AddWarning(TEXT("No level ability sets under /Game/GameplayData/AbilitySets; levels use the player state's inline mapping and there is nothing to measure"));
+        return true;
+    }
+
+    // Read each set's level without its ability bundle
+    TMap<ECOGameLevel, FPrimaryAssetId> LevelAbilitySets;
+    if (TSharedPtr<FStreamableHandle> Handle = AssetManager.LoadPrimaryAssets(SetIds))
+    {
+        Handle->WaitUntilComplete();
+    }
+    for (const FPrimaryAssetId& SetId : SetIds)
+    {
+        if (const UCOLevelAbilitySet* AbilitySet = AssetManager.GetPrimaryAssetObject<UCOLevelAbilitySet>(SetId))
+        {
+            LevelAbilitySets.Add(AbilitySet->Level, SetId);
+        }
+    }
+    AssetManager.UnloadPrimaryAssets(SetIds);
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+    FCOTestWorld TestWorld;
+    GEngine->Exec(TestWorld.Get(), TEXT("memreport -full -name=LevelAbilitySets_Before"));
+
+    ACOPlayerState* PlayerState = TestWorld.Get()->SpawnActor<ACOPlayerState>();
+    PlayerState->LevelAbilitySets = LevelAbilitySets;
+
+    for (ECOGameLevel Level = ECOGameLevel::EnchantedForestMoon; Level != ECOGameLevel::None; Level = GetNextGameLevel(Level))
+    {
+        PlayerState->SetCurrentLevel(Level);
+        if (TSharedPtr<FStreamableHandle> Handle = AssetManager.GetPrimaryAssetHandle(LevelAbilitySets.FindRef(Level)))
+        {
+            Handle->WaitUntilComplete();
+        }
+
+        const ECOGameLevel NextLevel = GetNextGameLevel(Level);
+        for (const TPair<ECOGameLevel, FPrimaryAssetId>& Pair : LevelAbilitySets)
+        {
+            const bool bShouldBeLoaded = Pair.Key == Level || Pair.Key == NextLevel;
+            TestEqual(FString::Printf(TEXT("Set for level %d loaded while in level %d"), static_cast<int32>(Pair.Key), static_cast<int32>(Level)),
+                AssetManager.GetPrimaryAssetHandle(Pair.Value).IsValid(), bShouldBeLoaded);
+        }
+    }
+
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    GEngine->Exec(TestWorld.Get(), TEXT("memreport -full -name=LevelAbilitySets_After"));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,130 @@
+#include "COTestWorld.h"
+#include "COMinionAbilitySystemComponent.h"
+#include "COMinionAttributeSubsystem.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/ArchiveCountMem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOMinionAttributeModifierTest, "CelestialOdyssey.MinionAttributes.Modifiers", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/**
+ * @brief Instant changes move the base value, modifiers only the current value, and each slot is independent.
+ */
+bool FCOMinionAttributeModifierTest::RunTest(const FString& Parameters)
+{
+    FCOTestWorld TestWorld;
+    UCOMinionAttributeSubsystem* MinionAttributes = TestWorld.GetSubsystem<UCOMinionAttributeSubsystem>();
+    if (!TestNotNull(TEXT("Minion attribute store"), MinionAttributes))
+    {
+        return false;
+    }
+
+    const int32 Minion = MinionAttributes->AllocateSlot(100.0f, 600.0f);
+    const int32 Other = MinionAttributes->AllocateSlot(50.0f, 400.0f);
+    TestEqual(TEXT("Minions"), MinionAttributes->GetNumMinions(), 2);
+
+    MinionAttributes->ApplyInstant(Minion, ECOMinionAttribute::Health, EGameplayModOp::Additive, -30.0f);
+    TestEqual(TEXT("Base health after damage"), MinionAttributes->GetBaseValue(Minion, ECOMinionAttribute::Health), 70.0f);
+    TestEqual(TEXT("Current health after damage"), MinionAttributes->GetCurrentValue(Minion, ECOMinionAttribute::Health), 70.0f);
+
+    const FActiveGameplayEffectHandle Slow = FActiveGameplayEffectHandle::GenerateNewHandle(nullptr);
+    const FActiveGameplayEffectHandle Haste = FActiveGameplayEffectHandle::GenerateNewHandle(nullptr);
+    MinionAttributes->AddModifier(Minion, Slow, ECOMinionAttribute::MovementSpeed, EGameplayModOp::Multiplicitive, 0.5f);
+    MinionAttributes->AddModifier(Minion, Haste, ECOMinionAttribute::MovementSpeed, EGameplayModOp::Additive, 100.0f);
+    TestEqual(TEXT("Speed with both modifiers"), MinionAttributes->GetCurrentValue(Minion, ECOMinionAttribute::MovementSpeed), 350.0f);
+    TestEqual(TEXT("Base speed is untouched"), MinionAttributes->GetBaseValue(Minion, ECOMinionAttribute::MovementSpeed), 600.0f);
+    TestEqual(TEXT("Other minion's speed"), MinionAttributes->GetCurrentValue(Other, ECOMinionAttribute::MovementSpeed), 400.0f);
+
+    MinionAttributes->RemoveModifiers(Minion, Slow);
+    TestEqual(TEXT("Speed after the slow ends"), MinionAttributes->GetCurrentValue(Minion, ECOMinionAttribute::MovementSpeed), 700.0f);
+
+    MinionAttributes->RemoveModifiers(Minion, Haste);
+    TestEqual(TEXT("Speed after every modifier ends"), MinionAttributes->GetCurrentValue(Minion, ECOMinionAttribute::MovementSpeed), 600.0f);
+
+    MinionAttributes->ApplyInstant(Minion, ECOMinionAttribute::Health, EGameplayModOp::Additive, -500.0f);
+    TestEqual(TEXT("Health does not go below zero"), MinionAttributes->GetCurrentValue(Minion, ECOMinionAttribute::Health), 0.0f);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOMinionAttributeSlotTest, "CelestialOdyssey.MinionAttributes.SlotReuse", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/**
+ * @brief A released slot is reused with fresh values and without the previous minion's modifiers.
+ */
+bool FCOMinionAttributeSlotTest::RunTest(const FString& Parameters)
+{
+    FCOTestWorld TestWorld;
+    UCOMinionAttributeSubsystem* MinionAttributes = TestWorld.GetSubsystem<UCOMinionAttributeSubsystem>();
+    if (!TestNotNull(TEXT("Minion attribute store"), MinionAttributes))
+    {
+        return false;
+    }
+
+    const int32 Slot = MinionAttributes->AllocateSlot(100.0f, 600.0f);
+    MinionAttributes->AddModifier(Slot, FActiveGameplayEffectHandle::GenerateNewHandle(nullptr), ECOMinionAttribute::MovementSpeed, EGameplayModOp::Override, 0.0f);
+    MinionAttributes->ApplyInstant(Slot, ECOMinionAttribute::Health, EGameplayModOp::Additive, -40.0f);
+
+    MinionAttributes->ReleaseSlot(Slot);
+    TestEqual(TEXT("Minions after release"), MinionAttributes->GetNumMinions(), 0);
+
+    const int32 ReusedSlot = MinionAttributes->AllocateSlot(80.0f, 500.0f);
+    TestEqual(TEXT("Released slot is reused"), ReusedSlot, Slot);
+    TestEqual(TEXT("Reused slot's health"), MinionAttributes->GetCurrentValue(ReusedSlot, ECOMinionAttribute::Health), 80.0f);
+
+    // Touching the attribute refolds the modifiers, which would expose any left behind by the old minion
+    MinionAttributes->ApplyInstant(ReusedSlot, ECOMinionAttribute::MovementSpeed, EGameplayModOp::Additive, 0.0f);
+    TestEqual(TEXT("Reused slot carries no old modifiers"), MinionAttributes->GetCurrentValue(ReusedSlot, ECOMinionAttribute::MovementSpeed), 500.0f);
+    return true;
+}
+
+namespace
+{
+    /** Fixed size plus heap memory an object reports through its serializer */
+    SIZE_T GetObjectBytes(UObject* Object)
+    {
+        return Object->GetClass()->GetStructureSize() + FArchiveCountMem(Object).GetMax();
+    }
+
+    /** Bytes an Ability System Component and the attribute sets it owns take */
+    SIZE_T GetAbilitySystemBytes(UAbilitySystemComponent* AbilitySystem)
+    {
+        SIZE_T Bytes = GetObjectBytes(AbilitySystem);
+        for (UAttributeSet* AttributeSet : AbilitySystem->GetSpawnedAttributes())
+        {
+            Bytes += GetObjectBytes(AttributeSet);
+        }
+        return Bytes;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOMinionMemoryBenchmark, "CelestialOdyssey.Perf.MinionMemory", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+/**
+ * @brief Reports what an enemy's ability system costs per enemy: a regular ASC with UCOEnemyAttributeSet against
+ * a minion ASC and its slot in the attribute store.
+ */
+bool FCOMinionMemoryBenchmark::RunTest(const FString& Parameters)
+{
+    FCOTestWorld TestWorld;
+
+    UAbilitySystemComponent* EnemyAbilitySystem = TestWorld.SpawnTarget(FVector::ZeroVector);
+
+    AActor* Minion = TestWorld.Get()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity);
+    UCOMinionAbilitySystemComponent* MinionAbilitySystem = NewObject<UCOMinionAbilitySystemComponent>(Minion, TEXT("AbilitySystem"));
+    MinionAbilitySystem->RegisterComponent();
+    MinionAbilitySystem->InitAbilityActorInfo(Minion, Minion);
+
+    const SIZE_T EnemyBytes = GetAbilitySystemBytes(EnemyAbilitySystem);
+    const SIZE_T MinionComponentBytes = GetAbilitySystemBytes(MinionAbilitySystem);
+    const SIZE_T MinionSlotBytes = 2 * static_cast<int32>(ECOMinionAttribute::Count) * sizeof(float);
+
+    TestTrue(TEXT("A minion costs less than a regular enemy"), MinionComponentBytes + MinionSlotBytes < EnemyBytes);
+    TestEqual(TEXT("Minion owns no attribute set"), MinionAbilitySystem->GetSpawnedAttributes().Num(), 0);
+
+    AddInfo(FString::Printf(TEXT("Per enemy: regular ASC and attribute set %llu bytes  |  minion ASC %llu bytes and store slot %llu bytes"),
+        (uint64)EnemyBytes, (uint64)MinionComponentBytes, (uint64)MinionSlotBytes));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
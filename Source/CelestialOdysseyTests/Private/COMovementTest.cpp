@@ -0,0 +1,256 @@
+#include "COCharacterMovementComponent.h"
+#include "COPlayerCharacter.h"
+#include "Editor.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerStart.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+#include "Tests/AutomationEditorCommon.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    /**
+     * @brief Drives a player character through an inverted-gravity sequence in the PIE world, one step per frame.
+     *
+     * The character settles at the player start, inverts gravity and falls onto the ceiling, walks along it,
+     * then jumps off it and lands on it again. Movement tick cost is recorded from the inversion on.
+     */
+    class FCOInvertedGravityScenario : public IAutomationLatentCommand
+    {
+    public:
+        explicit FCOInvertedGravityScenario(FAutomationTestBase* InTest) : Test(InTest) {}
+
+        virtual bool Update() override
+        {
+            UWorld* World = GEditor ? GEditor->PlayWorld : nullptr;
+            if (!World)
+            {
+                Test->AddError(TEXT("No PIE world"));
+                return true;
+            }
+
+            ++PhaseFrames;
+            switch (Phase)
+            {
+            case EPhase::Spawn:
+                return Spawn(World);
+            case EPhase::Settle:
+                return Settle();
+            case EPhase::Invert:
+                return Invert();
+            case EPhase::Walk:
+                return Walk();
+            case EPhase::Jump:
+                return Jump();
+            }
+            return true;
+        }
+
+    private:
+        enum class EPhase : uint8 { Spawn, Settle, Invert, Walk, Jump };
+
+        /** Frames a phase may take before the test gives up */
+        static constexpr int32 MaxPhaseFrames = 240;
+
+        void EnterPhase(EPhase NewPhase)
+        {
+            Phase = NewPhase;
+            PhaseFrames = 0;
+        }
+
+        bool Fail(const FString& Message)
+        {
+            Test->AddError(Message);
+            return Finish();
+        }
+
+        bool Finish()
+        {
+            int32 NumTicks = 0;
+            const double Seconds = UCOCharacterMovementComponent::ConsumeRecordedTickSeconds(NumTicks);
+            UCOCharacterMovementComponent::SetRecordTickCost(false);
+            if (NumTicks > 0)
+            {
+                Test->AddInfo(FString::Printf(TEXT("Movement tick with inverted gravity: %.2f us average over %d ticks"), Seconds * 1.0e6 / NumTicks, NumTicks));
+            }
+
+            if (ACOPlayerCharacter* Spawned = Character.Get())
+            {
+                Spawned->Destroy();
+            }
+            return true;
+        }
+
+        bool Spawn(UWorld* World)
+        {
+            FVector Start = FVector::ZeroVector;
+            for (TActorIterator<APlayerStart> It(World); It; ++It)
+            {
+                Start = It->GetActorLocation();
+                break;
+            }
+
+            // The scenario needs something to stand on upside down; add a slab if the level has no ceiling here
+            FHitResult CeilingHit;
+            if (!World->LineTraceSingleByObjectType(CeilingHit, Start, Start + FVector(0.0f, 0.0f, 5000.0f), FCollisionObjectQueryParams(ECC_WorldStatic)))
+            {
+                Test->AddWarning(TEXT("No ceiling above the player start in TestLevel_Movement; using a generated one"));
+
+                const FTransform SlabTransform(FQuat::Identity, Start + FVector(0.0f, 0.0f, 650.0f), FVector(40.0f, 4.0f, 1.0f));
+                AStaticMeshActor* Slab = World->SpawnActorDeferred<AStaticMeshActor>(AStaticMeshActor::StaticClass(), SlabTransform);
+                Slab->GetStaticMeshComponent()->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube")));
+                Slab->FinishSpawning(SlabTransform);
+            }
+
+            FActorSpawnParameters SpawnParams;
+            SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+            Character = World->SpawnActor<ACOPlayerCharacter>(Start, FRotator::ZeroRotator, SpawnParams);
+            if (!Character.IsValid())
+            {
+                return Fail(TEXT("Could not spawn the player character"));
+            }
+
+            Character->GetCharacterMovement()->bRunPhysicsWithNoController = true;
+            EnterPhase(EPhase::Settle);
+            return false;
+        }
+
+        bool Settle()
+        {
+            ACOPlayerCharacter* Player = Character.Get();
+            if (!Player)
+            {
+                return Fail(TEXT("Character destroyed while settling"));
+            }
+            if (!Player->GetCharacterMovement()->IsMovingOnGround())
+            {
+                return PhaseFrames > MaxPhaseFrames ? Fail(TEXT("Character never reached the floor")) : false;
+            }
+
+            MeshRelativeTransform = Player->GetMesh()->GetRelativeTransform();
+
+            UCOCharacterMovementComponent::SetRecordTickCost(true);
+            Player->GetCOCharacterMovement()->SetGravityInverted(true);
+            Player->LaunchCharacter(FVector(0.0f, 0.0f, 1500.0f), true, true);
+            EnterPhase(EPhase::Invert);
+            return false;
+        }
+
+        bool Invert()
+        {
+            ACOPlayerCharacter* Player = Character.Get();
+            if (!Player)
+            {
+                return Fail(TEXT("Character destroyed while inverted"));
+            }
+
+            UCOCharacterMovementComponent* Movement = Player->GetCOCharacterMovement();
+            if (!Movement->IsMovingOnGround())
+            {
+                return PhaseFrames > MaxPhaseFrames ? Fail(TEXT("Character never landed on the ceiling")) : false;
+            }
+
+            Test->TestTrue(TEXT("Gravity still inverted on the ceiling"), Movement->IsGravityInverted());
+            Test->TestTrue(TEXT("Floor found on the ceiling faces down"), Movement->CurrentFloor.HitResult.ImpactNormal.Z < -0.7f);
+            Test->TestTrue(TEXT("Mesh keeps its authored offset"), Player->GetMesh()->GetRelativeTransform().Equals(MeshRelativeTransform));
+
+            WalkStartX = Player->GetActorLocation().X;
+            EnterPhase(EPhase::Walk);
+            return false;
+        }
+
+        bool Walk()
+        {
+            ACOPlayerCharacter* Player = Character.Get();
+            if (!Player)
+            {
+                return Fail(TEXT("Character destroyed while walking"));
+            }
+
+            UCOCharacterMovementComponent* Movement = Player->GetCOCharacterMovement();
+            if (!Movement->IsMovingOnGround())
+            {
+                return Fail(TEXT("Character lost the ceiling while walking along it"));
+            }
+
+            if (PhaseFrames < 60)
+            {
+                Player->AddMovementInput(FVector(1.0f, 0.0f, 0.0f), 1.0f);
+                return false;
+            }
+
+            Test->TestTrue(TEXT("Character walked along the ceiling"), Player->GetActorLocation().X - WalkStartX > 50.0f);
+
+            CeilingZ = Player->GetActorLocation().Z;
+            Player->Jump();
+            EnterPhase(EPhase::Jump);
+            return false;
+        }
+
+        bool Jump()
+        {
+            ACOPlayerCharacter* Player = Character.Get();
+            if (!Player)
+            {
+                return Fail(TEXT("Character destroyed while jumping"));
+            }
+
+            UCOCharacterMovementComponent* Movement = Player->GetCOCharacterMovement();
+            LowestZ = FMath::Min(LowestZ, Player->GetActorLocation().Z);
+
+            if (Movement->IsFalling())
+            {
+                bLeftCeiling = true;
+                Player->StopJumping();
+                return PhaseFrames > MaxPhaseFrames ? Fail(TEXT("Character never landed back on the ceiling")) : false;
+            }
+
+            if (!bLeftCeiling)
+            {
+                return PhaseFrames > MaxPhaseFrames ? Fail(TEXT("Jump never left the ceiling")) : false;
+            }
+
+            Test->TestTrue(TEXT("Jump moved away from the ceiling"), CeilingZ - LowestZ > 10.0f);
+            Test->TestTrue(TEXT("Landed back on the ceiling"), Movement->IsMovingOnGround() && Movement->CurrentFloor.HitResult.ImpactNormal.Z < -0.7f);
+            return Finish();
+        }
+
+        FAutomationTestBase* Test;
+        TWeakObjectPtr<ACOPlayerCharacter> Character;
+        EPhase Phase = EPhase::Spawn;
+        int32 PhaseFrames = 0;
+
+        FTransform MeshRelativeTransform;
+        float WalkStartX = 0.0f;
+        float CeilingZ = 0.0f;
+        float LowestZ = TNumericLimits<float>::Max();
+        bool bLeftCeiling = false;
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOInvertedGravityMovementTest, "CelestialOdyssey.Movement.InvertedGravity", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/**
+ * @brief Plays TestLevel_Movement and checks that floor finding, walking and jumping work against the ceiling
+ * with inverted gravity and no mesh re-offsetting, reporting the movement tick cost.
+ */
+bool FCOInvertedGravityMovementTest::RunTest(const FString& Parameters)
+{
+    if (!AutomationOpenMap(TEXT("/Game/Maps/TestLevels/TestLevel_Movement")))
+    {
+        AddError(TEXT("Could not open TestLevel_Movement"));
+        return false;
+    }
+
+    ADD_LATENT_AUTOMATION_COMMAND(FStartPIECommand(false));
+    ADD_LATENT_AUTOMATION_COMMAND(FWaitLatentCommand(0.5f));
+    ADD_LATENT_AUTOMATION_COMMAND(FCOInvertedGravityScenario(this));
+    ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand());
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
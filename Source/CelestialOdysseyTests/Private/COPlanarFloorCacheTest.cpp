@@ -0,0 +1,195 @@
+#include "COTestWorld.h"
+#include "COBenchmarkThresholds.h"
+#include "COBaseCharacter.h"
+#include "COCharacterMovementComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    constexpr float FrameTime = 1.0f / 60.0f;
+    constexpr float ArenaWidth = 4000.0f;
+
+    /** What one run of walkers produced */
+    struct FCOWalkerRun
+    {
+        /** Every walker's location at the end of every frame */
+        TArray<FVector> Locations;
+
+        /** Average movement tick of each frame, in microseconds */
+        TArray<double> TickMicroseconds;
+
+        /** Walker-frames spent walking rather than falling */
+        int32 NumGroundedFrames = 0;
+    };
+
+    /**
+     * @brief Walks characters back and forth across platforms in a fresh world and records what they did.
+     * @param bUseCache Value of bUsePlanarFloorCache for every walker.
+     * @param bMovePlatform Whether the middle platform rises, falls and slides every frame like a mover.
+     * @param NumGaps Gaps narrower than a capsule splitting the floor, so walking crosses seams.
+     */
+    FCOWalkerRun RunWalkers(bool bUseCache, bool bMovePlatform, int32 NumWalkers, int32 NumGaps, int32 NumFrames)
+    {
+        FCOTestWorld TestWorld;
+
+        constexpr float GapWidth = 20.0f;
+        const int32 NumPlatforms = NumGaps + 1;
+        const float PlatformWidth = (ArenaWidth - NumGaps * GapWidth) / NumPlatforms;
+
+        AStaticMeshActor* MovingPlatform = nullptr;
+        for (int32 Index = 0; Index < NumPlatforms; ++Index)
+        {
+            const float CenterX = -0.5f * ArenaWidth + Index * (PlatformWidth + GapWidth) + 0.5f * PlatformWidth;
+            AStaticMeshActor* Platform = TestWorld.SpawnBlock(FVector(CenterX, 0.0f, -50.0f), FVector(PlatformWidth, 400.0f, 100.0f));
+            if (bMovePlatform && Index == NumPlatforms / 2)
+            {
+                Platform->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+                MovingPlatform = Platform;
+            }
+        }
+
+        TArray<ACOBaseCharacter*> Walkers;
+        TArray<float> Directions;
+        for (int32 Index = 0; Index < NumWalkers; ++Index)
+        {
+            const FVector Location(-0.5f * ArenaWidth + ArenaWidth * (Index + 0.5f) / NumWalkers, 0.0f, 100.0f);
+            ACOBaseCharacter* Walker = TestWorld.Get()->SpawnActor<ACOBaseCharacter>(Location, FRotator::ZeroRotator);
+            if (!Walker)
+            {
+                continue;
+            }
+
+            // Walkers share one lane, so let them pass through each other
+            Walker->GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+            Walker->GetCOCharacterMovement()->bRunPhysicsWithNoController = true;
+            Walker->GetCOCharacterMovement()->SetUsePlanarFloorCache(bUseCache);
+            Walkers.Add(Walker);
+            Directions.Add(Index % 2 == 0 ? 1.0f : -1.0f);
+        }
+
+        FCOWalkerRun Run;
+        const FVector PlatformStart = MovingPlatform ? MovingPlatform->GetActorLocation() : FVector::ZeroVector;
+
+        UCOCharacterMovementComponent::SetRecordTickCost(true);
+        for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+        {
+            if (MovingPlatform)
+            {
+                const float Time = Frame * FrameTime;
+                MovingPlatform->SetActorLocation(PlatformStart + FVector(30.0f * FMath::Sin(Time), 0.0f, 20.0f * FMath::Sin(2.0f * Time)));
+            }
+
+            for (int32 Index = 0; Index < Walkers.Num(); ++Index)
+            {
+                const float X = Walkers[Index]->GetActorLocation().X;
+                if (FMath::Abs(X) > 0.5f * ArenaWidth - 200.0f && FMath::Sign(X) == Directions[Index])
+                {
+                    Directions[Index] = -Directions[Index];
+                }
+                Walkers[Index]->AddMovementInput(FVector(1.0f, 0.0f, 0.0f), Directions[Index]);
+            }
+
+            TestWorld.Step(FrameTime);
+
+            int32 NumTicks = 0;
+            const double Seconds = UCOCharacterMovementComponent::ConsumeRecordedTickSeconds(NumTicks);
+            if (NumTicks > 0)
+            {
+                Run.TickMicroseconds.Add(Seconds * 1.0e6 / NumTicks);
+            }
+
+            for (ACOBaseCharacter* Walker : Walkers)
+            {
+                Run.Locations.Add(Walker->GetActorLocation());
+                Run.NumGroundedFrames += Walker->GetCOCharacterMovement()->IsMovingOnGround();
+            }
+        }
+        UCOCharacterMovementComponent::SetRecordTickCost(false);
+        return Run;
+    }
+
+    double Percentile(TArray<double> Values, double Fraction)
+    {
+        if (Values.IsEmpty())
+        {
+            return 0.0;
+        }
+        Values.Sort();
+        return Values[FMath::Clamp(FMath::FloorToInt32(Fraction * (Values.Num() - 1)), 0, Values.Num() - 1)];
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOPlanarFloorCacheMovingPlatformTest, "CelestialOdyssey.Movement.PlanarFloorCacheMovingPlatform", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/**
+ * @brief Walks characters across a platform that bobs and slides every frame, once with the planar floor cache
+ * and once without, and checks the cache never changes where they end up or whether they stay on the ground.
+ */
+bool FCOPlanarFloorCacheMovingPlatformTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumWalkers = 8;
+    constexpr int32 NumFrames = 600;
+
+    const FCOWalkerRun Swept = RunWalkers(false, true, NumWalkers, 2, NumFrames);
+    const FCOWalkerRun Cached = RunWalkers(true, true, NumWalkers, 2, NumFrames);
+
+    if (!TestEqual(TEXT("Both runs recorded every walker every frame"), Cached.Locations.Num(), Swept.Locations.Num()))
+    {
+        return false;
+    }
+
+    float MaxDeviation = 0.0f;
+    for (int32 Index = 0; Index < Swept.Locations.Num(); ++Index)
+    {
+        MaxDeviation = FMath::Max(MaxDeviation, (float)FVector::Dist(Swept.Locations[Index], Cached.Locations[Index]));
+    }
+
+    TestTrue(TEXT("Walkers follow the same path with the cache"), MaxDeviation < 0.1f);
+    TestEqual(TEXT("Walkers spend the same frames on the ground with the cache"), Cached.NumGroundedFrames, Swept.NumGroundedFrames);
+    AddInfo(FString::Printf(TEXT("Largest difference between swept and cached walkers: %.4f cm"), MaxDeviation));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOPlanarFloorCacheBenchmark, "CelestialOdyssey.Perf.PlanarFloorCache", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+/**
+ * @brief Times the movement tick of walkers crossing static platforms with and without the planar floor cache
+ * and writes the comparison to Saved/Benchmarks/PlanarFloorCache.csv.
+ */
+bool FCOPlanarFloorCacheBenchmark::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumFrames = 600;
+
+    FString Csv = TEXT("Walkers,ArenaGaps,PlanarFloorCache,MovementTickP50Us,MovementTickP99Us\n");
+    for (const int32 NumWalkers : { 10, 50 })
+    {
+        for (const int32 NumGaps : { 0, 8 })
+        {
+            double P50[2];
+            double P99[2];
+            for (int32 UseCache = 0; UseCache < 2; ++UseCache)
+            {
+                const FCOWalkerRun Run = RunWalkers(UseCache == 1, false, NumWalkers, NumGaps, NumFrames);
+                P50[UseCache] = Percentile(Run.TickMicroseconds, 0.50);
+                P99[UseCache] = Percentile(Run.TickMicroseconds, 0.99);
+                Csv += FString::Printf(TEXT("%d,%d,%d,%.3f,%.3f\n"), NumWalkers, NumGaps, UseCache, P50[UseCache], P99[UseCache]);
+            }
+
+            AddInfo(FString::Printf(TEXT("%d walkers, %d gaps: movement tick P50 %.2f -> %.2f us, P99 %.2f -> %.2f us with the cache"),
+                NumWalkers, NumGaps, P50[0], P50[1], P99[0], P99[1]));
+            FCOBenchmarkThresholds::Check(*this, TEXT("MovementTickP99Us"), P99[1]);
+        }
+    }
+
+    const FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), TEXT("PlanarFloorCache.csv"));
+    TestTrue(TEXT("Wrote the comparison CSV"), FFileHelper::SaveStringToFile(Csv, *OutputPath));
+    AddInfo(FString::Printf(TEXT("Comparison written to %s"), *OutputPath));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
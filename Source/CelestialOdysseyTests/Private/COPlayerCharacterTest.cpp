@@ -0,0 +1,103 @@
+#include "COTestWorld.h"
+#include "COPlayerCharacter.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOPlayerCharacterJumpFlagsTest, "CelestialOdyssey.PlayerCharacter.JumpFallFlags", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/**
+ * @brief Runs a scripted sequence of idle jump, moving jump, released jump and walking off a ledge, and checks the
+ * animation flags match what the old per-frame Tick produced, with the character's tick disabled.
+ */
+bool FCOPlayerCharacterJumpFlagsTest::RunTest(const FString& Parameters)
+{
+    constexpr float FrameTime = 1.0f / 60.0f;
+    constexpr int32 MaxFrames = 600;
+
+    // The floor ends at X = 1000, so walking right eventually falls off the ledge
+    FCOTestWorld TestWorld;
+    TestWorld.SpawnBlock(FVector(-1500.0f, 0.0f, -50.0f), FVector(5000.0f, 400.0f, 100.0f));
+    TestWorld.SpawnBlock(FVector(0.0f, 0.0f, -2050.0f), FVector(20000.0f, 400.0f, 100.0f));
+
+    ACOPlayerCharacter* Character = TestWorld.Get()->SpawnActor<ACOPlayerCharacter>(FVector(-3000.0f, 0.0f, 100.0f), FRotator::ZeroRotator);
+    if (!TestNotNull(TEXT("Player character"), Character))
+    {
+        return false;
+    }
+
+    UCharacterMovementComponent* Movement = Character->GetCharacterMovement();
+    Movement->bRunPhysicsWithNoController = true;
+
+    TestFalse(TEXT("Player character never ticks"), Character->PrimaryActorTick.bCanEverTick);
+
+    auto ExpectFlags = [this, Character](const TCHAR* Step, bool bFalling, bool bJumpingMoving, bool bJumpingIdle)
+    {
+        TestEqual(FString::Printf(TEXT("%s: falling"), Step), Character->GetIsFalling(), bFalling);
+        TestEqual(FString::Printf(TEXT("%s: jumping while moving"), Step), Character->GetIsJumpingMoving(), bJumpingMoving);
+        TestEqual(FString::Printf(TEXT("%s: jumping while idle"), Step), Character->GetIsJumpingIdle(), bJumpingIdle);
+    };
+
+    // Steps until Condition holds, optionally pushing right every frame
+    auto StepUntil = [&TestWorld, Character](TFunctionRef<bool()> Condition, bool bMoveRight)
+    {
+        for (int32 Frame = 0; Frame < MaxFrames && !Condition(); ++Frame)
+        {
+            if (bMoveRight)
+            {
+                Character->MoveRight(1.0f);
+            }
+            TestWorld.Step(FrameTime);
+        }
+        return Condition();
+    };
+
+    auto IsOnGround = [Movement]() { return Movement->IsMovingOnGround(); };
+    auto IsInAir = [Movement]() { return Movement->IsFalling(); };
+
+    if (!TestTrue(TEXT("Settled on the floor"), StepUntil(IsOnGround, false)))
+    {
+        return false;
+    }
+    TestWorld.Step(FrameTime);
+    ExpectFlags(TEXT("Standing"), false, false, false);
+
+    // Jump from a standstill
+    Character->StartJump();
+    TestWorld.Step(FrameTime);
+    TestTrue(TEXT("Idle jump left the ground"), IsInAir());
+    ExpectFlags(TEXT("Idle jump"), false, false, true);
+
+    Character->StopJump();
+    ExpectFlags(TEXT("Idle jump released"), true, false, false);
+    TestTrue(TEXT("Landed after the idle jump"), StepUntil(IsOnGround, false));
+    ExpectFlags(TEXT("Landed after the idle jump"), false, false, false);
+
+    // Jump while running; holding the button keeps the jump animation until landing
+    for (int32 Frame = 0; Frame < 20; ++Frame)
+    {
+        Character->MoveRight(1.0f);
+        TestWorld.Step(FrameTime);
+    }
+    Character->StartJump();
+    Character->MoveRight(1.0f);
+    TestWorld.Step(FrameTime);
+    TestTrue(TEXT("Moving jump left the ground"), IsInAir());
+    ExpectFlags(TEXT("Moving jump"), false, true, false);
+
+    TestTrue(TEXT("Landed after the moving jump"), StepUntil(IsOnGround, true));
+    ExpectFlags(TEXT("Landed after the moving jump"), false, false, false);
+    Character->StopJump();
+    ExpectFlags(TEXT("Jump released on the ground"), false, false, false);
+
+    // Walk off the ledge without jumping
+    TestTrue(TEXT("Walked off the ledge"), StepUntil(IsInAir, true));
+    ExpectFlags(TEXT("Falling off the ledge"), true, false, false);
+
+    TestTrue(TEXT("Landed after the fall"), StepUntil(IsOnGround, false));
+    ExpectFlags(TEXT("Landed after the fall"), false, false, false);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
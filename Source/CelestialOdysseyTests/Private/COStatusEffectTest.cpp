@@ -0,0 +1,191 @@
+#include "COTestWorld.h"
+#include "COExpirySubsystem.h"
+#include "COGameplayTags.h"
+#include "COStatusEffectSubsystem.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    /** Moves game time forward by Seconds in fixed steps, running the expiry wheel, the status subsystem and the damage accumulator */
+    void Advance(FCOTestWorld& TestWorld, float Seconds, float Step = 0.25f)
+    {
+        UCOExpirySubsystem* Expiries = TestWorld.GetSubsystem<UCOExpirySubsystem>();
+        UCOStatusEffectSubsystem* StatusEffects = TestWorld.GetSubsystem<UCOStatusEffectSubsystem>();
+        UCODamageAccumulatorSubsystem* DamageAccumulator = TestWorld.GetSubsystem<UCODamageAccumulatorSubsystem>();
+
+        for (float Elapsed = 0.0f; Elapsed < Seconds; Elapsed += Step)
+        {
+            TestWorld.SetTimeSeconds(TestWorld.Get()->GetTimeSeconds() + Step);
+            Expiries->Tick(Step);
+            StatusEffects->Tick(Step);
+            if (DamageAccumulator)
+            {
+                DamageAccumulator->Tick(Step);
+            }
+        }
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOStatusDamageOverTimeTest, "CelestialOdyssey.StatusEffects.DamageOverTimeExpiry", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/**
+ * @brief A DoT deals one period's damage on application and at the end of every period of its duration, then expires.
+ */
+bool FCOStatusDamageOverTimeTest::RunTest(const FString& Parameters)
+{
+    FCOTestWorld TestWorld;
+    UCOStatusEffectSubsystem* StatusEffects = TestWorld.GetSubsystem<UCOStatusEffectSubsystem>();
+    if (!TestNotNull(TEXT("Status subsystem"), StatusEffects))
+    {
+        return false;
+    }
+
+    UAbilitySystemComponent* Target = TestWorld.SpawnTarget(FVector::ZeroVector);
+    const FGameplayAttribute HealthAttribute = UCOEnemyAttributeSet::GetHealthAttribute();
+    const float StartHealth = Target->GetNumericAttribute(HealthAttribute);
+
+    FCODamageOverTime DamageOverTime;
+    DamageOverTime.DamagePerPeriod = 5.0f;
+    DamageOverTime.Period = 0.5f;
+    DamageOverTime.bDamageOnApplication = true;
+    DamageOverTime.Attribute = HealthAttribute;
+
+    StatusEffects->AddDamageOverTime(Target, DamageOverTime, 2.0f, FCODamageSource());
+    TestEqual(TEXT("Active DoTs"), StatusEffects->GetNumStatuses(ECOStatusType::DamageOverTime), 1);
+
+    Advance(TestWorld, 1.0f);
+    TestEqual(TEXT("Active DoTs halfway"), StatusEffects->GetNumStatuses(ECOStatusType::DamageOverTime), 1);
+
+    Advance(TestWorld, 2.0f);
+    TestEqual(TEXT("Active DoTs after the duration"), StatusEffects->GetNumStatuses(ECOStatusType::DamageOverTime), 0);
+    TestEqual(TEXT("Health after the DoT"), Target->GetNumericAttribute(HealthAttribute), StartHealth - 25.0f, 0.01f);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOStatusDamageOverTimePeriodTest, "CelestialOdyssey.StatusEffects.DamageOverTimePeriod", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/**
+ * @brief A DoT applied from a periodic effect deals its damage in whole periods at the effect's Period, as GAS would,
+ * rather than spreading it over the frames in between.
+ */
+bool FCOStatusDamageOverTimePeriodTest::RunTest(const FString& Parameters)
+{
+    FCOTestWorld TestWorld;
+    UCOStatusEffectSubsystem* StatusEffects = TestWorld.GetSubsystem<UCOStatusEffectSubsystem>();
+    if (!TestNotNull(TEXT("Status subsystem"), StatusEffects))
+    {
+        return false;
+    }
+
+    UAbilitySystemComponent* Target = TestWorld.SpawnTarget(FVector::ZeroVector);
+    const FGameplayAttribute HealthAttribute = UCOEnemyAttributeSet::GetHealthAttribute();
+    const float StartHealth = Target->GetNumericAttribute(HealthAttribute);
+
+    UGameplayEffect* BurnEffect = NewObject<UGameplayEffect>(GetTransientPackage());
+    BurnEffect->DurationPolicy = EGameplayEffectDurationType::HasDuration;
+    BurnEffect->DurationMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(3.0f));
+    BurnEffect->Period = FScalableFloat(1.0f);
+    BurnEffect->bExecutePeriodicEffectOnApplication = false;
+    FGameplayModifierInfo& Modifier = BurnEffect->Modifiers.AddDefaulted_GetRef();
+    Modifier.Attribute = HealthAttribute;
+    Modifier.ModifierOp = EGameplayModOp::Additive;
+    Modifier.ModifierMagnitude = FScalableFloat(-4.0f);
+
+    const FGameplayEffectSpec BurnSpec(BurnEffect, Target->MakeEffectContext(), 1.0f);
+    FCODamageOverTime DamageOverTime;
+    TestTrue(TEXT("Burn is read as native damage"), UCOStatusEffectSubsystem::ReadDamageOverTime(BurnSpec, DamageOverTime));
+    TestEqual(TEXT("Damage per period"), DamageOverTime.DamagePerPeriod, 4.0f);
+    TestEqual(TEXT("Period"), DamageOverTime.Period, 1.0f);
+
+    StatusEffects->ApplyStatus(ECOStatusType::DamageOverTime, BurnSpec, MakeArrayView(&Target, 1));
+
+    Advance(TestWorld, 0.85f, 0.1f);
+    TestEqual(TEXT("Health before the first period ends"), Target->GetNumericAttribute(HealthAttribute), StartHealth, 0.01f);
+
+    Advance(TestWorld, 0.2f, 0.1f);
+    TestEqual(TEXT("Health after the first period"), Target->GetNumericAttribute(HealthAttribute), StartHealth - 4.0f, 0.01f);
+
+    Advance(TestWorld, 2.0f, 0.1f);
+    TestEqual(TEXT("Health after the duration"), Target->GetNumericAttribute(HealthAttribute), StartHealth - 12.0f, 0.01f);
+    TestEqual(TEXT("Active DoTs after the duration"), StatusEffects->GetNumStatuses(ECOStatusType::DamageOverTime), 0);
+
+    // A non-periodic Health modifier is a temporary debuff, not damage
+    UGameplayEffect* DebuffEffect = DuplicateObject(BurnEffect, GetTransientPackage());
+    DebuffEffect->Period = FScalableFloat(0.0f);
+    TestFalse(TEXT("Non-periodic effects are not read as damage"), UCOStatusEffectSubsystem::ReadDamageOverTime(FGameplayEffectSpec(DebuffEffect, Target->MakeEffectContext(), 1.0f), DamageOverTime));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOStatusStaleTargetTest, "CelestialOdyssey.StatusEffects.StaleTarget", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/**
+ * @brief Statuses on a destroyed target are dropped on the very next tick.
+ */
+bool FCOStatusStaleTargetTest::RunTest(const FString& Parameters)
+{
+    FCOTestWorld TestWorld;
+    UCOStatusEffectSubsystem* StatusEffects = TestWorld.GetSubsystem<UCOStatusEffectSubsystem>();
+    if (!TestNotNull(TEXT("Status subsystem"), StatusEffects))
+    {
+        return false;
+    }
+
+    AActor* TargetActor = nullptr;
+    UAbilitySystemComponent* Target = TestWorld.SpawnTarget(FVector::ZeroVector, &TargetActor);
+
+    FCODamageOverTime DamageOverTime;
+    DamageOverTime.DamagePerPeriod = 1.0f;
+    DamageOverTime.Period = 1.0f;
+    DamageOverTime.Attribute = UCOEnemyAttributeSet::GetHealthAttribute();
+    StatusEffects->AddDamageOverTime(Target, DamageOverTime, 10.0f, FCODamageSource());
+
+    TargetActor->Destroy();
+    Target->DestroyComponent();
+
+    Advance(TestWorld, 0.01f, 0.01f);
+    TestEqual(TEXT("Active DoTs after the target is gone"), StatusEffects->GetNumStatuses(ECOStatusType::DamageOverTime), 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOStatusRootTest, "CelestialOdyssey.StatusEffects.RootExpiry", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/**
+ * @brief A root holds its effect and State.CC.Rooted for its duration and releases both when it runs out.
+ */
+bool FCOStatusRootTest::RunTest(const FString& Parameters)
+{
+    FCOTestWorld TestWorld;
+    UCOStatusEffectSubsystem* StatusEffects = TestWorld.GetSubsystem<UCOStatusEffectSubsystem>();
+    if (!TestNotNull(TEXT("Status subsystem"), StatusEffects))
+    {
+        return false;
+    }
+
+    UAbilitySystemComponent* Target = TestWorld.SpawnTarget(FVector::ZeroVector);
+
+    UGameplayEffect* RootEffect = NewObject<UGameplayEffect>(GetTransientPackage());
+    RootEffect->DurationPolicy = EGameplayEffectDurationType::HasDuration;
+    const FGameplayEffectSpec RootSpec(RootEffect, Target->MakeEffectContext(), 1.0f);
+
+    // Two overlapping roots keep the tag until the longer one runs out
+    StatusEffects->ApplyStatus(ECOStatusType::Root, RootSpec, MakeArrayView(&Target, 1), 1.0f);
+    StatusEffects->ApplyStatus(ECOStatusType::Root, RootSpec, MakeArrayView(&Target, 1), 2.0f);
+    TestEqual(TEXT("Active roots"), StatusEffects->GetNumStatuses(ECOStatusType::Root), 2);
+    TestTrue(TEXT("Rooted tag while rooted"), Target->HasMatchingGameplayTag(COGameplayTags::State_CC_Rooted));
+    TestEqual(TEXT("Root effects held"), Target->GetActiveGameplayEffects().GetNumGameplayEffects(), 2);
+
+    Advance(TestWorld, 1.5f);
+    TestEqual(TEXT("Active roots after the first expires"), StatusEffects->GetNumStatuses(ECOStatusType::Root), 1);
+    TestTrue(TEXT("Rooted tag while one root remains"), Target->HasMatchingGameplayTag(COGameplayTags::State_CC_Rooted));
+
+    Advance(TestWorld, 1.0f);
+    TestEqual(TEXT("Active roots after both expire"), StatusEffects->GetNumStatuses(ECOStatusType::Root), 0);
+    TestFalse(TEXT("Rooted tag after the roots expire"), Target->HasMatchingGameplayTag(COGameplayTags::State_CC_Rooted));
+    TestEqual(TEXT("Root effects after the roots expire"), Target->GetActiveGameplayEffects().GetNumGameplayEffects(), 0);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,247 @@
+#include "COTestWorld.h"
+#include "COBenchmarkThresholds.h"
+#include "COTargetGridComponent.h"
+#include "COTargetGridSubsystem.h"
+#include "Components/SphereComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/OverlapResult.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOTargetGridQueryTest, "CelestialOdyssey.TargetGrid.Queries", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/**
+ * @brief Circle and segment queries return the targets they overlap, on the XZ plane only.
+ */
+bool FCOTargetGridQueryTest::RunTest(const FString& Parameters)
+{
+    FCOTestWorld TestWorld;
+    UCOTargetGridSubsystem* TargetGrid = TestWorld.GetSubsystem<UCOTargetGridSubsystem>();
+    if (!TestNotNull(TEXT("Target grid"), TargetGrid))
+    {
+        return false;
+    }
+
+    AActor* Near = nullptr;
+    AActor* Far = nullptr;
+    AActor* Ignored = nullptr;
+    AActor* OffPlane = nullptr;
+    UAbilitySystemComponent* NearTarget = TestWorld.SpawnTarget(FVector(300.0f, 0.0f, 0.0f), &Near);
+    UAbilitySystemComponent* FarTarget = TestWorld.SpawnTarget(FVector(2000.0f, 0.0f, 0.0f), &Far);
+    UAbilitySystemComponent* IgnoredTarget = TestWorld.SpawnTarget(FVector(0.0f, 0.0f, 100.0f), &Ignored);
+    UAbilitySystemComponent* OffPlaneTarget = TestWorld.SpawnTarget(FVector(0.0f, 5000.0f, -200.0f), &OffPlane);
+
+    TargetGrid->RegisterTarget(Near, NearTarget);
+    TargetGrid->RegisterTarget(Far, FarTarget);
+    TargetGrid->RegisterTarget(Ignored, IgnoredTarget);
+    TargetGrid->RegisterTarget(OffPlane, OffPlaneTarget);
+    TestEqual(TEXT("Registered targets"), TargetGrid->GetNumTargets(), 4);
+
+    TArray<UAbilitySystemComponent*> Targets;
+    TargetGrid->QueryCircle(FVector::ZeroVector, 400.0f, Targets, Ignored);
+    TestEqual(TEXT("Targets in circle"), Targets.Num(), 2);
+    TestTrue(TEXT("Circle finds the near target"), Targets.Contains(NearTarget));
+    TestTrue(TEXT("Circle ignores Y"), Targets.Contains(OffPlaneTarget));
+    TestFalse(TEXT("Circle skips the ignored actor"), Targets.Contains(IgnoredTarget));
+    TestFalse(TEXT("Circle skips the far target"), Targets.Contains(FarTarget));
+
+    TargetGrid->QuerySegment(FVector(2500.0f, 0.0f, 0.0f), FVector(-100.0f, 0.0f, 0.0f), 50.0f, Targets);
+    if (TestEqual(TEXT("Targets on segment"), Targets.Num(), 2))
+    {
+        TestEqual(TEXT("Segment returns the target nearest its start first"), Targets[0], FarTarget);
+        TestEqual(TEXT("Segment returns the farthest target last"), Targets[1], NearTarget);
+    }
+
+    TestEqual(TEXT("Registered ASC lookup"), TargetGrid->FindAbilitySystemComponent(Near), NearTarget);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOTargetGridMovementTest, "CelestialOdyssey.TargetGrid.Movement", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/**
+ * @brief Targets that cross a cell are found at their new position, and emptied cells are dropped.
+ */
+bool FCOTargetGridMovementTest::RunTest(const FString& Parameters)
+{
+    FCOTestWorld TestWorld;
+    UCOTargetGridSubsystem* TargetGrid = TestWorld.GetSubsystem<UCOTargetGridSubsystem>();
+    if (!TestNotNull(TEXT("Target grid"), TargetGrid))
+    {
+        return false;
+    }
+
+    AActor* Actor = nullptr;
+    UAbilitySystemComponent* Target = TestWorld.SpawnTarget(FVector(100.0f, 0.0f, 100.0f), &Actor);
+    TargetGrid->RegisterTarget(Actor, Target);
+    TestEqual(TEXT("Occupied cells after registering"), TargetGrid->GetNumCells(), 1);
+
+    const FVector NewLocation(100.0f + 4.0f * UCOTargetGridSubsystem::CellSize, 0.0f, 100.0f);
+    Actor->SetActorLocation(NewLocation);
+    TargetGrid->Tick(0.0f);
+
+    TArray<UAbilitySystemComponent*> Targets;
+    TargetGrid->QueryCircle(FVector(100.0f, 0.0f, 100.0f), 50.0f, Targets);
+    TestEqual(TEXT("Targets left at the old position"), Targets.Num(), 0);
+
+    TargetGrid->QueryCircle(NewLocation, 50.0f, Targets);
+    TestEqual(TEXT("Targets at the new position"), Targets.Num(), 1);
+    TestEqual(TEXT("Occupied cells after moving"), TargetGrid->GetNumCells(), 1);
+
+    TargetGrid->UnregisterTarget(Actor);
+    TestEqual(TEXT("Registered targets after unregistering"), TargetGrid->GetNumTargets(), 0);
+    TestEqual(TEXT("Occupied cells after unregistering"), TargetGrid->GetNumCells(), 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOTargetGridComponentTest, "CelestialOdyssey.TargetGrid.Component", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+/**
+ * @brief UCOTargetGridComponent registers its owner on BeginPlay, moves its entry in the same frame the owner
+ * moves, and removes it on EndPlay.
+ */
+bool FCOTargetGridComponentTest::RunTest(const FString& Parameters)
+{
+    FCOTestWorld TestWorld;
+    UCOTargetGridSubsystem* TargetGrid = TestWorld.GetSubsystem<UCOTargetGridSubsystem>();
+    if (!TestNotNull(TEXT("Target grid"), TargetGrid))
+    {
+        return false;
+    }
+
+    AActor* Actor = nullptr;
+    UAbilitySystemComponent* Target = TestWorld.SpawnTarget(FVector::ZeroVector, &Actor);
+
+    UCOTargetGridComponent* GridComponent = NewObject<UCOTargetGridComponent>(Actor, TEXT("TargetGrid"));
+    GridComponent->RegisterComponent();
+    TestEqual(TEXT("Component registers its owner"), TargetGrid->FindAbilitySystemComponent(Actor), Target);
+
+    // No grid tick between the move and the query
+    const FVector NewLocation(4.0f * UCOTargetGridSubsystem::CellSize, 0.0f, 0.0f);
+    Actor->SetActorLocation(NewLocation);
+
+    TArray<UAbilitySystemComponent*> Targets;
+    TargetGrid->QueryCircle(NewLocation, 50.0f, Targets);
+    TestEqual(TEXT("Owner is found where it moved without waiting for a tick"), Targets.Num(), 1);
+    TargetGrid->QueryCircle(FVector::ZeroVector, 50.0f, Targets);
+    TestEqual(TEXT("Owner is gone from where it was"), Targets.Num(), 0);
+
+    Actor->Destroy();
+    TestEqual(TEXT("Destroying the owner unregisters it"), TargetGrid->GetNumTargets(), 0);
+    return true;
+}
+
+namespace
+{
+    /** Spawns an actor with a pawn collision sphere and an ASC, so both the grid and physics queries can find it */
+    UAbilitySystemComponent* SpawnCollidingTarget(const FCOTestWorld& TestWorld, const FVector& Location, AActor*& OutActor)
+    {
+        AActor* Actor = TestWorld.Get()->SpawnActor<AActor>(AActor::StaticClass(), FTransform(Location));
+
+        USphereComponent* Sphere = NewObject<USphereComponent>(Actor, TEXT("Collision"));
+        Sphere->InitSphereRadius(40.0f);
+        Sphere->SetCollisionProfileName(UCollisionProfile::Pawn_ProfileName);
+        Actor->SetRootComponent(Sphere);
+        Sphere->RegisterComponent();
+        Actor->SetActorLocation(Location);
+
+        UAbilitySystemComponent* AbilitySystem = NewObject<UAbilitySystemComponent>(Actor, TEXT("AbilitySystem"));
+        AbilitySystem->RegisterComponent();
+        AbilitySystem->InitAbilityActorInfo(Actor, Actor);
+
+        OutActor = Actor;
+        return AbilitySystem;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCOTargetGridBenchmark, "CelestialOdyssey.Perf.TargetGridVsPhysics", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+/**
+ * @brief Times a circle query on the grid against the physics overlap and component search the abilities used,
+ * with 50, 500 and 5000 targets, and writes the comparison to Saved/Benchmarks/TargetGrid.csv.
+ */
+bool FCOTargetGridBenchmark::RunTest(const FString& Parameters)
+{
+    constexpr float ArenaSize = 20000.0f;
+    constexpr float QueryRadius = 500.0f;
+    constexpr int32 NumQueries = 1000;
+
+    FString Csv = TEXT("Targets,GridQueryUs,PhysicsQueryUs,AverageHits\n");
+    for (const int32 NumTargets : { 50, 500, 5000 })
+    {
+        FCOTestWorld TestWorld;
+        UCOTargetGridSubsystem* TargetGrid = TestWorld.GetSubsystem<UCOTargetGridSubsystem>();
+        if (!TestNotNull(TEXT("Target grid"), TargetGrid))
+        {
+            return false;
+        }
+
+        FRandomStream Random(NumTargets);
+        for (int32 Index = 0; Index < NumTargets; ++Index)
+        {
+            AActor* Actor = nullptr;
+            const FVector Location(Random.FRandRange(0.0f, ArenaSize), 0.0f, Random.FRandRange(0.0f, ArenaSize));
+            UAbilitySystemComponent* Target = SpawnCollidingTarget(TestWorld, Location, Actor);
+            TargetGrid->RegisterTarget(Actor, Target);
+        }
+
+        // Let the physics scene pick up the new bodies
+        TestWorld.Step(1.0f / 60.0f);
+
+        TArray<FVector> Centers;
+        for (int32 Index = 0; Index < NumQueries; ++Index)
+        {
+            Centers.Add(FVector(Random.FRandRange(0.0f, ArenaSize), 0.0f, Random.FRandRange(0.0f, ArenaSize)));
+        }
+
+        TArray<UAbilitySystemComponent*> Targets;
+        int64 GridHits = 0;
+        double StartTime = FPlatformTime::Seconds();
+        for (const FVector& Center : Centers)
+        {
+            TargetGrid->QueryCircle(Center, QueryRadius, Targets);
+            GridHits += Targets.Num();
+        }
+        const double GridMicroseconds = (FPlatformTime::Seconds() - StartTime) * 1.0e6 / NumQueries;
+
+        // What the abilities did before the grid: overlap pawns, then search each hit actor for its ASC
+        TArray<FOverlapResult> Overlaps;
+        int64 PhysicsHits = 0;
+        StartTime = FPlatformTime::Seconds();
+        for (const FVector& Center : Centers)
+        {
+            Overlaps.Reset();
+            Targets.Reset();
+            TestWorld.Get()->OverlapMultiByObjectType(Overlaps, Center, FQuat::Identity, FCollisionObjectQueryParams(ECC_Pawn), FCollisionShape::MakeSphere(QueryRadius));
+            for (const FOverlapResult& Overlap : Overlaps)
+            {
+                if (UAbilitySystemComponent* Target = Overlap.GetActor() ? Overlap.GetActor()->FindComponentByClass<UAbilitySystemComponent>() : nullptr)
+                {
+                    Targets.AddUnique(Target);
+                }
+            }
+            PhysicsHits += Targets.Num();
+        }
+        const double PhysicsMicroseconds = (FPlatformTime::Seconds() - StartTime) * 1.0e6 / NumQueries;
+
+        // Both find the same targets, give or take bodies sitting exactly on a query's edge
+        TestTrue(FString::Printf(TEXT("%d targets: grid and physics find the same targets"), NumTargets), FMath::Abs(GridHits - PhysicsHits) <= FMath::Max<int64>(1, PhysicsHits / 100));
+
+        if (NumTargets == 5000)
+        {
+            FCOBenchmarkThresholds::Check(*this, TEXT("TargetGridQueryUs"), GridMicroseconds);
+        }
+
+        const double AverageHits = double(GridHits) / NumQueries;
+        Csv += FString::Printf(TEXT("%d,%.3f,%.3f,%.2f\n"), NumTargets, GridMicroseconds, PhysicsMicroseconds, AverageHits);
+        AddInfo(FString::Printf(TEXT("%d targets: grid %.2f us, physics %.2f us per query, %.1f hits"), NumTargets, GridMicroseconds, PhysicsMicroseconds, AverageHits));
+    }
+
+    const FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), TEXT("TargetGrid.csv"));
+    TestTrue(TEXT("Wrote the comparison CSV"), FFileHelper::SaveStringToFile(Csv, *OutputPath));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
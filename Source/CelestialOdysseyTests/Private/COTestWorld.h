@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilitySystemComponent.h"
+#include "COEnemyAttributeSet.h"
+#include "Components/SceneComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+/**
+ * @class FCOTestWorld
+ * @brief Game world that lives for the length of a test.
+ *
+ * The game's world subsystems only support game and PIE worlds, so tests create a game world of their own
+ * and tick its subsystems by hand.
+ */
+class FCOTestWorld
+{
+public:
+    FCOTestWorld()
+    {
+        World = UWorld::CreateWorld(EWorldType::Game, false);
+
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(World);
+
+        World->InitializeActorsForPlay(FURL());
+        World->BeginPlay();
+    }
+
+    ~FCOTestWorld()
+    {
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+    }
+
+    UWorld* Get() const { return World; }
+
+    template<typename T>
+    T* GetSubsystem() const { return World->GetSubsystem<T>(); }
+
+    /** Moves game time, which the expiry wheel reads instead of a tick delta */
+    void SetTimeSeconds(double Seconds) { World->TimeSeconds = Seconds; }
+
+    /** Runs a full world tick: actors, components, physics and tickable subsystems */
+    void Step(float DeltaSeconds)
+    {
+        ++GFrameCounter;
+        World->Tick(LEVELTICK_All, DeltaSeconds);
+    }
+
+    /**
+     * @brief Spawns a static block of world geometry built from the engine cube.
+     * @param Center Block center in world space.
+     * @param Size Block size in centimeters.
+     */
+    AStaticMeshActor* SpawnBlock(const FVector& Center, const FVector& Size) const
+    {
+        UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+
+        // Static components only accept a mesh before they are registered
+        const FTransform Transform(FQuat::Identity, Center, Size / 100.0f);
+        AStaticMeshActor* Block = World->SpawnActorDeferred<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Transform);
+        Block->GetStaticMeshComponent()->SetStaticMesh(Cube);
+        Block->FinishSpawning(Transform);
+        return Block;
+    }
+
+    /**
+     * @brief Spawns an actor with an Ability System Component and UCOEnemyAttributeSet.
+     * @param Location Where the actor is placed.
+     * @param OutActor Receives the spawned actor when not null.
+     * @return The actor's Ability System Component.
+     */
+    UAbilitySystemComponent* SpawnTarget(const FVector& Location, AActor** OutActor = nullptr) const
+    {
+        AActor* Actor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity);
+
+        USceneComponent* Root = NewObject<USceneComponent>(Actor, TEXT("Root"));
+        Actor->SetRootComponent(Root);
+        Root->RegisterComponent();
+        Actor->SetActorLocation(Location);
+
+        UAbilitySystemComponent* AbilitySystem = NewObject<UAbilitySystemComponent>(Actor, TEXT("AbilitySystem"));
+        AbilitySystem->RegisterComponent();
+        AbilitySystem->InitStats(UCOEnemyAttributeSet::StaticClass(), nullptr);
+        AbilitySystem->InitAbilityActorInfo(Actor, Actor);
+
+        if (OutActor)
+        {
+            *OutActor = Actor;
+        }
+        return AbilitySystem;
+    }
+
+private:
+    UWorld* World = nullptr;
+};